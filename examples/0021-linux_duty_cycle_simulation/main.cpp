@@ -0,0 +1,197 @@
+#include <Duty_Cycle.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+
+// Amount of samples retained over deep sleep and the amount that triggers a cycle
+constexpr size_t RETAINED_CAPACITY = 16U;
+constexpr size_t BATCH_SIZE = 4U;
+// Short timeout, because the simulated client connects immediately and only the outbox flush can take longer
+constexpr uint64_t CYCLE_TIMEOUT_MILLISECONDS = 50U;
+constexpr char THINGSBOARD_SERVER[] = "demo.thingsboard.io";
+constexpr char TOKEN[] = "YOUR_DEVICE_ACCESS_TOKEN";
+constexpr char TEMPERATURE_KEY[] = "temperature";
+constexpr char HUMIDITY_KEY[] = "humidity";
+constexpr char const * KEYS[] = { TEMPERATURE_KEY, HUMIDITY_KEY };
+
+
+// Simulates the retention region (RTC memory on the ESP32), survives the simulated deep sleep because the Duty_Cycle and ThingsBoard instances are destroyed and constructed again for every wake up
+Retained_Batch<RETAINED_CAPACITY> retained_memory;
+
+
+/// @brief MQTT client that sends asynchronously like the esp mqtt client, every publish is stored in an outbox and only delivered to the simulated server by a later call to loop.
+/// Disconnecting discards every message still contained in the outbox
+class Simulated_MQTT_Client : public IMQTT_Client {
+  public:
+    void set_data_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int>::function callback) override {
+        // Nothing to do
+    }
+
+    void set_connect_callback(Callback<void>::function callback) override {
+        m_connected_callback.Set_Callback(callback);
+    }
+
+    bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override {
+        m_receive_buffer_size = receive_buffer_size;
+        m_send_buffer_size = send_buffer_size;
+        return true;
+    }
+
+    uint16_t get_receive_buffer_size() override {
+        return m_receive_buffer_size;
+    }
+
+    uint16_t get_send_buffer_size() override {
+        return m_send_buffer_size;
+    }
+
+    void set_server(char const * domain, uint16_t port) override {
+        // Nothing to do
+    }
+
+    bool connect(char const * client_id, char const * user_name, char const * password) override {
+        m_connected = true;
+        m_connected_callback.Call_Callback();
+        return true;
+    }
+
+    void disconnect() override {
+        m_connected = false;
+        m_outbox.clear();
+    }
+
+    bool loop() override {
+        for (size_t flushed = 0U; flushed < m_flush_per_loop && !m_outbox.empty(); ++flushed) {
+            m_delivered.push_back(m_outbox.front());
+            m_outbox.erase(m_outbox.begin());
+        }
+        return m_connected;
+    }
+
+    bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
+        if (!m_connected || length > m_send_buffer_size) {
+            return false;
+        }
+        m_outbox.emplace_back(reinterpret_cast<char const *>(payload), length);
+        return true;
+    }
+
+    bool outbox_empty() const override {
+        return m_outbox.empty();
+    }
+
+    bool subscribe(char const * topic) override {
+        return m_connected;
+    }
+
+    bool unsubscribe(char const * topic) override {
+        return m_connected;
+    }
+
+    bool connected() override {
+        return m_connected;
+    }
+
+    MQTT_Connection_State get_connection_state() const override {
+        return m_connected ? MQTT_Connection_State::CONNECTED : MQTT_Connection_State::DISCONNECTED;
+    }
+
+    MQTT_Connection_Error get_last_connection_error() const override {
+        return MQTT_Connection_Error::NONE;
+    }
+
+    void subscribe_connection_state_changed_callback(Callback<void, MQTT_Connection_State, MQTT_Connection_Error>::function callback) override {
+        // Nothing to do
+    }
+
+    /// @brief Sets how many messages are moved out of the outbox per call to loop, 0 simulates a connection that never gets to send anything
+    void set_flush_per_loop(size_t const & flush_per_loop) {
+        m_flush_per_loop = flush_per_loop;
+    }
+
+    /// @brief Returns the amount of samples the simulated server received so far, summed up over every delivered json array
+    size_t get_delivered_samples() const {
+        size_t samples = 0U;
+        for (auto const & payload : m_delivered) {
+            JsonDocument document;
+            if (deserializeJson(document, payload) != DeserializationError::Ok) {
+                continue;
+            }
+            for (JsonObjectConst entry : document.as<JsonArrayConst>()) {
+                JsonObjectConst const values = entry[VALUES_KEY].is<JsonObjectConst>() ? entry[VALUES_KEY].as<JsonObjectConst>() : entry;
+                samples += values.size();
+            }
+        }
+        return samples;
+    }
+
+  private:
+    Callback<void>           m_connected_callback = {};    // Callback that is called once the simulated connection has been established
+    bool                     m_connected = {};             // Whether the simulated connection is established
+    uint16_t                 m_receive_buffer_size = 256U; // Receive buffer size, unused because nothing is ever received
+    uint16_t                 m_send_buffer_size = 256U;    // Maximum size of a single publish
+    size_t                   m_flush_per_loop = 1U;        // Amount of messages delivered per call to loop
+    std::vector<std::string> m_outbox = {};                // Published messages that have not been delivered yet
+    std::vector<std::string> m_delivered = {};             // Messages the simulated server received
+};
+
+
+size_t failures = 0U;
+
+void check(bool const & condition, char const * description) {
+    printf("[%s] %s\n", condition ? "PASS" : "FAIL", description);
+    if (!condition) {
+        failures++;
+    }
+}
+
+/// @brief Simulates a single wake up from deep sleep, which takes the given samples and runs the cycle if it is due
+/// @return Whether the cycle sent every retained sample, true if it was deferred
+bool wake_up(Simulated_MQTT_Client & client, size_t const & samples, uint64_t & timestamp) {
+    ThingsBoard tb(client);
+    Duty_Cycle<2U, RETAINED_CAPACITY> duty_cycle(tb, retained_memory, KEYS, BATCH_SIZE);
+    for (size_t sample = 0U; sample < samples; ++sample) {
+        timestamp += 60000U;
+        (void)duty_cycle.Push(0U, 21.5f + sample, timestamp);
+        (void)duty_cycle.Push(1U, static_cast<int>(40U + sample), timestamp);
+    }
+    // Leaving the scope destroys every instance except the retained memory, the same as entering deep sleep would
+    return duty_cycle.Run_Cycle(THINGSBOARD_SERVER, TOKEN, DEFAULT_MQTT_PORT, CYCLE_TIMEOUT_MILLISECONDS);
+}
+
+int main() {
+    Simulated_MQTT_Client client;
+    uint64_t timestamp = 1700000000000U;
+
+    check(wake_up(client, 1U, timestamp), "Cycle is deferred while the batch size has not been reached");
+    check(retained_memory.count == 2U, "Samples are kept in the retention region over deep sleep");
+    check(client.get_delivered_samples() == 0U, "Nothing is sent while the cycle is deferred");
+
+    client.set_flush_per_loop(0U);
+    check(!wake_up(client, 1U, timestamp), "Cycle fails if the outbox is not flushed before the timeout");
+    check(retained_memory.count == 4U, "Samples still in the outbox on disconnect are kept for the next cycle");
+
+    client.set_flush_per_loop(1U);
+    check(wake_up(client, 0U, timestamp), "Cycle succeeds once the outbox is flushed");
+    check(retained_memory.count == 0U, "Samples are removed once the outbox has been flushed");
+    check(client.get_delivered_samples() == 4U, "Every retained sample has been received exactly once");
+
+    {
+        ThingsBoard tb(client);
+        tb.Set_Resubscribe_On_Connect(false);
+        Duty_Cycle<2U, RETAINED_CAPACITY> duty_cycle(tb, retained_memory, KEYS, 1U);
+        (void)duty_cycle.Push(0U, 20.0f, timestamp);
+        (void)duty_cycle.Run_Cycle(THINGSBOARD_SERVER, TOKEN, DEFAULT_MQTT_PORT, CYCLE_TIMEOUT_MILLISECONDS);
+        check(!tb.Get_Resubscribe_On_Connect(), "Cycle restores the resubscribe setting of the user");
+    }
+
+    (void)wake_up(client, 1U, timestamp);
+    reinterpret_cast<uint8_t *>(retained_memory.samples)[0U] ^= 0xFFU;
+    check(wake_up(client, 0U, timestamp) && retained_memory.count == 0U, "Corrupted retention region is started empty");
+
+    printf("%zu failure(s)\n", failures);
+    return failures == 0U ? EXIT_SUCCESS : EXIT_FAILURE;
+}
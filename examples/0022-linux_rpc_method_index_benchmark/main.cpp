@@ -0,0 +1,123 @@
+#include <RPC_Method_Index.h>
+#include <Static_RPC_Method_Index.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+
+// Amount of times every received method name is resolved, high enough that the timer resolution does not matter
+constexpr size_t ITERATIONS = 200000U;
+// Subscribed method names, a typical firmware subscribes a few dozen at most
+constexpr char const * METHOD_NAMES[] = {
+    "getTemperature", "setTemperature", "getHumidity", "setHumidity", "getPressure", "setPressure", "getBattery", "setLedState",
+    "getLedState", "setLedColor", "getLedColor", "setFanSpeed", "getFanSpeed", "setValveOpen", "getValveOpen", "reboot",
+    "factoryReset", "setInterval", "getInterval", "setThreshold", "getThreshold", "setMode", "getMode", "calibrate",
+    "startMeasurement", "stopMeasurement", "getFirmwareInfo", "setTimezone", "getTimezone", "setName", "getName", "ping"
+};
+constexpr size_t METHOD_COUNT = sizeof(METHOD_NAMES) / sizeof(METHOD_NAMES[0U]);
+// Received method names that have not been subscribed, which is the worst case of the linear walk
+constexpr char const * UNKNOWN_NAMES[] = { "getTemperatures", "setTemp", "pong", "unknownMethod" };
+constexpr size_t UNKNOWN_COUNT = sizeof(UNKNOWN_NAMES) / sizeof(UNKNOWN_NAMES[0U]);
+
+// Generated at compile time, see Static_RPC_Method_Index
+constexpr Static_RPC_Method_Index<METHOD_COUNT> STATIC_INDEX(METHOD_NAMES);
+
+
+/// @brief Stands in for the subscribed RPC_Callback, the indices only ever access the method name
+class Named_Callback {
+  public:
+    explicit Named_Callback(char const * name)
+      : m_name(name)
+    {
+        // Nothing to do
+    }
+
+    char const * Get_Name() const {
+        return m_name;
+    }
+
+  private:
+    char const *m_name = {}; // Subscribed method name
+};
+
+
+/// @brief Linear walk over every subscribed callback, the way server-side RPC methods were resolved before the method indices existed
+size_t Linear_Find(std::vector<Named_Callback> const & callbacks, char const * method_name) {
+    for (size_t position = 0U; position < callbacks.size(); ++position) {
+        if (strcmp(callbacks[position].Get_Name(), method_name) == 0) {
+            return position;
+        }
+    }
+    return RPC_METHOD_NOT_FOUND;
+}
+
+/// @brief Resolves every subscribed and every unknown method name ITERATIONS times with the given lookup
+/// @return Average nanoseconds per lookup
+template <typename Lookup>
+double Measure(char const * description, Lookup lookup, size_t & checksum) {
+    auto const start = std::chrono::steady_clock::now();
+    for (size_t iteration = 0U; iteration < ITERATIONS; ++iteration) {
+        for (auto const & method_name : METHOD_NAMES) {
+            checksum += lookup(method_name);
+        }
+        for (auto const & method_name : UNKNOWN_NAMES) {
+            checksum += lookup(method_name);
+        }
+    }
+    auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    double const per_lookup = static_cast<double>(elapsed) / (ITERATIONS * (METHOD_COUNT + UNKNOWN_COUNT));
+    printf("%-24s %8.2f ns per lookup\n", description, per_lookup);
+    return per_lookup;
+}
+
+int main() {
+    std::vector<Named_Callback> callbacks;
+    RPC_Method_Index method_index;
+    Static_RPC_Method_Index<METHOD_COUNT> static_index = STATIC_INDEX;
+
+    // Subscribes one method name at a time, the same as repeated calls to Server_Side_RPC::RPC_Subscribe
+    auto const subscribe_start = std::chrono::steady_clock::now();
+    for (auto const & method_name : METHOD_NAMES) {
+        callbacks.emplace_back(method_name);
+        method_index.Append(&callbacks.back(), &callbacks.back() + 1U, callbacks.size() - 1U);
+        static_index.Append(&callbacks.back(), &callbacks.back() + 1U, callbacks.size() - 1U);
+    }
+    auto const subscribe_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - subscribe_start).count();
+    printf("Subscribed %zu method names one by one in %lld ns\n", METHOD_COUNT, static_cast<long long>(subscribe_elapsed));
+
+    // Every lookup has to resolve to the same position, otherwise the measured times are meaningless
+    size_t mismatches = 0U;
+    for (auto const & method_name : METHOD_NAMES) {
+        size_t const expected = Linear_Find(callbacks, method_name);
+        mismatches += method_index.Find(callbacks, method_name) != expected;
+        mismatches += static_index.Find(callbacks, method_name) != expected;
+        // Raw requests resolve the method name directly inside of the payload, where it is followed by the rest of the message instead of a null termination
+        char payload[64U] = {};
+        (void)snprintf(payload, sizeof(payload), "%s\",\"params\":{}}", method_name);
+        mismatches += method_index.Find(callbacks, payload, strlen(method_name)) != expected;
+    }
+    for (auto const & method_name : UNKNOWN_NAMES) {
+        mismatches += method_index.Find(callbacks, method_name) != RPC_METHOD_NOT_FOUND;
+        mismatches += static_index.Find(callbacks, method_name) != RPC_METHOD_NOT_FOUND;
+        // Subscribed names that are a prefix of the received one, like "getTemperature" for "getTemperatures", must not match either
+        char payload[64U] = {};
+        (void)snprintf(payload, sizeof(payload), "%s\",\"params\":{}}", method_name);
+        mismatches += method_index.Find(callbacks, payload, strlen(method_name)) != RPC_METHOD_NOT_FOUND;
+    }
+    if (mismatches != 0U) {
+        printf("%zu lookup(s) resolved to a different callback than the linear walk\n", mismatches);
+        return EXIT_FAILURE;
+    }
+
+    size_t checksum = 0U;
+    printf("Resolving %zu subscribed and %zu unknown method names\n", METHOD_COUNT, UNKNOWN_COUNT);
+    (void)Measure("Linear strcmp", [&callbacks](char const * method_name) { return Linear_Find(callbacks, method_name); }, checksum);
+    (void)Measure("RPC_Method_Index", [&callbacks, &method_index](char const * method_name) { return method_index.Find(callbacks, method_name); }, checksum);
+    (void)Measure("Static_RPC_Method_Index", [&callbacks, &static_index](char const * method_name) { return static_index.Find(callbacks, method_name); }, checksum);
+    // Printed so that the compiler can not remove the lookups
+    printf("Checksum %zu\n", checksum);
+    return EXIT_SUCCESS;
+}
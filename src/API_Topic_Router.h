@@ -0,0 +1,188 @@
+#ifndef API_Topic_Router_h
+#define API_Topic_Router_h
+
+// Local includes.
+#include "IAPI_Implementation.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Sorted prefix table, which resolves the received response topic to the API implementations that handle responses on that topic.
+/// Replaces the previous linear walk over every API implementation, where each API implementation had to calculate the length of its own topic and compare it to the received one, which was done once to find the RAW and once more to find the JSON consumers.
+/// @note The table is built once from the response topic prefix of every API implementation (see @ref IAPI_Implementation::Get_Response_Topic_Prefix) and then kept sorted lexicographically, seperately for every @ref API_Process_Type.
+/// This allows to find the last prefix that is smaller or equal to the received topic with a binary search. Every prefix of the received topic has to be a prefix of that entry as well,
+/// because every entry sorted between a prefix and the received topic has to start with that prefix. Therefore every entry additionally stores the closest previous entry that is a prefix of itself,
+/// which allows to only follow that chain of nested prefixes from the found entry, instead of walking backwards over every unrelated entry in between.
+/// Every entry that is actually a prefix of the received topic is then additionally confirmed with @ref IAPI_Implementation::Is_Response_Topic_Matching,
+/// because some API implementations require the topic to match exactly (shared attribute update) or contain additional information only known at runtime (OTA firmware update).
+/// API implementations that do not return any prefix are kept in a seperate unrouted list and are always checked with @ref IAPI_Implementation::Is_Response_Topic_Matching, which keeps custom API implementations working unchanged
+class API_Topic_Router {
+  public:
+    /// @brief Constructor
+    API_Topic_Router() = default;
+
+    /// @brief Clears the previous table and rebuilds it from the given API implementations
+    /// @note Has to be called whenever an API implementation is added, because the table only holds non owning pointers to the API implementations and their response topic prefix
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    template <typename InputIterator>
+    void Rebuild(InputIterator const & first, InputIterator const & last) {
+        m_raw_routes.clear();
+        m_json_routes.clear();
+        m_unrouted_implementations.clear();
+
+        for (auto it = first; it != last; ++it) {
+            IAPI_Implementation * api = *it;
+            if (api == nullptr) {
+                continue;
+            }
+            char const * prefix = api->Get_Response_Topic_Prefix();
+            if (prefix == nullptr) {
+                m_unrouted_implementations.push_back(api);
+                continue;
+            }
+            Topic_Route route = {};
+            route.prefix = prefix;
+            route.length = strlen(prefix);
+            route.api = api;
+            Insert_Sorted(api->Get_Process_Type() == API_Process_Type::RAW ? m_raw_routes : m_json_routes, route);
+        }
+        Link_Parents(m_raw_routes);
+        Link_Parents(m_json_routes);
+    }
+
+    /// @brief Calls the given function for every API implementation with the given process type, that handles responses on the given topic
+    /// @tparam Function Callable that receives a mutable reference to the matching API implementation and returns whether the walk should continue or be stopped
+    /// @param type Process type the API implementations need to have to be considered
+    /// @param topic Non owning pointer to the topic the response was received over.
+    /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the given topic, the topic is not guaranteed to be null terminated and is therefore never read past this length
+    /// @param function Function that will be called with every matching API implementation
+    /// @return Amount of matching API implementations the given function has been called for
+    template <typename Function>
+    size_t For_Each_Match(API_Process_Type const & type, char const * topic, size_t const & topic_length, Function function) const {
+        Route_Container const & routes = (type == API_Process_Type::RAW) ? m_raw_routes : m_json_routes;
+        size_t matches = 0U;
+
+        // Binary search for the first entry that is bigger than the received topic, all entries before that one are smaller or equal
+        // and therefore possible prefixes of the received topic
+        size_t low = 0U;
+        size_t high = routes.size();
+        while (low < high) {
+            size_t const middle = low + ((high - low) / 2U);
+            if (Compare(routes[middle].prefix, routes[middle].length, topic, topic_length) <= 0) {
+                low = middle + 1U;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        // Only the found entry and the chain of prefixes it contains can be prefixes of the received topic, ordered from the longest to the shortest one
+        for (size_t index = (low > 0U) ? (low - 1U) : NO_PARENT; index != NO_PARENT; index = routes[index].parent) {
+            auto const & route = routes[index];
+            if (Common_Prefix_Length(route.prefix, route.length, topic, topic_length) == route.length && route.api->Is_Response_Topic_Matching(topic, topic_length)) {
+                ++matches;
+                if (!function(*route.api)) {
+                    return matches;
+                }
+            }
+        }
+
+        for (auto & api : m_unrouted_implementations) {
+            if (api->Get_Process_Type() != type || !api->Is_Response_Topic_Matching(topic, topic_length)) {
+                continue;
+            }
+            ++matches;
+            if (!function(*api)) {
+                break;
+            }
+        }
+        return matches;
+    }
+
+  private:
+    static size_t constexpr NO_PARENT = static_cast<size_t>(-1); // Parent index of entries that do not start with any other prefix in the table
+
+    /// @brief Single entry of the routing table
+    struct Topic_Route {
+        char const *          prefix = {};        // Response topic prefix returned by the API implementation, is expected to point to a string literal or a member that is kept alive for the lifetime of the API implementation
+        size_t                length = {};        // Length of the response topic prefix without null termination, calculated once when the table is built
+        IAPI_Implementation * api = {};           // Non owning pointer to the API implementation handling responses on topics starting with the prefix
+        size_t                parent = NO_PARENT; // Index of the closest previous entry whose prefix is a prefix of this entry as well, calculated once when the table is built
+    };
+
+    using Route_Container = Container<Topic_Route>;
+    using IAPI_Container = Container<IAPI_Implementation *>;
+
+    /// @brief Lexicographically compares the given prefix with the given topic, where a shorter string that is equal to the start of the longer one is considered smaller
+    /// @param prefix Non owning pointer to the first string
+    /// @param prefix_length Length of the first string
+    /// @param topic Non owning pointer to the second string, does not need to be null terminated
+    /// @param topic_length Length of the second string
+    /// @return Negative value if the prefix is smaller, 0 if both are equal and positive value if the prefix is bigger than the topic
+    static int Compare(char const * prefix, size_t const & prefix_length, char const * topic, size_t const & topic_length) {
+        int const result = memcmp(prefix, topic, prefix_length < topic_length ? prefix_length : topic_length);
+        if (result != 0) {
+            return result;
+        }
+        return (prefix_length < topic_length) ? -1 : (prefix_length > topic_length ? 1 : 0);
+    }
+
+    /// @brief Calculates the amount of characters at the start of both strings that are equal
+    /// @param prefix Non owning pointer to the first string
+    /// @param prefix_length Length of the first string
+    /// @param topic Non owning pointer to the second string, does not need to be null terminated
+    /// @param maximum_length Upper bound for the result, allows to skip comparing characters that are already known to be different
+    /// @return Amount of equal characters at the start of both strings
+    static size_t Common_Prefix_Length(char const * prefix, size_t const & prefix_length, char const * topic, size_t const & maximum_length) {
+        size_t const length = prefix_length < maximum_length ? prefix_length : maximum_length;
+        size_t index = 0U;
+        while (index < length && prefix[index] == topic[index]) {
+            ++index;
+        }
+        return index;
+    }
+
+    /// @brief Inserts the given route into the given container, while keeping the container sorted by prefix
+    /// @note Simple insertion sort step, because the table is only rebuilt when API implementations are subscribed and only ever contains a handful of entries
+    /// @param routes Container the route should be inserted into
+    /// @param route Route that should be inserted
+    static void Insert_Sorted(Route_Container & routes, Topic_Route const & route) {
+        routes.push_back(route);
+        for (size_t index = routes.size() - 1U; index > 0U; --index) {
+            auto & current = routes[index];
+            auto & previous = routes[index - 1U];
+            if (Compare(previous.prefix, previous.length, current.prefix, current.length) <= 0) {
+                break;
+            }
+            Topic_Route const temporary = previous;
+            previous = current;
+            current = temporary;
+        }
+    }
+
+    /// @brief Calculates the parent of every entry in the given sorted container, which is the closest previous entry whose prefix is a prefix of the entry itself
+    /// @note Uses the same reasoning as the lookup, every prefix of an entry is a prefix of the entry directly before it as well, therefore only the chain of the previous entry has to be followed
+    /// @param routes Sorted container the parents should be calculated for
+    static void Link_Parents(Route_Container & routes) {
+        for (size_t index = 0U; index < routes.size(); ++index) {
+            auto & route = routes[index];
+            size_t parent = (index > 0U) ? (index - 1U) : NO_PARENT;
+            while (parent != NO_PARENT && Common_Prefix_Length(routes[parent].prefix, routes[parent].length, route.prefix, route.length) != routes[parent].length) {
+                parent = routes[parent].parent;
+            }
+            route.parent = parent;
+        }
+    }
+
+    Route_Container m_raw_routes = {};               // Sorted routes of all API implementations that process the raw response
+    Route_Container m_json_routes = {};              // Sorted routes of all API implementations that process the deserialized json response
+    IAPI_Container  m_unrouted_implementations = {}; // API implementations that do not provide a response topic prefix and therefore have to be checked for every received response
+};
+
+#endif // API_Topic_Router_h
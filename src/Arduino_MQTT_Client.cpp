@@ -3,19 +3,42 @@
 
 #ifdef ARDUINO
 
+#if !THINGSBOARD_ENABLE_STL
+Arduino_MQTT_Client *Arduino_MQTT_Client::m_subscribedInstance = nullptr;
+#endif // !THINGSBOARD_ENABLE_STL
+
+// Fixed header of any MQTT packet (atmost 5 bytes) and the remaining fixed size fields of the CONNECT, SUBSCRIBE, UNSUBSCRIBE or PUBLISH packet,
+// the variable size strings contained in the packet are added on top of this with their 2 byte length prefix
+constexpr uint16_t CONTROL_PACKET_OVERHEAD = 16U;
+// Initial size of the send buffer of the underlying PubSubClient, is enough for the header of a publish on any ThingsBoard topic
+// and is only increased if a bigger CONNECT, SUBSCRIBE or UNSUBSCRIBE packet has to be sent
+constexpr uint16_t CONTROL_BUFFER_SIZE = 128U;
+
 Arduino_MQTT_Client::Arduino_MQTT_Client(Client & transport_client) :
     m_connected_callback(),
+    m_received_data_callback(),
     m_mqtt_client(transport_client)
 {
     // Nothing to do
 }
 
+Arduino_MQTT_Client::~Arduino_MQTT_Client() {
+    delete[] m_publish_buffer;
+    m_publish_buffer = nullptr;
+}
+
 void Arduino_MQTT_Client::set_client(Client & transport_client) {
     m_mqtt_client.setClient(transport_client);
 }
 
-void Arduino_MQTT_Client::set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) {
-    m_mqtt_client.setCallback(callback);
+void Arduino_MQTT_Client::set_data_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int>::function callback) {
+    m_received_data_callback.Set_Callback(callback);
+#if THINGSBOARD_ENABLE_STL
+    m_mqtt_client.setCallback(std::bind(&Arduino_MQTT_Client::mqtt_message_handler, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+#else
+    m_subscribedInstance = this;
+    m_mqtt_client.setCallback(Arduino_MQTT_Client::static_mqtt_message_handler);
+#endif // THINGSBOARD_ENABLE_STL
 }
 
 void Arduino_MQTT_Client::set_connect_callback(Callback<void>::function callback) {
@@ -23,7 +46,29 @@ void Arduino_MQTT_Client::set_connect_callback(Callback<void>::function callback
 }
 
 bool Arduino_MQTT_Client::set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
-    return m_mqtt_client.setBufferSize(receive_buffer_size, send_buffer_size);
+    // The publish buffer might be freed below, which is not allowed while a message is still being written into it.
+    // The buffer is therefore acquired for the duration of the resize, which additionally prevents it from being acquired in the meantime
+#if THINGSBOARD_ENABLE_STL
+    if (m_publish_buffer_acquired.exchange(true)) {
+        return false;
+    }
+#else
+    if (m_publish_buffer_acquired) {
+        return false;
+    }
+    m_publish_buffer_acquired = true;
+#endif // THINGSBOARD_ENABLE_STL
+
+    // Payloads are never copied into the send buffer of the PubSubClient, because they are streamed with beginPublish() and write() instead,
+    // therefore it only has to be big enough for the control packets and the publish buffer is the only buffer that has to be able to hold the complete payload
+    bool const result = m_mqtt_client.setBufferSize(receive_buffer_size, send_buffer_size < CONTROL_BUFFER_SIZE ? send_buffer_size : CONTROL_BUFFER_SIZE);
+    if (result && m_send_buffer_size != send_buffer_size) {
+        delete[] m_publish_buffer;
+        m_publish_buffer = nullptr;
+        m_send_buffer_size = send_buffer_size;
+    }
+    release_publish_buffer();
+    return result;
 }
 
 uint16_t Arduino_MQTT_Client::get_receive_buffer_size() {
@@ -31,7 +76,7 @@ uint16_t Arduino_MQTT_Client::get_receive_buffer_size() {
 }
 
 uint16_t Arduino_MQTT_Client::get_send_buffer_size() {
-    return m_mqtt_client.getSendBufferSize();
+    return m_send_buffer_size != 0U ? m_send_buffer_size : m_mqtt_client.getSendBufferSize();
 }
 
 void Arduino_MQTT_Client::set_server(char const * domain, uint16_t port) {
@@ -39,6 +84,11 @@ void Arduino_MQTT_Client::set_server(char const * domain, uint16_t port) {
 }
 
 bool Arduino_MQTT_Client::connect(char const * client_id, char const * user_name, char const * password) {
+    size_t required_size = CONTROL_PACKET_OVERHEAD;
+    required_size += (client_id != nullptr) ? 2U + strlen(client_id) : 0U;
+    required_size += (user_name != nullptr) ? 2U + strlen(user_name) : 0U;
+    required_size += (password != nullptr) ? 2U + strlen(password) : 0U;
+    (void)reserve_control_buffer(required_size);
     update_connection_state(MQTT_Connection_State::CONNECTING);
     MQTT_Connection_Error const connection_error = connect_mqtt_client(client_id, user_name, password);
     bool const result = connection_error == MQTT_Connection_Error::NONE;
@@ -63,15 +113,53 @@ bool Arduino_MQTT_Client::loop() {
 }
 
 bool Arduino_MQTT_Client::publish(char const * topic, uint8_t const * payload, size_t const & length) {
-    return m_mqtt_client.publish(topic, payload, length, false);
+    if (length > get_send_buffer_size()) {
+        return false;
+    }
+    return stream_publish(topic, payload, length);
+}
+
+uint8_t * Arduino_MQTT_Client::acquire_publish_buffer(size_t & available) {
+    available = 0U;
+#if THINGSBOARD_ENABLE_STL
+    if (m_publish_buffer_acquired.exchange(true)) {
+        return nullptr;
+    }
+#else
+    if (m_publish_buffer_acquired) {
+        return nullptr;
+    }
+    m_publish_buffer_acquired = true;
+#endif // THINGSBOARD_ENABLE_STL
+
+    if (m_publish_buffer == nullptr && m_send_buffer_size != 0U) {
+        m_publish_buffer = new uint8_t[m_send_buffer_size];
+    }
+
+    if (m_publish_buffer == nullptr) {
+        release_publish_buffer();
+        return nullptr;
+    }
+    available = m_send_buffer_size;
+    return m_publish_buffer;
+}
+
+bool Arduino_MQTT_Client::commit_publish_buffer(char const * topic, size_t const & length) {
+    bool const result = m_publish_buffer_acquired && length <= m_send_buffer_size && stream_publish(topic, m_publish_buffer, length);
+    release_publish_buffer();
+    return result;
+}
+
+void Arduino_MQTT_Client::release_publish_buffer() {
+    m_publish_buffer_acquired = false;
 }
 
 bool Arduino_MQTT_Client::subscribe(char const * topic) {
-    return m_mqtt_client.subscribe(topic);
+    return reserve_control_buffer(CONTROL_PACKET_OVERHEAD + 2U + strlen(topic)) && m_mqtt_client.subscribe(topic);
 }
 
 bool Arduino_MQTT_Client::unsubscribe(char const * topic) {
-    return m_mqtt_client.unsubscribe(topic);
+    return reserve_control_buffer(CONTROL_PACKET_OVERHEAD + 2U + strlen(topic)) && m_mqtt_client.unsubscribe(topic);
 }
 
 bool Arduino_MQTT_Client::connected() {
@@ -93,7 +181,7 @@ void Arduino_MQTT_Client::subscribe_connection_state_changed_callback(Callback<v
 #if THINGSBOARD_ENABLE_STREAM_UTILS
 
 bool Arduino_MQTT_Client::begin_publish(char const * topic, size_t const & length) {
-    return m_mqtt_client.beginPublish(topic, length, false);
+    return reserve_control_buffer(CONTROL_PACKET_OVERHEAD + 2U + strlen(topic)) && m_mqtt_client.beginPublish(topic, length, false);
 }
 
 bool Arduino_MQTT_Client::end_publish() {
@@ -110,6 +198,35 @@ size_t Arduino_MQTT_Client::write(uint8_t const * buffer, size_t const & size) {
 
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
+void Arduino_MQTT_Client::mqtt_message_handler(char * topic, uint8_t * payload, unsigned int length) {
+    m_received_data_callback.Call_Callback(topic, strlen(topic), payload, length);
+}
+
+#if !THINGSBOARD_ENABLE_STL
+void Arduino_MQTT_Client::static_mqtt_message_handler(char * topic, uint8_t * payload, unsigned int length) {
+    if (m_subscribedInstance == nullptr) {
+        return;
+    }
+    m_subscribedInstance->mqtt_message_handler(topic, payload, length);
+}
+#endif // !THINGSBOARD_ENABLE_STL
+
+bool Arduino_MQTT_Client::stream_publish(char const * topic, uint8_t const * payload, size_t const & length) {
+    bool result = reserve_control_buffer(CONTROL_PACKET_OVERHEAD + 2U + strlen(topic));
+    result = result && m_mqtt_client.beginPublish(topic, length, false);
+    result = result && (m_mqtt_client.write(payload, length) == length);
+    result = result && m_mqtt_client.endPublish();
+    return result;
+}
+
+bool Arduino_MQTT_Client::reserve_control_buffer(size_t const & required_size) {
+    uint16_t const current_size = m_mqtt_client.getSendBufferSize();
+    if (required_size <= current_size) {
+        return true;
+    }
+    return required_size <= UINT16_MAX && m_mqtt_client.setBufferSize(m_mqtt_client.getReceiveBufferSize(), static_cast<uint16_t>(required_size));
+}
+
 MQTT_Connection_Error Arduino_MQTT_Client::connect_mqtt_client(char const * client_id, char const * user_name, char const * password) {
     m_mqtt_client.connect(client_id, user_name, password);
     int const current_state = m_mqtt_client.state();
@@ -8,6 +8,9 @@
 
 // Library include
 #include <PubSubClient.h>
+#if THINGSBOARD_ENABLE_STL
+#include <atomic>
+#endif // THINGSBOARD_ENABLE_STL
 
 
 /// @brief MQTT Client interface implementation that uses the PubSubClient forked by ThingsBoard (https://github.com/thingsboard/pubsubclient),
@@ -28,17 +31,31 @@ class Arduino_MQTT_Client : public IMQTT_Client {
     /// but the actual type of connection does not matter (Ethernet or WiFi)
     Arduino_MQTT_Client(Client & transport_client);
 
-    ~Arduino_MQTT_Client() override = default;
+    ~Arduino_MQTT_Client() override;
+
+    /// @brief Deleted copy constructor
+    /// @note Copying would cause both instances to share the same internally allocated publish buffer. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Arduino_MQTT_Client(Arduino_MQTT_Client const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying would cause both instances to share the same internally allocated publish buffer. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Arduino_MQTT_Client const & other) = delete;
 
     /// @brief Sets the client has to be used if the empty constructor was used initally
     /// @param transport_client Client that is used to send the actual payload via. MQTT, needs to implement the client interface,
     /// but the actual type of connection does not matter (Ethernet or WiFi)
     void set_client(Client & transport_client);
 
-    void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override;
+    void set_data_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int>::function callback) override;
 
     void set_connect_callback(Callback<void>::function callback) override;
 
+    /// @copydoc IMQTT_Client::set_buffer_size
+    /// @note The send buffer of the underlying PubSubClient is only sized to hold the control packets, because every payload is streamed past it with beginPublish() and write().
+    /// The given send buffer size is instead used for the publish buffer returned by @ref acquire_publish_buffer, which is therefore the only buffer that ever has to hold a complete payload.
+    /// Fails without changing any buffer, while the publish buffer is acquired, because resizing would free the buffer that is still being written into
     bool set_buffer_size(uint16_t receive_buffer_size, uint16_t send_buffer_size) override;
 
     uint16_t get_receive_buffer_size() override;
@@ -53,8 +70,19 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     bool loop() override;
 
+    /// @copydoc IMQTT_Client::publish
+    /// @note The payload is streamed directly from the given pointer with beginPublish() and write(), instead of being copied into the send buffer of the underlying PubSubClient first
     bool publish(char const * topic, uint8_t const * payload, size_t const & length) override;
 
+    /// @copydoc IMQTT_Client::acquire_publish_buffer
+    /// @note The returned buffer is allocated once with the send buffer size passed to @ref set_buffer_size and takes the place of the send buffer of the underlying PubSubClient,
+    /// which only holds the control packets instead. The written payload is then streamed to the network with beginPublish() and write()
+    uint8_t * acquire_publish_buffer(size_t & available) override;
+
+    bool commit_publish_buffer(char const * topic, size_t const & length) override;
+
+    void release_publish_buffer() override;
+
     bool subscribe(char const * topic) override;
 
     bool unsubscribe(char const * topic) override;
@@ -84,17 +112,51 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
   private:
+    /// @brief Internal callback registered on the underlying PubSubClient, which passes the received message on to the callback set with @ref set_data_callback
+    /// @note PubSubClient always null terminates the topic inside of its receive buffer, therefore the topic length only has to be measured once here,
+    /// instead of by every API implementation the message is passed to
+    /// @param topic Null terminated topic the message was received over
+    /// @param payload Received payload
+    /// @param length Length of the received payload
+    void mqtt_message_handler(char * topic, uint8_t * payload, unsigned int length);
+
+#if !THINGSBOARD_ENABLE_STL
+    static void static_mqtt_message_handler(char * topic, uint8_t * payload, unsigned int length);
+
+    static Arduino_MQTT_Client *m_subscribedInstance;
+#endif // !THINGSBOARD_ENABLE_STL
+
+    /// @brief Streams the given payload with beginPublish() and write(), which sends it without copying it into the send buffer of the underlying PubSubClient
+    /// @param topic Non owning pointer to topic that the message is sent over
+    /// @param payload Payload containg the data that should be sent
+    /// @param length Length of the payload in bytes
+    /// @return Whether publishing the payload on the given topic was successful or not
+    bool stream_publish(char const * topic, uint8_t const * payload, size_t const & length);
+
+    /// @brief Increases the send buffer of the underlying PubSubClient if it is too small to hold a control packet of the given size
+    /// @param required_size Amount of bytes the control packet that should be sent next requires
+    /// @return Whether the send buffer of the underlying PubSubClient is big enough to hold the control packet
+    bool reserve_control_buffer(size_t const & required_size);
+
     MQTT_Connection_Error connect_mqtt_client(char const * client_id, char const * user_name, char const * password);
 
     /// @brief Updates the interal connection state and informs the subscribed subject, about changes to the internal state
     /// @param new_state New state the connection to the MQTT broker is in now and the subject should be informed about
     void update_connection_state(MQTT_Connection_State new_state);
 
-    MQTT_Connection_State                                        m_connection_state = {};                  // Current connection state to the MQTT broker
-    MQTT_Connection_Error                                        m_last_connection_error = {};             // Last error that occured while trying to establish a connection to the MQTT broker
-    Callback<void, MQTT_Connection_State, MQTT_Connection_Error> m_connection_state_changed_callback = {}; // Callback that will be called as soon as the mqtt client connection changes
-    Callback<void>                                               m_connected_callback = {};                // Callback that will be called as soon as the mqtt client has connected
-    PubSubClient                                                 m_mqtt_client = {};                       // Underlying MQTT client instance used to send data
+    MQTT_Connection_State                                         m_connection_state = {};                  // Current connection state to the MQTT broker
+    MQTT_Connection_Error                                         m_last_connection_error = {};             // Last error that occured while trying to establish a connection to the MQTT broker
+    Callback<void, MQTT_Connection_State, MQTT_Connection_Error>  m_connection_state_changed_callback = {}; // Callback that will be called as soon as the mqtt client connection changes
+    Callback<void>                                                m_connected_callback = {};                // Callback that will be called as soon as the mqtt client has connected
+    Callback<void, char const *, size_t, uint8_t *, unsigned int> m_received_data_callback = {};            // Callback that will be called as soon as the mqtt client receives any data
+    PubSubClient                                                  m_mqtt_client = {};                       // Underlying MQTT client instance used to send data
+    uint8_t *                                                     m_publish_buffer = {};                    // Buffer that can be acquired to write the payload of the next message directly into, allocated on first use
+    uint16_t                                                      m_send_buffer_size = {};                  // Size of the publish buffer, the send buffer of the underlying PubSubClient is only sized to hold the control packets
+#if THINGSBOARD_ENABLE_STL
+    std::atomic<bool>                                             m_publish_buffer_acquired = {};           // Whether the publish buffer is currently in use and can therefore not be acquired again
+#else
+    bool                                                          m_publish_buffer_acquired = {};           // Whether the publish buffer is currently in use and can therefore not be acquired again
+#endif // THINGSBOARD_ENABLE_STL
 };
 
 #endif // ARDUINO
@@ -5,6 +5,7 @@
 #include "Attribute_Request_Callback.h"
 #include "IAPI_Implementation.h"
 #include "Timeoutable_Request.h"
+#include "Request_Table.h"
 
 
 // Attribute request API topics.
@@ -44,10 +45,10 @@ template<size_t MaxSubscriptions = DEFAULT_SUBSCRIPTION_AMOUNT, size_t MaxAttrib
 class Attribute_Request : public IAPI_Implementation {
 #if THINGSBOARD_ENABLE_DYNAMIC
     using Callback_Value = Attribute_Request_Callback;
-    using Callback_Container = Container<Callback_Value>;
+    using Callback_Container = Request_Table<Callback_Value>;
 #else
     using Callback_Value = Attribute_Request_Callback<MaxAttributes>;
-    using Callback_Container = Container<Callback_Value, MaxSubscriptions>;
+    using Callback_Container = Request_Table<Callback_Value, MaxSubscriptions>;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
   public:
@@ -86,51 +87,34 @@ class Attribute_Request : public IAPI_Implementation {
         return API_Process_Type::JSON;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+    void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
         // Nothing to do
     }
 
-    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
-        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(ATTRIBUTE_RESPONSE_TOPIC));
+    void Process_Json_Response(char const * topic, size_t const & topic_length, JsonDocument const & data) override {
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(ATTRIBUTE_RESPONSE_TOPIC));
         JsonObject object = data.as<JsonObject>();
 
-        Timeoutable_Request * request_callback = nullptr;
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_attribute_request_callbacks.begin(), m_attribute_request_callbacks.end(), [&request_id](Callback_Value & attribute_request) {
-            return attribute_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_attribute_request_callbacks.end()) {
-            auto & attribute_request = *it;
-#else
-        for (auto it = m_attribute_request_callbacks.begin(); it != m_attribute_request_callbacks.end(); ++it) {
-            auto & attribute_request = *it;
-
-            if (attribute_request.Get_Request_ID() != request_id) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            char const * attribute_response_key = attribute_request.Get_Attribute_Key();
+        Callback_Value * attribute_request = m_attribute_request_callbacks.Find(request_id);
+        if (attribute_request != nullptr) {
+            char const * attribute_response_key = attribute_request->Get_Attribute_Key();
             if (attribute_response_key == nullptr) {
 #if THINGSBOARD_ENABLE_DEBUG
                 Logger::printfln(ATT_KEY_NOT_FOUND);
 #endif // THINGSBOARD_ENABLE_DEBUG
-                goto delete_callback;
             }
-
-            if (object.containsKey(attribute_response_key)) {
-                object = object[attribute_response_key];
+            else {
+                if (object.containsKey(attribute_response_key)) {
+                    object = object[attribute_response_key];
+                }
+
+                auto & request_callback = attribute_request->Get_Request_Timeout();
+                request_callback.Stop_Timeout_Timer();
+                attribute_request->Call_Callback(object);
             }
 
-            request_callback = &attribute_request.Get_Request_Timeout();
-            request_callback->Stop_Timeout_Timer();
-            attribute_request.Call_Callback(object);
-
-            delete_callback:
             // Delete callback because the changes have been requested and the callback is no longer needed
-            m_attribute_request_callbacks.erase(it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
+            m_attribute_request_callbacks.Remove(request_id);
         }
 
         // Unsubscribe from the shared attribute request topic,
@@ -141,8 +125,37 @@ class Attribute_Request : public IAPI_Implementation {
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(ATTRIBUTE_RESPONSE_TOPIC, topic, strlen(ATTRIBUTE_RESPONSE_TOPIC)) == 0;
+    JsonDocument const * Get_Deserialization_Filter(char const * topic, size_t const & topic_length) override {
+        // Every request receives exactly one response, therefore building the filter for the received response builds it once per request.
+        // Responses to unknown requests are never read, which is achieved by keeping the filter empty
+        m_deserialization_filter.clear();
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(ATTRIBUTE_RESPONSE_TOPIC));
+        Callback_Value const * attribute_request = m_attribute_request_callbacks.Find(request_id);
+        if (attribute_request == nullptr) {
+            return &m_deserialization_filter;
+        }
+        char const * attribute_response_key = attribute_request->Get_Attribute_Key();
+        if (attribute_response_key == nullptr) {
+            return &m_deserialization_filter;
+        }
+
+        // Requested keys are expected to be nested inside of the client or shared key, but are added to the root as well, because the nested object is only read if it exists
+        for (auto const & att : attribute_request->Get_Attributes()) {
+            if (Helper::String_IsNull_Or_Empty(att)) {
+                continue;
+            }
+            m_deserialization_filter[att] = true;
+            m_deserialization_filter[attribute_response_key][att] = true;
+        }
+        return &m_deserialization_filter;
+    }
+
+    bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+        return Helper::Topic_Starts_With(topic, topic_length, ATTRIBUTE_RESPONSE_TOPIC, strlen(ATTRIBUTE_RESPONSE_TOPIC));
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return ATTRIBUTE_RESPONSE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -150,16 +163,20 @@ class Attribute_Request : public IAPI_Implementation {
     }
 
     bool Resubscribe_Permanent_Subscriptions() override {
-        m_attribute_request_callbacks.clear();
+        Clear_Single_Event_Subscriptions();
         return true;
     }
 
+    void Clear_Single_Event_Subscriptions() override {
+        m_attribute_request_callbacks.clear();
+    }
+
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
-        for (auto & attribute_request : m_attribute_request_callbacks) {
+        m_attribute_request_callbacks.For_Each([](Callback_Value & attribute_request) {
             auto & request_callback = attribute_request.Get_Request_Timeout();
             request_callback.Update_Timeout_Timer();
-        }
+        });
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
@@ -167,11 +184,12 @@ class Attribute_Request : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
         m_get_request_id_callback.Set_Callback(get_request_id_callback);
+        m_get_json_allocator_callback.Set_Callback(get_json_allocator_callback);
     }
 
   private:
@@ -192,8 +210,15 @@ class Attribute_Request : public IAPI_Implementation {
             return false;
         }
 
+        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
+        if (p_request_id == nullptr) {
+            Logger::printfln(REQUEST_ID_NULL);
+            return false;
+        }
+        auto & request_id = *p_request_id;
+
         Callback_Value * registered_callback = nullptr;
-        if (!Attributes_Request_Subscribe(callback, registered_callback)) {
+        if (!Attributes_Request_Subscribe(callback, request_id + 1U, registered_callback)) {
             return false;
         }
         else if (registered_callback == nullptr) {
@@ -203,7 +228,7 @@ class Attribute_Request : public IAPI_Implementation {
         // String are const char* and therefore stored as a pointer --> zero copy, meaning the size for the strings is 0 bytes,
         // Data structure size depends on the amount of key value pairs passed + the default clientKeys or sharedKeys
         // See https://arduinojson.org/v7/assistant/ for more information on the needed size for the JsonDocument
-        JsonDocument request_buffer;
+        JsonDocument request_buffer(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
 
         // Calculate the size required for the char buffer containing all the attributes seperated by a comma,
         // before initalizing it so it is possible to allocate it on the stack
@@ -243,13 +268,6 @@ class Attribute_Request : public IAPI_Implementation {
         // and because there is not enough space the value would simply be "undefined" instead. Which would cause the request to not be sent correctly
         request_buffer[attribute_request_key] = static_cast<const char*>(request);
 
-        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
-        if (p_request_id == nullptr) {
-            Logger::printfln(REQUEST_ID_NULL);
-            return false;
-        }
-        auto & request_id = *p_request_id;
-
         registered_callback->Set_Request_ID(++request_id);
         registered_callback->Set_Attribute_Key(attribute_response_key);
         auto & request_callback = registered_callback->Get_Request_Timeout();
@@ -262,11 +280,12 @@ class Attribute_Request : public IAPI_Implementation {
 
     /// @brief Subscribes to attribute response topic
     /// @param callback Callback method that will be called when the requested client-side attributes has been received
+    /// @param request_id Id the request will be sent with, used as the key the response is looked up with
     /// @param registered_callback Editable pointer to a reference of the local version that was copied from the passed callback
     /// @return Whether subscribing to the attribute response topic, was successful or not
-    bool Attributes_Request_Subscribe(Callback_Value const & callback, Callback_Value * & registered_callback) {
+    bool Attributes_Request_Subscribe(Callback_Value const & callback, size_t const & request_id, Callback_Value * & registered_callback) {
 #if !THINGSBOARD_ENABLE_DYNAMIC
-        if (m_attribute_request_callbacks.size() + 1 > m_attribute_request_callbacks.capacity()) {
+        if (m_attribute_request_callbacks.size() + 1 > MaxSubscriptions) {
             Logger::printfln(MAX_SUBSCRIPTIONS_EXCEEDED, CLIENT_SHARED_ATTRIBUTE_SUBSCRIPTIONS, MAX_SUBSCRIPTIONS_TEMPLATE_NAME);
             return false;
         }
@@ -275,8 +294,7 @@ class Attribute_Request : public IAPI_Implementation {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, ATTRIBUTE_RESPONSE_SUBSCRIBE_TOPIC);
           return false;
         }
-        m_attribute_request_callbacks.push_back(callback);
-        registered_callback = &m_attribute_request_callbacks.back();
+        registered_callback = m_attribute_request_callbacks.Insert(request_id, callback);
         return true;
     }
 
@@ -291,7 +309,9 @@ class Attribute_Request : public IAPI_Implementation {
     Callback<bool, char const * const>                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
     Callback<bool, char const * const>                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
     Callback<size_t *>                                       m_get_request_id_callback = {};     // Get internal request id callback
-    Callback_Container                                       m_attribute_request_callbacks = {}; // Client-side or shared attribute request callback vector
+    Callback<ArduinoJson::Allocator *>                       m_get_json_allocator_callback = {}; // Get send json allocator callback
+    Callback_Container                                       m_attribute_request_callbacks = {}; // Pending client-side or shared attribute request callbacks, keyed by request id
+    JsonDocument                                             m_deserialization_filter = {};      // Filter containing the requested keys of the request the last response was received for
 };
 
 #endif // Attribute_Request_h
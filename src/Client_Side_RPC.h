@@ -4,6 +4,7 @@
 // Local includes.
 #include "RPC_Request_Callback.h"
 #include "IAPI_Implementation.h"
+#include "Request_Table.h"
 
 
 // client-side RPC topics.
@@ -42,8 +43,15 @@ class Client_Side_RPC : public IAPI_Implementation {
             Logger::printfln(CLIENT_RPC_METHOD_NULL);
             return false;
         }
+        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
+        if (p_request_id == nullptr) {
+            Logger::printfln(REQUEST_ID_NULL);
+            return false;
+        }
+        auto & request_id = *p_request_id;
+
         RPC_Request_Callback * registered_callback = nullptr;
-        if (!RPC_Request_Subscribe(callback, registered_callback)) {
+        if (!RPC_Request_Subscribe(callback, request_id + 1U, registered_callback)) {
             return false;
         }
         else if (registered_callback == nullptr) {
@@ -52,7 +60,7 @@ class Client_Side_RPC : public IAPI_Implementation {
 
         JsonArray const * parameters = callback.Get_Parameters();
 
-        JsonDocument request_buffer;
+        JsonDocument request_buffer(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
         request_buffer[RPC_METHOD_KEY] = method_name;
 
         if (parameters != nullptr && !parameters->isNull()) {
@@ -62,13 +70,6 @@ class Client_Side_RPC : public IAPI_Implementation {
             request_buffer[RPC_PARAMS_KEY] = RPC_EMPTY_PARAMS_VALUE;
         }
 
-        size_t * p_request_id = m_get_request_id_callback.Call_Callback();
-        if (p_request_id == nullptr) {
-            Logger::printfln(REQUEST_ID_NULL);
-            return false;
-        }
-        auto & request_id = *p_request_id;
-
         registered_callback->Set_Request_ID(++request_id);
         auto & request_callback = registered_callback->Get_Request_Timeout();
         request_callback.Start_Timeout_Timer();
@@ -82,36 +83,21 @@ class Client_Side_RPC : public IAPI_Implementation {
         return API_Process_Type::JSON;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+    void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
         // Nothing to do
     }
 
-    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
-        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(RPC_RESPONSE_TOPIC));
+    void Process_Json_Response(char const * topic, size_t const & topic_length, JsonDocument const & data) override {
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(RPC_RESPONSE_TOPIC));
 
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_request_callbacks.begin(), m_rpc_request_callbacks.end(), [&request_id](RPC_Request_Callback & rpc_request) {
-            return rpc_request.Get_Request_ID() == request_id;
-        });
-        if (it != m_rpc_request_callbacks.end()) {
-            auto & rpc_request = *it;
-#else
-        for (auto it = m_rpc_request_callbacks.begin(); it != m_rpc_request_callbacks.end(); ++it) {
-            auto & rpc_request = *it;
-
-            if (rpc_request.Get_Request_ID() != request_id) {
-                continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
-            auto & request_timeout = rpc_request.Get_Request_Timeout();
+        RPC_Request_Callback * rpc_request = m_rpc_request_callbacks.Find(request_id);
+        if (rpc_request != nullptr) {
+            auto & request_timeout = rpc_request->Get_Request_Timeout();
             request_timeout.Stop_Timeout_Timer();
-            rpc_request.Call_Callback(data);
+            rpc_request->Call_Callback(data);
 
             // Delete callback because the changes have been requested and the callback is no longer needed
-            m_rpc_request_callbacks.erase(it);
-#if !THINGSBOARD_ENABLE_STL
-            break;
-#endif // !THINGSBOARD_ENABLE_STL
+            m_rpc_request_callbacks.Remove(request_id);
         }
 
         // Attempt to unsubscribe from the shared attribute request topic,
@@ -122,8 +108,12 @@ class Client_Side_RPC : public IAPI_Implementation {
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(RPC_RESPONSE_TOPIC, topic, strlen(RPC_RESPONSE_TOPIC)) == 0;
+    bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+        return Helper::Topic_Starts_With(topic, topic_length, RPC_RESPONSE_TOPIC, strlen(RPC_RESPONSE_TOPIC));
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return RPC_RESPONSE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -131,16 +121,20 @@ class Client_Side_RPC : public IAPI_Implementation {
     }
 
     bool Resubscribe_Permanent_Subscriptions() override {
+        Clear_Single_Event_Subscriptions();
+        return m_unsubscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC);
+    }
+
+    void Clear_Single_Event_Subscriptions() override {
         m_rpc_request_callbacks.clear();
-        return Unsubscribe();
     }
 
 #if !THINGSBOARD_USE_ESP_TIMER
     void loop() override {
-        for (auto & rpc_request : m_rpc_request_callbacks) {
+        m_rpc_request_callbacks.For_Each([](RPC_Request_Callback & rpc_request) {
             auto & request_callback = rpc_request.Get_Request_Timeout();
             request_callback.Update_Timeout_Timer();
-        }
+        });
     }
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
@@ -148,42 +142,43 @@ class Client_Side_RPC : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
         m_get_request_id_callback.Set_Callback(get_request_id_callback);
+        m_get_json_allocator_callback.Set_Callback(get_json_allocator_callback);
     }
 
   private:
-    using Callback_Container = Container<RPC_Request_Callback>;
+    using Callback_Container = Request_Table<RPC_Request_Callback>;
 
     /// @brief Subscribes to the client-side rpc response topic
     /// @param callback Callback method that will be called when the response from the server for the executed client-side rpc method has been received
+    /// @param request_id Id the request will be sent with, used as the key the response is looked up with
     /// @param registered_callback Editable pointer to a reference of the local version that was copied from the passed callback
     /// @return Whether subscribing to the client-side rpc response topic, was successful or not
-    bool RPC_Request_Subscribe(RPC_Request_Callback const & callback, RPC_Request_Callback * & registered_callback) {
+    bool RPC_Request_Subscribe(RPC_Request_Callback const & callback, size_t const & request_id, RPC_Request_Callback * & registered_callback) {
         if (!m_subscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_RESPONSE_SUBSCRIBE_TOPIC);
             return false;
         }
-        m_rpc_request_callbacks.push_back(callback);
-        registered_callback = &m_rpc_request_callbacks.back();
+        registered_callback = m_rpc_request_callbacks.Insert(request_id, callback);
         return true;
     }
 
     /// @brief Unsubscribes all client-side rpc request callbacks
     /// @return Whether unsubscribing to the client-side rpc response topic, was successful or not
     bool RPC_Request_Unsubscribe() {
-        (void)Resubscribe_Permanent_Subscriptions();
-        return m_unsubscribe_topic_callback.Call_Callback(RPC_RESPONSE_SUBSCRIBE_TOPIC);
+        return Resubscribe_Permanent_Subscriptions();
     }
 
     Callback<bool, char const * const, JsonDocument const &> m_send_json_callback = {};          // Send json document callback
     Callback<bool, char const * const>                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
     Callback<bool, char const * const>                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
     Callback<size_t *>                                       m_get_request_id_callback = {};     // Get internal request id callback
-    Callback_Container                                       m_rpc_request_callbacks = {};       // Server side RPC callbacks vector
+    Callback<ArduinoJson::Allocator *>                       m_get_json_allocator_callback = {}; // Get send json allocator callback
+    Callback_Container                                       m_rpc_request_callbacks = {};       // Pending client-side RPC request callbacks, keyed by request id
 };
 
 #endif // Client_Side_RPC_h
\ No newline at end of file
@@ -21,8 +21,12 @@ char constexpr UNABLE_TO_ALLOCATE_BUFFER[] = "Allocating memory for the internal
 char constexpr MAXIMUM_RESPONSE_EXCEEDED[] = "Prevented allocation on the heap (%u) for JsonDocument. Discarding message that is bigger than maximum response size (%u)";
 char constexpr HEAP_ALLOCATION_FAILED[] = "Failed allocating required size (%u) for JsonDocument. Ensure there is enough heap memory left";
 char constexpr CONNECT_FAILED[] = "Connecting to server failed";
+char constexpr UNABLE_TO_DECODE_PROTOBUF[] = "Unable to decode received protobuf message over topic (%.*s)";
+char constexpr SAMPLE_TOO_BIG[] = "Discarding sample, because it is bigger than the send buffer size (%u)";
+char constexpr FRAGMENTED_MESSAGE_DISCARDED[] = "Discarding received message with (%u) bytes over topic (%.*s), because it is bigger than the receive buffer and no API implementation handles it in fragments";
 #if THINGSBOARD_ENABLE_DEBUG
-char constexpr RECEIVE_MESSAGE[] = "Received (%u) bytes of data from server over topic (%s)";
+char constexpr RECEIVE_MESSAGE[] = "Received (%u) bytes of data from server over topic (%.*s)";
+char constexpr RECEIVE_FRAGMENT[] = "Received fragment of (%u) bytes at offset (%u) of (%u) bytes of data from server over topic (%.*s)";
 char constexpr ALLOCATING_JSON[] = "Allocated internal JsonDocument for MQTT server response with size (%u)";
 char constexpr SEND_MESSAGE[] = "Sending data to server over topic (%s) with data (%s)";
 char constexpr SEND_SERIALIZED[] = "Hidden, because json data is bigger than buffer, therefore showing in console is skipped";
@@ -47,6 +51,9 @@ char constexpr ATTRIBUTE_RESPONSE_TOPIC[] = "v1/devices/me/attributes/response";
 char constexpr SHARED_KEY[] = "shared";
 // Telemetry topics.
 char constexpr TELEMETRY_TOPIC[] = "v1/devices/me/telemetry";
+// Telemetry data keys.
+char constexpr TS_KEY[] = "ts";
+char constexpr VALUES_KEY[] = "values";
 // Provision topics.
 char constexpr PROV_REQUEST_TOPIC[] = "/provision/request";
 char constexpr PROV_RESPONSE_TOPIC[] = "/provision/response";
@@ -86,6 +93,50 @@ char constexpr MD5[] = "MD5";
 char constexpr SHA256[] = "SHA256";
 char constexpr SHA384[] = "SHA384";
 char constexpr SHA512[] = "SHA512";
+// Protobuf transcoded RPC topics.
+char constexpr TRANSCODED_RPC_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/";
+char constexpr TRANSCODED_RPC_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/";
+// Protobuf RPC field numbers, of the default schemas created in the device profile.
+uint32_t constexpr RPC_REQUEST_METHOD_FIELD = 1U;
+uint32_t constexpr RPC_REQUEST_ID_FIELD = 2U;
+uint32_t constexpr RPC_REQUEST_PARAMS_FIELD = 3U;
+uint32_t constexpr RPC_RESPONSE_PAYLOAD_FIELD = 1U;
+// Protobuf transcoded client-side RPC and attribute topics.
+char constexpr TRANSCODED_ATTRIBUTE_REQUEST_TOPIC[] = "v1/devices/me/attributes/request/";
+char constexpr TRANSCODED_ATTRIBUTE_RESPONSE_TOPIC[] = "v1/devices/me/attributes/response/";
+// Protobuf client-side RPC field numbers, of the fixed ToServerRpcRequestMsg and ToServerRpcResponseMsg transport messages.
+uint32_t constexpr CLIENT_RPC_REQUEST_METHOD_FIELD = 2U;
+uint32_t constexpr CLIENT_RPC_REQUEST_PARAMS_FIELD = 3U;
+uint32_t constexpr CLIENT_RPC_RESPONSE_PAYLOAD_FIELD = 2U;
+uint32_t constexpr CLIENT_RPC_RESPONSE_ERROR_FIELD = 3U;
+// Protobuf attribute field numbers, of the fixed AttributesRequest, GetAttributeResponseMsg and AttributeUpdateNotificationMsg transport messages.
+uint32_t constexpr ATTRIBUTE_REQUEST_CLIENT_KEYS_FIELD = 1U;
+uint32_t constexpr ATTRIBUTE_REQUEST_SHARED_KEYS_FIELD = 2U;
+uint32_t constexpr ATTRIBUTE_RESPONSE_CLIENT_FIELD = 2U;
+uint32_t constexpr ATTRIBUTE_RESPONSE_SHARED_FIELD = 3U;
+uint32_t constexpr ATTRIBUTE_RESPONSE_ERROR_FIELD = 5U;
+uint32_t constexpr ATTRIBUTE_UPDATE_SHARED_FIELD = 1U;
+uint32_t constexpr ATTRIBUTE_UPDATE_DELETED_FIELD = 2U;
+// Protobuf key-value field numbers, of the fixed TsKvProto and KeyValueProto transport messages.
+uint32_t constexpr TS_KV_VALUE_FIELD = 2U;
+uint32_t constexpr KEY_VALUE_KEY_FIELD = 1U;
+uint32_t constexpr KEY_VALUE_TYPE_FIELD = 2U;
+uint32_t constexpr KEY_VALUE_BOOL_FIELD = 3U;
+uint32_t constexpr KEY_VALUE_LONG_FIELD = 4U;
+uint32_t constexpr KEY_VALUE_DOUBLE_FIELD = 5U;
+uint32_t constexpr KEY_VALUE_STRING_FIELD = 6U;
+uint32_t constexpr KEY_VALUE_JSON_FIELD = 7U;
+// Protobuf key-value types, of the fixed KeyValueType transport enum.
+uint64_t constexpr KEY_VALUE_TYPE_BOOLEAN = 0U;
+uint64_t constexpr KEY_VALUE_TYPE_LONG = 1U;
+uint64_t constexpr KEY_VALUE_TYPE_DOUBLE = 2U;
+uint64_t constexpr KEY_VALUE_TYPE_STRING = 3U;
+uint64_t constexpr KEY_VALUE_TYPE_JSON = 4U;
+// Protobuf transcoded data keys.
+char constexpr TRANSCODED_CLIENT_KEYS_KEY[] = "clientKeys";
+char constexpr TRANSCODED_SHARED_KEYS_KEY[] = "sharedKeys";
+char constexpr TRANSCODED_DELETED_KEY[] = "deleted";
+char constexpr TRANSCODED_ERROR_KEY[] = "error";
 // General data keys.
 char constexpr CLIENT_SCOPE[] = "client";
 char constexpr KEY[] = "key";
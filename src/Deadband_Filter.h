@@ -0,0 +1,350 @@
+#ifndef Deadband_Filter_h
+#define Deadband_Filter_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+#include <math.h>
+#if THINGSBOARD_ENABLE_STL
+#include <type_traits>
+#endif // THINGSBOARD_ENABLE_STL
+
+
+/// @brief Report-by-exception filter on top of the ThingsBoard telemetry and attribute API, which only sends a key-value pair if its value changed by more than the configured deadband since it was last sent.
+/// @note Most analog readings barely change between two samples, but every publish still counts towards the server side rate limits and the data usage of metered connections.
+/// The filter therefore keeps the last sent value of every key and suppresses any send whose change is below the absolute or percentual deadband configured for that key.
+/// A numeric value is sent if its change is atleast as big as either of the configured deadbands, if no deadband is configured for a key, every change is sent.
+/// Boolean and string values are sent whenever they change, where strings are compared with a CRC-32 checksum of their content, so they do not have to be kept alive.
+/// Additionally the last value is sent again once the maximum interval has passed since it was last sent, even if it did not change (heartbeat), so the server can differentiate between an unchanged value and a device that stopped sending.
+/// The last sent value is tracked seperately for telemetry and attribute data. If more different keys are sent than fit into the filter, the additional keys are simply sent unfiltered.
+/// Be aware that the keys are not copied, but instead only the non owning pointers are kept, therefore ensure the keys are kept alive as long as the filter is used, which is most easily achieved by using string literals
+/// @tparam Capacity Maximum amount of different keys the last sent value is tracked for and maximum amount of keys a deadband can be configured for, default = 16
+template <size_t Capacity = 16U>
+class Deadband_Filter {
+  public:
+    /// @brief Constructs a filter that sends over the given ThingsBoard instance
+    /// @param thingsboard ThingsBoard instance the filtered key-value pairs are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param max_interval_milliseconds Maximum amount of milliseconds an unchanged value is suppressed, before it is sent again anyway, 0 means unchanged values are never sent again, default = 60000
+    /// @param absolute_deadband Minimum absolute change of numeric values of keys without their own configured deadband, default = 0.0
+    /// @param percent_deadband Minimum change relative to the last sent value in percent of numeric values of keys without their own configured deadband, default = 0.0
+    explicit Deadband_Filter(ThingsBoard & thingsboard, uint64_t const & max_interval_milliseconds = 60000U, double const & absolute_deadband = 0.0, double const & percent_deadband = 0.0)
+      : m_thingsboard(thingsboard)
+      , m_default_rule()
+      , m_rules()
+      , m_rule_count(0U)
+      , m_states()
+      , m_state_count(0U)
+      , m_suppressed(0U)
+    {
+        m_default_rule.absolute = absolute_deadband;
+        m_default_rule.percent = percent_deadband;
+        m_default_rule.max_interval = max_interval_milliseconds;
+    }
+
+    /// @brief Configures the deadband of the given key, overwriting the previously configured deadband of the same key
+    /// @note Unchanged values of the key are sent again after the maximum interval passed to the constructor
+    /// @param key Non owning pointer to the key the deadband should be configured for.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param absolute_deadband Minimum absolute change of the numeric value, 0 to disable
+    /// @param percent_deadband Minimum change relative to the last sent value in percent, 0 to disable, default = 0.0
+    /// @return Whether configuring the deadband was successful or not, fails if the key is nullptr or deadbands for Capacity other keys have already been configured
+    bool Set_Deadband(char const * key, double const & absolute_deadband, double const & percent_deadband = 0.0) {
+        return Set_Deadband(key, absolute_deadband, percent_deadband, m_default_rule.max_interval);
+    }
+
+    /// @brief Configures the deadband and the maximum interval of the given key, overwriting the previously configured deadband of the same key
+    /// @param key Non owning pointer to the key the deadband should be configured for.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param absolute_deadband Minimum absolute change of the numeric value, 0 to disable
+    /// @param percent_deadband Minimum change relative to the last sent value in percent, 0 to disable
+    /// @param max_interval_milliseconds Maximum amount of milliseconds an unchanged value is suppressed, 0 means unchanged values are never sent again
+    /// @return Whether configuring the deadband was successful or not, fails if the key is nullptr or deadbands for Capacity other keys have already been configured
+    bool Set_Deadband(char const * key, double const & absolute_deadband, double const & percent_deadband, uint64_t const & max_interval_milliseconds) {
+        if (key == nullptr) {
+            return false;
+        }
+        size_t index = 0U;
+        while (index < m_rule_count && strcmp(m_rules[index].key, key) != 0) {
+            index++;
+        }
+        if (index == Capacity) {
+            return false;
+        }
+        if (index == m_rule_count) {
+            m_rule_count++;
+        }
+        Deadband_Rule & rule = m_rules[index];
+        rule.key = key;
+        rule.absolute = absolute_deadband;
+        rule.percent = percent_deadband;
+        rule.max_interval = max_interval_milliseconds;
+        return true;
+    }
+
+    /// @brief Sends the given numeric key-value pair as telemetry data, if its value changed by more than the deadband or the maximum interval has passed
+    /// @tparam T Type of the passed value, has to be integral or floating point
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Value of the key-value pair
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_integral and is_floating_point, ensures strings are not converted by mistake
+              typename std::enable_if<std::is_integral<T>::value || std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if, is_integral and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value || ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Send_Telemetry_Data(char const * key, T const & value) {
+        return Send_Numeric(key, value, static_cast<double>(value), true);
+    }
+
+    /// @brief Sends the given boolean key-value pair as telemetry data, if its value changed or the maximum interval has passed
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Value of the key-value pair
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    bool Send_Telemetry_Data(char const * key, bool value) {
+        return Send_Exact(key, value, value ? 1U : 0U, true);
+    }
+
+    /// @brief Sends the given string key-value pair as telemetry data, if its value changed or the maximum interval has passed
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Non owning pointer to the value of the key-value pair.
+    /// Does not need to be kept alive, because only a checksum of the content is kept
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    bool Send_Telemetry_Data(char const * key, char const * value) {
+        return Send_Exact(key, value, Calculate_String_Checksum(value), true);
+    }
+
+    /// @brief Sends the given numeric key-value pair as attribute data, if its value changed by more than the deadband or the maximum interval has passed
+    /// @tparam T Type of the passed value, has to be integral or floating point
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Value of the key-value pair
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_integral and is_floating_point, ensures strings are not converted by mistake
+              typename std::enable_if<std::is_integral<T>::value || std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if, is_integral and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value || ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Send_Attribute_Data(char const * key, T const & value) {
+        return Send_Numeric(key, value, static_cast<double>(value), false);
+    }
+
+    /// @brief Sends the given boolean key-value pair as attribute data, if its value changed or the maximum interval has passed
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Value of the key-value pair
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    bool Send_Attribute_Data(char const * key, bool value) {
+        return Send_Exact(key, value, value ? 1U : 0U, false);
+    }
+
+    /// @brief Sends the given string key-value pair as attribute data, if its value changed or the maximum interval has passed
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive as long as the filter is used, because only the pointer is kept
+    /// @param value Non owning pointer to the value of the key-value pair.
+    /// Does not need to be kept alive, because only a checksum of the content is kept
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    bool Send_Attribute_Data(char const * key, char const * value) {
+        return Send_Exact(key, value, Calculate_String_Checksum(value), false);
+    }
+
+    /// @brief Forgets the last sent value of every key, so that the next value of every key is sent regardless of its change
+    /// @note Should be called after the connection to the server has been reestablished, to ensure the server receives the current state
+    void Reset() {
+        m_state_count = 0U;
+    }
+
+    /// @brief Returns the amount of sends that have been suppressed, because the value did not change by more than the deadband
+    /// @return Amount of saved publishes
+    size_t const & Get_Suppressed() const {
+        return m_suppressed;
+    }
+
+  private:
+    /// @brief Configured deadband of a key
+    struct Deadband_Rule {
+        char const * key = {};          // Key the deadband is configured for, nullptr for the default deadband
+        double       absolute = {};     // Minimum absolute change of the numeric value, 0 if disabled
+        double       percent = {};      // Minimum change relative to the last sent value in percent, 0 if disabled
+        uint64_t     max_interval = {}; // Maximum amount of milliseconds an unchanged value is suppressed, 0 if unchanged values are never sent again
+    };
+
+    /// @brief Last sent value of a key
+    struct Deadband_State {
+        char const * key = {};       // Key the value was sent with
+        bool         telemetry = {}; // Whether the value was sent as telemetry or attribute data
+        double       value = {};     // Last sent numeric value
+        uint32_t     checksum = {};  // Last sent boolean value or CRC-32 checksum of the last sent string value
+        uint64_t     sent_at = {};   // Uptime in milliseconds the value was last sent at
+        bool         sent = {};      // Whether any value has been sent successfully yet
+    };
+
+    /// @brief Sends the given key-value pair, if its numeric value changed by atleast the deadband of the key since it was last sent or the maximum interval has passed
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key-value pair
+    /// @param value Value of the key-value pair
+    /// @param numeric_value Value of the key-value pair converted into a floating point, used to calculate the change
+    /// @param telemetry Whether the key-value pair should be sent as telemetry or attribute data
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    template<typename T>
+    bool Send_Numeric(char const * key, T const & value, double const & numeric_value, bool const & telemetry) {
+        if (key == nullptr) {
+            return false;
+        }
+        Deadband_Rule const & rule = Find_Rule(key);
+        Deadband_State * state = Find_State(key, telemetry);
+        uint64_t const current_time = Helper::Get_Uptime_Milliseconds();
+        if (state != nullptr && !Interval_Passed(rule, *state, current_time)) {
+            if (!Deadband_Exceeded(rule, state->value, numeric_value)) {
+                m_suppressed++;
+                return true;
+            }
+        }
+        if (!Send(key, value, telemetry)) {
+            return false;
+        }
+        if (state != nullptr) {
+            state->value = numeric_value;
+            state->sent_at = current_time;
+            state->sent = true;
+        }
+        return true;
+    }
+
+    /// @brief Sends the given key-value pair, if its value changed since it was last sent or the maximum interval has passed
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key-value pair
+    /// @param value Value of the key-value pair
+    /// @param checksum Value or checksum of the value, used to decide whether the value changed
+    /// @param telemetry Whether the key-value pair should be sent as telemetry or attribute data
+    /// @return Whether sending the key-value pair was successful or not, also true if the send was suppressed
+    template<typename T>
+    bool Send_Exact(char const * key, T const & value, uint32_t const & checksum, bool const & telemetry) {
+        if (key == nullptr) {
+            return false;
+        }
+        Deadband_State * state = Find_State(key, telemetry);
+        uint64_t const current_time = Helper::Get_Uptime_Milliseconds();
+        if (state != nullptr && !Interval_Passed(Find_Rule(key), *state, current_time) && state->checksum == checksum) {
+            m_suppressed++;
+            return true;
+        }
+        if (!Send(key, value, telemetry)) {
+            return false;
+        }
+        if (state != nullptr) {
+            state->checksum = checksum;
+            state->sent_at = current_time;
+            state->sent = true;
+        }
+        return true;
+    }
+
+    /// @brief Sends the given key-value pair with the underlying ThingsBoard instance
+    /// @tparam T Type of the passed value
+    /// @param key Key of the key-value pair
+    /// @param value Value of the key-value pair
+    /// @param telemetry Whether the key-value pair should be sent as telemetry or attribute data
+    /// @return Whether sending the key-value pair was successful or not
+    template<typename T>
+    bool Send(char const * key, T const & value, bool const & telemetry) {
+        return telemetry ? m_thingsboard.Send_Telemetry_Data(key, value) : m_thingsboard.Send_Attribute_Data(key, value);
+    }
+
+    /// @brief Returns the deadband configured for the given key or the default deadband if none has been configured
+    /// @param key Key to search for
+    /// @return Deadband of the given key
+    Deadband_Rule const & Find_Rule(char const * key) const {
+        for (size_t index = 0U; index < m_rule_count; ++index) {
+            if (strcmp(m_rules[index].key, key) == 0) {
+                return m_rules[index];
+            }
+        }
+        return m_default_rule;
+    }
+
+    /// @brief Returns the last sent value of the given key, inserts a new entry that is sent immediately if the key has not been sent yet
+    /// @param key Key to search for
+    /// @param telemetry Whether the key is sent as telemetry or attribute data
+    /// @return Last sent value of the given key, nullptr if the key has not been sent yet or there is no space left to track it
+    Deadband_State * Find_State(char const * key, bool const & telemetry) {
+        for (size_t index = 0U; index < m_state_count; ++index) {
+            Deadband_State & state = m_states[index];
+            if (state.telemetry == telemetry && strcmp(state.key, key) == 0) {
+                return &state;
+            }
+        }
+        if (m_state_count == Capacity) {
+            return nullptr;
+        }
+        // Start tracking the key, until the first value has been sent successfully the interval counts as passed, so that the first value is always sent
+        Deadband_State & state = m_states[m_state_count];
+        state = Deadband_State();
+        state.key = key;
+        state.telemetry = telemetry;
+        m_state_count++;
+        return &state;
+    }
+
+    /// @brief Whether the given value changed by atleast the deadband of the key since the last sent value
+    /// @note The percentual deadband is only used if the last sent value is not 0, because any change relative to 0 would otherwise always exceed it.
+    /// In that case only the absolute deadband is used, or every change is sent if none is configured.
+    /// NaN compares false with every value, therefore a transition from or to NaN always counts as a change, while two consecutive NaN values do not
+    /// @param rule Deadband of the key
+    /// @param last_value Last sent numeric value of the key
+    /// @param value Current numeric value of the key
+    /// @return Whether the value has to be sent
+    static bool Deadband_Exceeded(Deadband_Rule const & rule, double const & last_value, double const & value) {
+        bool const last_is_nan = isnan(last_value);
+        bool const is_nan = isnan(value);
+        if (last_is_nan || is_nan) {
+            return last_is_nan != is_nan;
+        }
+        double const change = fabs(value - last_value);
+        bool const use_percent = rule.percent > 0.0 && last_value != 0.0;
+        if (rule.absolute <= 0.0 && !use_percent) {
+            return change > 0.0;
+        }
+        return (rule.absolute > 0.0 && change >= rule.absolute) || (use_percent && change >= fabs(last_value) * rule.percent / 100.0);
+    }
+
+    /// @brief Whether the value has to be sent regardless of its change, because it has never been sent or the maximum interval has passed
+    /// @param rule Deadband of the key
+    /// @param state Last sent value of the key
+    /// @param current_time Current uptime in milliseconds
+    /// @return Whether the value has to be sent
+    static bool Interval_Passed(Deadband_Rule const & rule, Deadband_State const & state, uint64_t const & current_time) {
+        return !state.sent || (rule.max_interval != 0U && current_time - state.sent_at >= rule.max_interval);
+    }
+
+    /// @brief Calculates the checksum of the given string content
+    /// @param value String to calculate the checksum of, nullptr is handled like an empty string
+    /// @return CRC-32 checksum of the string
+    static uint32_t Calculate_String_Checksum(char const * value) {
+        if (value == nullptr) {
+            return 0U;
+        }
+        return Helper::Calculate_CRC32(reinterpret_cast<uint8_t const *>(value), strlen(value));
+    }
+
+    ThingsBoard &  m_thingsboard;           // ThingsBoard instance the filtered key-value pairs are sent with
+    Deadband_Rule  m_default_rule = {};     // Deadband used for keys without their own configured deadband
+    Deadband_Rule  m_rules[Capacity] = {};  // Deadbands configured for specific keys
+    size_t         m_rule_count = {};       // Amount of configured deadbands
+    Deadband_State m_states[Capacity] = {}; // Last sent value of every tracked key
+    size_t         m_state_count = {};      // Amount of tracked keys
+    size_t         m_suppressed = {};       // Amount of suppressed sends
+};
+
+#endif // Deadband_Filter_h
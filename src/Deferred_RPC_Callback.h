@@ -0,0 +1,75 @@
+#ifndef Deferred_RPC_Callback_h
+#define Deferred_RPC_Callback_h
+
+// Local includes.
+#include "Callback.h"
+#include "RPC_Response_Handle.h"
+
+// Third-party includes.
+#include <ArduinoJson.h>
+
+
+/// @brief Deferred server-side RPC callback wrapper, where the response does not have to be created in the callback itself.
+/// Instead the callback receives a @ref RPC_Response_Handle, which can be copied and completed later on from any task, for example once a slow actuator has finished moving.
+/// Documentation about the specific use of Server-side RPC in ThingsBoard can be found here https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc
+/// @note The callback is still called on the task receiving the request and should therefore only pass the received parameters and the handle on and return immediately,
+/// so that the processing of other received messages is not blocked until the response is known. The response is then sent in the @ref ThingsBoard::loop method,
+/// which requires a response queue to be set with @ref Server_Side_RPC::Set_Response_Queue. See @ref RPC_Response_Queue for more information.
+/// The received parameters point into the memory of the received message, which is released or reused for the next message as soon as the callback returns.
+/// Any value that is still needed afterwards, has to be copied out of the parameters before returning, for example into a local struct or a separate JsonDocument.
+/// Only the handle itself can be passed on as is, because it does not reference the received message
+class Deferred_RPC_Callback : public Callback<void, ArduinoJson::JsonVariantConst const &, RPC_Response_Handle const &> {
+    public:
+        /// @brief Constructs empty callback, will result in never being called. Internals are simply default constructed as nullptr
+        Deferred_RPC_Callback() = default;
+
+        /// @brief Constructs callback that will be called upon server-side RPC request arrival with the given method name
+        /// @param method_name Non owning pointer to the name we expect to be sent with the server-side RPC request so that this method callback will be executed.
+        /// Additionally it has to be kept alive by the user for the lifetime of this server-side RPC callback, otherwise the callback method will never be called
+        /// @param callback callback method that will be called upon data arrival with the given data that was received and the handle the request can be completed with.
+        /// If nullptr is passed the callback will never be called and the request instead times out
+        /// @param timeout_milliseconds Amount of milliseconds after which an error response is sent instead, if the request has not been completed until then.
+        /// If the value is 0 the request never times out and keeps its entry in the response queue reserved until it has been completed, default = 0.
+        /// Targets without an uptime clock (see @ref Helper::Has_Uptime_Clock) can not measure the timeout, subscribing a callback with a timeout other than 0 therefore fails on them
+        Deferred_RPC_Callback(char const * method_name, function callback, uint64_t const & timeout_milliseconds = 0U)
+            : Callback(callback)
+            , m_method_name(method_name)
+            , m_timeout_milliseconds(timeout_milliseconds)
+        {
+                // Nothing to do
+        }
+
+        ~Deferred_RPC_Callback() override = default;
+
+        /// @brief Gets the name we expect to be sent with the server-side RPC request so that this method callback will be executed
+        /// @return Non owning pointer to the name we expect to be sent with the server-side RPC request.
+        /// Owned by the user that passed it originally in the constructor or with the @ref Set_Name method
+        char const * Get_Name() const {
+                return m_method_name;
+        }
+
+        /// @brief Sets the name we expect to be sent with the server-side RPC request so that this method callback will be executed
+        /// @param method_name Non owning pointer to the name we expect to be sent with the server-side RPC request.
+        /// Additionally it has to be kept alive by the user for the lifetime of this server-side RPC callback, otherwise the callback method will never be called
+        void Set_Name(char const * method_name) {
+                m_method_name = method_name;
+        }
+
+        /// @brief Gets the amount of milliseconds after which an error response is sent instead, if the request has not been completed until then
+        /// @return Timeout time of the request, 0 if it never times out
+        uint64_t const & Get_Timeout() const {
+                return m_timeout_milliseconds;
+        }
+
+        /// @brief Sets the amount of milliseconds after which an error response is sent instead, if the request has not been completed until then
+        /// @param timeout_milliseconds Timeout time of the request, 0 if it never times out
+        void Set_Timeout(uint64_t const & timeout_milliseconds) {
+                m_timeout_milliseconds = timeout_milliseconds;
+        }
+
+    private:
+        char const *m_method_name = {};          // Method name
+        uint64_t   m_timeout_milliseconds = {};  // Timeout time of the request
+};
+
+#endif // Deferred_RPC_Callback_h
@@ -0,0 +1,472 @@
+#ifndef Duty_Cycle_h
+#define Duty_Cycle_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Identifies an initialized retained batch, any other value means the retained memory was lost or never written and the batch is started empty instead
+uint32_t constexpr RETAINED_BATCH_MAGIC = 0x54424443U;
+/// @brief Sample type flag, marking that the sample should receive the time it arrives on the server, because it was taken without a timestamp
+uint8_t constexpr RETAINED_SAMPLE_WITHOUT_TIMESTAMP = 0x80U;
+/// @brief Mask to remove the flags from the sample type
+uint8_t constexpr RETAINED_SAMPLE_TYPE_MASK = 0x7FU;
+
+
+/// @brief Compact sample as it is kept in retained memory, has no padding so that every byte is covered by the checksum
+struct Retained_Sample {
+    uint32_t timestamp_offset = {}; // Milliseconds the sample was taken after the oldest sample in the batch
+    uint32_t value = {};            // Bits of the 32 bit integral, float or boolean value
+    uint8_t  key_index = {};        // Position of the key of the sample
+    uint8_t  type = {};             // Data type of the value and whether the sample has a timestamp
+    uint16_t reserved = {};         // Unused, keeps the size a multiple of 4 bytes without implicit padding
+};
+
+
+/// @brief Memory region that survives deep sleep, has to be placed into retained memory by the application,
+/// for example with RTC_DATA_ATTR on the ESP32 or RTC_NOINIT_ATTR if it should even survive a software reset. On Linux any static instance can be used to simulate the retention region.
+/// @note Is intentionally a plain aggregate without any pointers, so that it stays valid even if the firmware changed in between. The content is only accessed through @ref Duty_Cycle,
+/// which verifies it with the contained checksum and starts with an empty batch if the memory was lost or corrupted
+/// @tparam Capacity Maximum amount of samples that can be retained, every sample requires 12 bytes of retained memory
+template <size_t Capacity>
+struct Retained_Batch {
+    uint32_t        magic = {};              // Identifies an initialized batch
+    uint32_t        checksum = {};           // CRC32 of every following field and all contained samples
+    uint64_t        base_timestamp = {};     // UNIX timestamp in milliseconds of the oldest sample with a timestamp, the timestamps of all samples are stored relative to it
+    uint64_t        total_radio_on_time = {}; // Milliseconds the radio was on in all cycles so far
+    uint32_t        last_radio_on_time = {}; // Milliseconds the radio was on in the last cycle
+    uint32_t        cycles = {};             // Amount of executed connect, publish and disconnect cycles
+    uint16_t        count = {};              // Amount of contained samples
+    uint16_t        dropped = {};            // Amount of samples that were dropped, because the batch was full or their timestamp could not be stored relative to the base timestamp
+    uint16_t        key_count = {};          // Amount of keys the batch was written with, a different amount invalidates the batch
+    uint16_t        capacity = {};           // Capacity the batch was written with, a different capacity invalidates the batch
+    Retained_Sample samples[Capacity] = {};  // Contained samples, oldest first
+};
+
+
+/// @brief Duty-cycle mode for battery devices that spend most of their time in deep sleep, where connecting to the server consumes much more energy than taking the samples.
+/// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+/// @note Samples are appended to a @ref Retained_Batch that survives deep sleep, instead of connecting on every wake up to send a single sample. Once the batch contains the configured amount of samples,
+/// @ref Run_Cycle connects, publishes all samples, disconnects and measures how long that took, which is the time the radio had to be on for. The permanent subscriptions of the API implementations are skipped
+/// while connecting, so that the publish directly follows the connect without waiting for any subscribe acknowledgement. Samples are sent as one json array with the same format as the @ref Telemetry_Sampler,
+/// split into multiple publishes if they do not fit into the send buffer size, and are only removed from the batch once they have been sent successfully and the outbox of the client has been flushed,
+/// see @ref IMQTT_Client::outbox_empty. A cycle that disconnects before that keeps the samples and sends them again with the next cycle instead.
+/// Samples taken without a timestamp receive the time they arrive on the server, which is most likely not the time they were taken at, therefore a timestamp should always be passed if the device knows the current time
+/// @tparam KeyCount Amount of different keys that samples are appended for
+/// @tparam Capacity Maximum amount of samples that can be retained
+template <size_t KeyCount, size_t Capacity>
+class Duty_Cycle : public ITelemetry_Sampler {
+    static_assert(KeyCount > 0U && KeyCount <= UINT8_MAX, "Duty cycle has to contain atleast one key and the key index has to fit into a single byte");
+    static_assert(Capacity > 0U && Capacity <= UINT16_MAX, "Duty cycle has to be able to retain atleast one sample and the amount of samples has to fit into two bytes");
+
+  public:
+    /// @brief Constructs the duty cycle on top of the given retained batch, which keeps all samples of the previous wake ups if its checksum is still valid
+    /// @param thingsboard ThingsBoard instance the samples are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param retained_batch Batch in retained memory the samples are appended to.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param keys Array of non owning pointers to every key, the position of a key in this array is the key index that has to be used to append samples.
+    /// Has to be kept alive as long as the instance of this class, because only the pointers are kept
+    /// @param batch_size Amount of samples that have to be contained before @ref Run_Cycle connects to send them, is limited to the given Capacity, default = Capacity
+    Duty_Cycle(ThingsBoard & thingsboard, Retained_Batch<Capacity> & retained_batch, char const * const (&keys)[KeyCount], size_t const & batch_size = Capacity)
+      : m_thingsboard(thingsboard)
+      , m_batch(retained_batch)
+      , m_keys()
+      , m_batch_size((batch_size == 0U || batch_size > Capacity) ? Capacity : batch_size)
+    {
+        for (size_t index = 0U; index < KeyCount; ++index) {
+            m_keys[index] = keys[index];
+        }
+        if (!Is_Valid()) {
+            Reset();
+        }
+    }
+
+    /// @brief Appends the given integral sample to the retained batch
+    /// @tparam T Type of the passed value, is required to be integral and is stored as a 32 bit integer,
+    /// to ensure this method isn't used instead of the float one by mistake
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range, the batch is full or the timestamps of all samples would not be within 49 days of each other anymore
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_integral, includes bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, and unsigned long long
+              typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_integral declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Push(size_t const & key_index, T const & value, uint64_t const & timestamp = 0U) {
+        int32_t const integer = static_cast<int32_t>(value);
+        uint32_t bits = 0U;
+        memcpy(&bits, &integer, sizeof(bits));
+        return Push(key_index, Sample_Type::TYPE_INT, bits, timestamp);
+    }
+
+    /// @brief Appends the given floating point sample to the retained batch
+    /// @tparam T Type of the passed value, is required to be a floating point and is stored as a float,
+    /// to ensure this method isn't used instead of the boolean one by mistake
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range, the batch is full or the timestamps of all samples would not be within 49 days of each other anymore
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_floating_point, includes float and double
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Push(size_t const & key_index, T const & value, uint64_t const & timestamp = 0U) {
+        float const real = static_cast<float>(value);
+        uint32_t bits = 0U;
+        memcpy(&bits, &real, sizeof(bits));
+        return Push(key_index, Sample_Type::TYPE_REAL, bits, timestamp);
+    }
+
+    /// @brief Appends the given boolean sample to the retained batch
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range, the batch is full or the timestamps of all samples would not be within 49 days of each other anymore
+    bool Push(size_t const & key_index, bool value, uint64_t const & timestamp = 0U) {
+        return Push(key_index, Sample_Type::TYPE_BOOL, value ? 1U : 0U, timestamp);
+    }
+
+    /// @brief Whether enough samples have been retained, that the next call to @ref Run_Cycle connects to send them
+    /// @return Whether the batch contains atleast the configured batch size of samples
+    bool Is_Cycle_Due() const {
+        return m_batch.count >= m_batch_size;
+    }
+
+    /// @brief Connects, sends all retained samples and disconnects again, if enough samples have been retained or the cycle is forced.
+    /// Otherwise the connection is deferred and nothing is done, so that the device can directly go back to deep sleep
+    /// @note Pipelines the whole sequence, the permanent subscriptions are skipped while connecting and the samples are published as soon as the connection has been established.
+    /// The time from the start of the connection until the disconnect is the radio-on time of this cycle, see @ref Get_Last_Radio_On_Time.
+    /// Expects the network interface (WiFi, cellular, ...) to already be connected, because establishing it is application specific
+    /// @param host Non owning pointer to server instance name the client should connect too, see @ref ThingsBoard::connect
+    /// @param access_token Non owning pointer to access token of the device, see @ref ThingsBoard::connect
+    /// @param port Port that will be used to establish a connection and send / receive data, default = DEFAULT_MQTT_PORT (1883)
+    /// @param connect_timeout_milliseconds Maximum amount of milliseconds to wait for the connection to be established and the published samples to be flushed out of the client,
+    /// required for clients that connect and send asynchronously, default = 10000
+    /// @param force Whether the samples should be sent even if the configured batch size has not been reached yet, for example before a firmware update, default = false
+    /// @return Whether all retained samples have been sent successfully, true if the cycle was deferred
+    bool Run_Cycle(char const * host, char const * access_token, uint16_t const & port = DEFAULT_MQTT_PORT, uint64_t const & connect_timeout_milliseconds = 10000U, bool const & force = false) {
+        if (m_batch.count == 0U || (!force && !Is_Cycle_Due())) {
+            return true;
+        }
+        uint64_t const start = Helper::Get_Uptime_Milliseconds();
+        ITelemetry_Sampler * const previous_sampler = m_thingsboard.Get_Telemetry_Sampler();
+        bool const previous_resubscribe = m_thingsboard.Get_Resubscribe_On_Connect();
+        m_thingsboard.Set_Resubscribe_On_Connect(false);
+        m_thingsboard.Set_Telemetry_Sampler(this);
+
+        bool result = m_thingsboard.connect(host, access_token, port);
+        while (result && !m_thingsboard.connected()) {
+            if (Helper::Get_Uptime_Milliseconds() - start >= connect_timeout_milliseconds) {
+                result = false;
+                break;
+            }
+            (void)m_thingsboard.loop();
+        }
+        if (result) {
+            // Drains the samples, which only marks them as sent, because asynchronous clients might still keep them in their outbox.
+            // They are therefore only removed once the outbox has been flushed, before the connection is closed again
+            (void)m_thingsboard.loop();
+            IMQTT_Client & client = m_thingsboard.Get_Client();
+            while (!client.outbox_empty() && Helper::Get_Uptime_Milliseconds() - start < connect_timeout_milliseconds) {
+                (void)m_thingsboard.loop();
+            }
+            if (client.outbox_empty()) {
+                Remove(m_sent);
+            }
+            result = m_batch.count == 0U;
+        }
+        m_sent = 0U;
+        m_thingsboard.disconnect();
+
+        m_thingsboard.Set_Telemetry_Sampler(previous_sampler);
+        m_thingsboard.Set_Resubscribe_On_Connect(previous_resubscribe);
+        uint64_t const radio_on_time = Helper::Get_Uptime_Milliseconds() - start;
+        m_batch.last_radio_on_time = static_cast<uint32_t>(radio_on_time);
+        m_batch.total_radio_on_time += radio_on_time;
+        m_batch.cycles++;
+        Update_Checksum();
+        return result;
+    }
+
+    /// @brief Returns the amount of milliseconds the radio was on in the last cycle, from the start of the connection until the disconnect
+    /// @return Radio-on time of the last cycle in milliseconds
+    uint32_t Get_Last_Radio_On_Time() const {
+        return m_batch.last_radio_on_time;
+    }
+
+    /// @brief Returns the amount of milliseconds the radio was on in all cycles, since the retained batch was last started empty
+    /// @return Radio-on time of all cycles in milliseconds
+    uint64_t Get_Total_Radio_On_Time() const {
+        return m_batch.total_radio_on_time;
+    }
+
+    /// @brief Returns the amount of executed cycles, since the retained batch was last started empty
+    /// @return Amount of cycles that connected to the server
+    uint32_t Get_Cycles() const {
+        return m_batch.cycles;
+    }
+
+    /// @brief Returns the amount of samples that have been dropped, because the retained batch was full or their timestamp was too far away from the other samples
+    /// @return Amount of lost samples
+    uint16_t Get_Dropped() const {
+        return m_batch.dropped;
+    }
+
+    size_t Available() const override {
+        return m_batch.count - m_sent;
+    }
+
+    size_t Encode_Samples(Telemetry_Encoder & encoder, size_t const & count, size_t const & maximum_size) const override {
+        encoder.Begin_Array();
+        size_t consumed = 0U;
+        while (consumed < count) {
+            Telemetry_Encoder::Checkpoint const checkpoint = encoder.Get_Checkpoint();
+            size_t const group_size = Get_Group_Size(m_sent + consumed, m_sent + count);
+            Retained_Sample const & first = m_batch.samples[m_sent + consumed];
+            bool const has_timestamp = (first.type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP) == 0U;
+
+            encoder.Begin_Object();
+            if (has_timestamp) {
+                (void)encoder.Write_Key(TS_KEY);
+                encoder.Write_Value(static_cast<int64_t>(m_batch.base_timestamp + first.timestamp_offset));
+                (void)encoder.Write_Key(VALUES_KEY);
+                encoder.Begin_Object();
+            }
+            for (size_t index = m_sent + consumed; index < m_sent + consumed + group_size; ++index) {
+                Encode_Sample(encoder, m_batch.samples[index]);
+            }
+            if (has_timestamp) {
+                encoder.End_Object();
+            }
+            encoder.End_Object();
+
+            // The closing bracket of the array and the null termination have to fit as well, if they would not remove the entry again and send it with the next publish instead
+            if (encoder.Get_Length() + 1U >= maximum_size) {
+                encoder.Restore_Checkpoint(checkpoint);
+                break;
+            }
+            consumed += group_size;
+        }
+        encoder.End_Array();
+        return consumed;
+    }
+
+    /// @copydoc ITelemetry_Sampler::Pop
+    /// @note Only marks the samples as sent, they are removed from the retained batch by @ref Run_Cycle once the outbox of the client has been flushed
+    void Pop(size_t const & count) override {
+        size_t const available = Available();
+        m_sent += count < available ? count : available;
+    }
+
+  private:
+    /// @brief Data type that the value of a sample currently holds
+    enum class Sample_Type : uint8_t {
+        TYPE_BOOL, ///< Sample contains a boolean value
+        TYPE_INT, ///< Sample contains an integral value
+        TYPE_REAL ///< Sample contains a real value
+    };
+
+    /// @brief Removes the given amount of samples, starting with the oldest one, from the retained batch and updates the checksum
+    /// @param count Amount of samples that should be removed
+    void Remove(size_t const & count) {
+        size_t const removed = count < m_batch.count ? count : m_batch.count;
+        size_t const remaining = m_batch.count - removed;
+        memmove(m_batch.samples, m_batch.samples + removed, remaining * sizeof(Retained_Sample));
+        m_batch.count = static_cast<uint16_t>(remaining);
+        Update_Checksum();
+    }
+
+    /// @brief Copies the given sample into the retained batch and updates the checksum
+    /// @param key_index Position of the key of the sample
+    /// @param type Data type of the value
+    /// @param value Bits of the value
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds
+    /// @return Whether appending the sample was successful or not
+    bool Push(size_t const & key_index, Sample_Type const & type, uint32_t const & value, uint64_t const & timestamp) {
+        if (key_index >= KeyCount) {
+            return false;
+        }
+        if (m_batch.count == Capacity) {
+            return Drop();
+        }
+        Retained_Sample sample = {};
+        sample.value = value;
+        sample.key_index = static_cast<uint8_t>(key_index);
+        sample.type = static_cast<uint8_t>(type);
+        if (timestamp == 0U) {
+            sample.type |= RETAINED_SAMPLE_WITHOUT_TIMESTAMP;
+        }
+        else if (!Has_Timestamp()) {
+            m_batch.base_timestamp = timestamp;
+        }
+        else if (timestamp < m_batch.base_timestamp) {
+            // Samples are not guaranteed to be pushed in chronological order, an earlier sample therefore becomes the new base timestamp instead
+            if (!Rebase(timestamp)) {
+                return Drop();
+            }
+        }
+        else if (timestamp - m_batch.base_timestamp > UINT32_MAX) {
+            return Drop();
+        }
+        else {
+            sample.timestamp_offset = static_cast<uint32_t>(timestamp - m_batch.base_timestamp);
+        }
+        m_batch.samples[m_batch.count++] = sample;
+        Update_Checksum();
+        return true;
+    }
+
+    /// @brief Counts a sample that could not be retained in the dropped sample statistic and updates the checksum
+    /// @return Always false, to allow returning the result directly from @ref Push
+    bool Drop() {
+        m_batch.dropped++;
+        Update_Checksum();
+        return false;
+    }
+
+    /// @brief Moves the base timestamp back to the given earlier timestamp and increases the offsets of every contained sample with a timestamp by the same amount
+    /// @param timestamp New base timestamp as a UNIX timestamp in milliseconds, has to be earlier than the current base timestamp
+    /// @return Whether the offsets of every contained sample still fit after rebasing, if not nothing is changed
+    bool Rebase(uint64_t const & timestamp) {
+        uint64_t const shift = m_batch.base_timestamp - timestamp;
+        for (size_t index = 0U; index < m_batch.count; ++index) {
+            Retained_Sample const & sample = m_batch.samples[index];
+            if ((sample.type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP) == 0U && shift > UINT32_MAX - sample.timestamp_offset) {
+                return false;
+            }
+        }
+        for (size_t index = 0U; index < m_batch.count; ++index) {
+            Retained_Sample & sample = m_batch.samples[index];
+            if ((sample.type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP) == 0U) {
+                sample.timestamp_offset += static_cast<uint32_t>(shift);
+            }
+        }
+        m_batch.base_timestamp = timestamp;
+        return true;
+    }
+
+    /// @brief Whether any contained sample has a timestamp, meaning the base timestamp is in use
+    /// @return Whether the base timestamp is in use
+    bool Has_Timestamp() const {
+        for (size_t index = 0U; index < m_batch.count; ++index) {
+            if ((m_batch.samples[index].type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP) == 0U) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Whether the retained batch has been initialized for the same keys and capacity and its content is unchanged since it was last written
+    /// @return Whether the retained samples can be used
+    bool Is_Valid() const {
+        return m_batch.magic == RETAINED_BATCH_MAGIC && m_batch.key_count == KeyCount && m_batch.capacity == Capacity
+          && m_batch.count <= Capacity && m_batch.checksum == Calculate_Checksum();
+    }
+
+    /// @brief Starts the retained batch empty, because its previous content was lost
+    void Reset() {
+        m_batch = Retained_Batch<Capacity>();
+        m_batch.magic = RETAINED_BATCH_MAGIC;
+        m_batch.key_count = static_cast<uint16_t>(KeyCount);
+        m_batch.capacity = static_cast<uint16_t>(Capacity);
+        Update_Checksum();
+    }
+
+    /// @brief Calculates the checksum of every field after the checksum itself and all contained samples
+    /// @return CRC32 of the retained batch
+    uint32_t Calculate_Checksum() const {
+        uint8_t const * const fields = reinterpret_cast<uint8_t const *>(&m_batch.base_timestamp);
+        uint8_t const * const samples = reinterpret_cast<uint8_t const *>(m_batch.samples);
+        uint32_t const checksum = Helper::Calculate_CRC32(fields, samples - fields);
+        return Helper::Calculate_CRC32(samples, m_batch.count * sizeof(Retained_Sample), checksum);
+    }
+
+    /// @brief Updates the checksum after the retained batch has been changed
+    void Update_Checksum() {
+        m_batch.checksum = Calculate_Checksum();
+    }
+
+    /// @brief Returns the amount of consecutive samples that have the same timestamp as the sample at the given position and can therefore be merged into the same array entry
+    /// @note A group ends as well once a key would be contained twice, because only the last value of a duplicated json key would be kept by the server
+    /// @param index Position of the first sample of the group
+    /// @param count Position after the last sample that is allowed to be consumed
+    /// @return Amount of samples that are merged into the same array entry
+    size_t Get_Group_Size(size_t const & index, size_t const & count) const {
+        Retained_Sample const & first = m_batch.samples[index];
+        size_t end = index + 1U;
+        while (end < count) {
+            Retained_Sample const & sample = m_batch.samples[end];
+            bool const same_time = sample.timestamp_offset == first.timestamp_offset
+              && (sample.type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP) == (first.type & RETAINED_SAMPLE_WITHOUT_TIMESTAMP);
+            if (!same_time || Contains_Key(index, end, sample.key_index)) {
+                break;
+            }
+            end++;
+        }
+        return end - index;
+    }
+
+    /// @brief Whether any sample in the given range has the given key
+    /// @param first Position of the first sample of the range
+    /// @param last Position after the last sample of the range
+    /// @param key_index Position of the key that should be searched
+    /// @return Whether the key is contained in the given range
+    bool Contains_Key(size_t const & first, size_t const & last, uint8_t const & key_index) const {
+        for (size_t index = first; index < last; ++index) {
+            if (m_batch.samples[index].key_index == key_index) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Writes the given sample as key-value pair into the given encoder
+    /// @param encoder Encoder the key-value pair should be written into
+    /// @param sample Sample that should be written
+    void Encode_Sample(Telemetry_Encoder & encoder, Retained_Sample const & sample) const {
+        if (sample.key_index >= KeyCount || !encoder.Write_Key(m_keys[sample.key_index])) {
+            return;
+        }
+        switch (static_cast<Sample_Type>(sample.type & RETAINED_SAMPLE_TYPE_MASK)) {
+            case Sample_Type::TYPE_BOOL:
+                encoder.Write_Value(sample.value != 0U);
+                break;
+            case Sample_Type::TYPE_INT: {
+                int32_t integer = 0;
+                memcpy(&integer, &sample.value, sizeof(integer));
+                encoder.Write_Value(static_cast<int64_t>(integer));
+                break;
+            }
+            case Sample_Type::TYPE_REAL: {
+                float real = 0.0f;
+                memcpy(&real, &sample.value, sizeof(real));
+                encoder.Write_Value(real);
+                break;
+            }
+            default:
+                encoder.Write_Value(static_cast<char const *>(nullptr));
+                break;
+        }
+    }
+
+    ThingsBoard              & m_thingsboard;        // ThingsBoard instance the samples are sent with
+    Retained_Batch<Capacity> & m_batch;              // Batch in retained memory the samples are appended to
+    char const               *m_keys[KeyCount] = {}; // Key of every key index
+    size_t                   m_batch_size = {};      // Amount of samples that have to be contained before a cycle connects
+    size_t                   m_sent = {};            // Amount of oldest samples that have been published in the current cycle, but are kept until the outbox of the client has been flushed
+};
+
+#endif // Duty_Cycle_h
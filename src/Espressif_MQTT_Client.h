@@ -39,6 +39,8 @@ class Espressif_MQTT_Client : public IMQTT_Client {
 
     ~Espressif_MQTT_Client() override {
         (void)esp_mqtt_client_destroy(m_mqtt_client);
+        delete[] m_fragment_topic;
+        m_fragment_topic = nullptr;
     }
 
     /// @brief Deleted copy constructor
@@ -209,10 +211,16 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         m_enqueue_messages = enqueue_messages;
     }
 
-    void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) override {
+    void set_data_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int>::function callback) override {
         m_received_data_callback.Set_Callback(callback);
     }
 
+    bool set_data_fragment_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int, unsigned int, unsigned int>::function callback) override {
+        m_received_fragment_callback.Set_Callback(callback);
+        m_deliver_fragments = callback != nullptr;
+        return true;
+    }
+
     void set_connect_callback(Callback<void>::function callback) override {
         m_connected_callback.Set_Callback(callback);
     }
@@ -286,6 +294,9 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         return connected();
     }
 
+    /// @copydoc IMQTT_Client::publish
+    /// @note @ref IMQTT_Client::acquire_publish_buffer is deliberately not supported, because the esp mqtt client copies every payload into its own buffer or outbox anyway.
+    /// A permanently allocated publish buffer would therefore double the memory required for sending, without saving any copy compared to the temporary buffer used otherwise
     bool publish(char const * topic, uint8_t const * payload, size_t const & length) override {
         int message_id = MQTT_FAILURE_MESSAGE_ID;
 
@@ -304,6 +315,13 @@ class Espressif_MQTT_Client : public IMQTT_Client {
         return message_id > MQTT_FAILURE_MESSAGE_ID;
     }
 
+    /// @copydoc IMQTT_Client::outbox_empty
+    /// @note Messages published with @ref set_enqueue_messages enabled are stored in the outbox and only sent later from the esp mqtt task,
+    /// with QoS level 0 they are removed from the outbox as soon as they have been written to the connection
+    bool outbox_empty() const override {
+        return m_mqtt_client == nullptr || esp_mqtt_client_get_outbox_size(m_mqtt_client) == 0;
+    }
+
     bool subscribe(char const * topic) override {
         // The esp_mqtt_client_subscribe method does not return false, if we send a subscribe request while not being connected to a broker,
         // so we have to check for that case to ensure the end user is informed that their subscribe request could not be sent and has been ignored.
@@ -445,17 +463,14 @@ private:
                 update_connection_state(MQTT_Connection_State::DISCONNECTED);
                 break;
             case esp_mqtt_event_id_t::MQTT_EVENT_DATA: {
-                // Check wheter the given message has not bee received completly, but instead would be received in multiple chunks,
-                // if it were we discard the message because receiving a message over multiple chunks is currently not supported
+                // Check wheter the given message has not bee received completly, but instead is received in multiple fragments,
+                // if it is we pass every fragment on if that has been requested and discard the message otherwise
                 if (event->data_len != event->total_data_len) {
-                    Logger::printfln(MQTT_DATA_EXCEEDS_BUFFER, event->total_data_len, get_receive_buffer_size());
+                    handle_data_fragment(event);
                     break;
                 }
-                // Topic is not null terminated, to fix this issue we copy the topic string.
-                // This overhead is acceptable, because we nearly always copy only a few bytes (around 20), meaning the overhead is insignificant.
-                char topic[event->topic_len + 1] = {};
-                strncpy(topic, event->topic, event->topic_len);
-                m_received_data_callback.Call_Callback(topic, reinterpret_cast<uint8_t*>(event->data), event->data_len);
+                // Topic is not null terminated, but is passed together with its length, which allows to pass it directly out of the receive buffer without copying it first
+                m_received_data_callback.Call_Callback(event->topic, event->topic_len, reinterpret_cast<uint8_t*>(event->data), event->data_len);
                 break;
             }
             case esp_mqtt_event_id_t::MQTT_EVENT_ERROR: {
@@ -473,6 +488,35 @@ private:
         }
     }
 
+    /// @brief Passes the given fragment of a message that is bigger than the receive buffer to the fragment callback, or discards it if no fragment callback has been set
+    /// @note Only the first fragment of a message contains the topic, therefore it is copied and kept until the last fragment of the message has been received
+    /// @param event Received MQTT_EVENT_DATA event, containing only a part of the message
+    void handle_data_fragment(esp_mqtt_event_handle_t const & event) {
+        if (!m_deliver_fragments) {
+            if (event->current_data_offset == 0) {
+                Logger::printfln(MQTT_DATA_EXCEEDS_BUFFER, event->total_data_len, get_receive_buffer_size());
+            }
+            return;
+        }
+
+        if (event->current_data_offset == 0) {
+            delete[] m_fragment_topic;
+            m_fragment_topic = new char[event->topic_len];
+            m_fragment_topic_length = event->topic_len;
+            (void)memcpy(m_fragment_topic, event->topic, m_fragment_topic_length);
+        }
+        if (m_fragment_topic == nullptr) {
+            return;
+        }
+        m_received_fragment_callback.Call_Callback(m_fragment_topic, m_fragment_topic_length, reinterpret_cast<uint8_t*>(event->data), event->data_len, event->current_data_offset, event->total_data_len);
+
+        if (event->current_data_offset + event->data_len >= event->total_data_len) {
+            delete[] m_fragment_topic;
+            m_fragment_topic = nullptr;
+            m_fragment_topic_length = 0U;
+        }
+    }
+
     static void static_mqtt_event_handler(void * handler_args, esp_event_base_t base, int32_t event_id, void * event_data) {
         if (handler_args == nullptr) {
             return;
@@ -481,14 +525,18 @@ private:
         instance->mqtt_event_handler(base, static_cast<esp_mqtt_event_id_t>(event_id), event_data);
     }
 
-    Callback<void, char *, uint8_t *, unsigned int>              m_received_data_callback = {};            // Callback that will be called as soon as the mqtt client receives any data
-    Callback<void>                                               m_connected_callback = {};                // Callback that will be called as soon as the mqtt client has connected
-    Callback<void, MQTT_Connection_State, MQTT_Connection_Error> m_connection_state_changed_callback = {}; // Callback that will be called as soon as the mqtt client connection changes
-    MQTT_Connection_State                                        m_connection_state = {};                  // Current connection state to the MQTT broker
-    MQTT_Connection_Error                                        m_last_connection_error = {};             // Last error that occured while trying to establish a connection to the MQTT broker
-    bool                                                         m_enqueue_messages = {};                  // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
-    esp_mqtt_client_config_t                                     m_mqtt_configuration = {};                // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
-    esp_mqtt_client_handle_t                                     m_mqtt_client = {};                       // Handle to the underlying mqtt client, used to establish the communication
+    Callback<void, char const *, size_t, uint8_t *, unsigned int>                             m_received_data_callback = {};            // Callback that will be called as soon as the mqtt client receives any data
+    Callback<void, char const *, size_t, uint8_t *, unsigned int, unsigned int, unsigned int> m_received_fragment_callback = {};        // Callback that will be called for every fragment of a message that is bigger than the receive buffer
+    Callback<void>                                                                            m_connected_callback = {};                // Callback that will be called as soon as the mqtt client has connected
+    Callback<void, MQTT_Connection_State, MQTT_Connection_Error>                              m_connection_state_changed_callback = {}; // Callback that will be called as soon as the mqtt client connection changes
+    MQTT_Connection_State                                                                     m_connection_state = {};                  // Current connection state to the MQTT broker
+    MQTT_Connection_Error                                                                     m_last_connection_error = {};             // Last error that occured while trying to establish a connection to the MQTT broker
+    bool                                                                                      m_enqueue_messages = {};                  // Whether we enqueue messages making nearly all ThingsBoard calls non blocking or wheter we publish instead
+    esp_mqtt_client_config_t                                                                  m_mqtt_configuration = {};                // Configuration of the underlying mqtt client, saved as a private variable to allow changes after inital configuration with the same options for all non changed settings
+    esp_mqtt_client_handle_t                                                                  m_mqtt_client = {};                       // Handle to the underlying mqtt client, used to establish the communication
+    bool                                                                                      m_deliver_fragments = {};                 // Whether messages bigger than the receive buffer are passed to the fragment callback instead of being discarded
+    char *                                                                                    m_fragment_topic = {};                    // Copied topic of the message that is currently received in multiple fragments, nullptr if no message is currently received in fragments
+    size_t                                                                                    m_fragment_topic_length = {};             // Amount of characters in the copied topic, which is not null terminated
 };
 
 #endif // THINGSBOARD_USE_ESP_MQTT
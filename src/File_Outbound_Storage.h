@@ -0,0 +1,147 @@
+#ifndef File_Outbound_Storage_h
+#define File_Outbound_Storage_h
+
+// Local include.
+#include "IOutbound_Storage.h"
+#include "DefaultLogger.h"
+#include "Helper.h"
+
+// Library include.
+#include <stdio.h>
+// Synchronize appended bytes to the file system with fsync, as long as the header exists, which is the case on Linux and on Espressif IDF or Arduino ESP32.
+// Otherwise the appended bytes are only flushed, which still passes them to the file system, but might keep them in its cache until the file is closed
+#ifndef THINGSBOARD_HAS_FSYNC
+#  ifdef __has_include
+#    if __has_include(<unistd.h>)
+#      define THINGSBOARD_HAS_FSYNC 1
+#    else
+#      define THINGSBOARD_HAS_FSYNC 0
+#    endif
+#  else
+#    define THINGSBOARD_HAS_FSYNC 0
+#  endif
+#endif
+#if THINGSBOARD_HAS_FSYNC
+#include <unistd.h>
+#endif // THINGSBOARD_HAS_FSYNC
+
+
+// Log messages.
+char constexpr OPEN_SEGMENT_FAILED[] = "Failed to open outbound queue segment (%s.%u), ensure the path is correct and the file system is mounted";
+// Segment file path.
+char constexpr SEGMENT_PATH_FORMAT[] = "%s.%u";
+
+
+/// @brief IOutbound_Storage implementation that uses the c fopen function (https://cplusplus.com/reference/cstdio/fopen/),
+/// under the hood to store every segment in its own file. Works on every system where the file system is accessible with the c file functions,
+/// which is the case on Linux and on Espressif IDF or Arduino ESP32 once a LittleFS, SPIFFS or FAT file system has been mounted over the virtual file system (for example at /littlefs).
+/// Platforms that do not support that, like ESP8266 Arduino with its own LittleFS API, can simply implement the IOutbound_Storage interface themselves instead
+/// @note The file of every segment is opened once on first use and kept open until the segment is erased or this instance is destroyed, because opening a file on LittleFS or SPIFFS is expensive
+/// and draining a single record already requires multiple reads. Appended bytes are flushed and synchronized to the file system directly, so that they still persist if the device loses power
+/// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
+template <typename Logger = DefaultLogger>
+class File_Outbound_Storage : public IOutbound_Storage {
+  public:
+    /// @brief Constructor
+    /// @param base_path Non owning pointer to the path every segment file starts with, the index of the segment is appended to it (/littlefs/outbound --> /littlefs/outbound.0).
+    /// Additionally it has to be kept alive by the user for the lifetime of this instance
+    File_Outbound_Storage(char const * base_path)
+      : m_base_path(base_path)
+      , m_files()
+    {
+        // Nothing to do
+    }
+
+    /// @brief Destructor, closes every segment file that is still open
+    ~File_Outbound_Storage() override {
+        for (uint8_t segment = 0U; segment < OUTBOUND_SEGMENT_COUNT; ++segment) {
+            Close(segment);
+        }
+    }
+
+    /// @brief Deleted copy constructor
+    /// @note Copying would result in two instances owning and closing the same files. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    File_Outbound_Storage(File_Outbound_Storage const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying would result in two instances owning and closing the same files. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(File_Outbound_Storage const & other) = delete;
+
+    size_t size(uint8_t const & segment) override {
+        FILE* file = Open(segment);
+        if (file == nullptr || fseek(file, 0, SEEK_END) != 0) {
+            return 0U;
+        }
+        long const file_size = ftell(file);
+        return file_size > 0 ? static_cast<size_t>(file_size) : 0U;
+    }
+
+    size_t read(uint8_t const & segment, size_t const & offset, uint8_t * data, size_t const & length) override {
+        FILE* file = Open(segment);
+        if (file == nullptr || fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+            return 0U;
+        }
+        return fread(data, 1, length, file);
+    }
+
+    size_t append(uint8_t const & segment, uint8_t const * data, size_t const & length) override {
+        FILE* file = Open(segment);
+        if (file == nullptr) {
+            Logger::printfln(OPEN_SEGMENT_FAILED, m_base_path, segment);
+            return 0U;
+        }
+        // Switching from reading to writing requires a seek inbetween, the append mode writes to the end of the file regardless
+        (void)fseek(file, 0, SEEK_END);
+        auto const bytes_written = fwrite(data, 1, length, file);
+        (void)fflush(file);
+#if THINGSBOARD_HAS_FSYNC
+        (void)fsync(fileno(file));
+#endif // THINGSBOARD_HAS_FSYNC
+        return bytes_written;
+    }
+
+    bool erase(uint8_t const & segment) override {
+        Close(segment);
+        size_t const path_size = Helper::Calculate_Print_Size(SEGMENT_PATH_FORMAT, m_base_path, segment);
+        char path[path_size] = {};
+        (void)snprintf(path, path_size, SEGMENT_PATH_FORMAT, m_base_path, segment);
+        // Removing a file that does not exist fails as well, but in that case the segment is already erased
+        return remove(path) == 0 || size(segment) == 0U;
+    }
+
+  private:
+    /// @brief Returns the open file of the given segment, the file is opened and created if it does not exist yet on first use
+    /// @param segment Index of the segment
+    /// @return Opened file or nullptr if the segment index is invalid or opening failed, is owned by this instance and closed once the segment is erased
+    FILE* Open(uint8_t const & segment) {
+        if (segment >= OUTBOUND_SEGMENT_COUNT) {
+            return nullptr;
+        }
+        else if (m_files[segment] != nullptr) {
+            return m_files[segment];
+        }
+        size_t const path_size = Helper::Calculate_Print_Size(SEGMENT_PATH_FORMAT, m_base_path, segment);
+        char path[path_size] = {};
+        (void)snprintf(path, path_size, SEGMENT_PATH_FORMAT, m_base_path, segment);
+        // Opened for reading and appending, which creates the file if it does not exist yet without truncating an existing one
+        m_files[segment] = fopen(path, "a+b");
+        return m_files[segment];
+    }
+
+    /// @brief Closes the file of the given segment, if it is currently open
+    /// @param segment Index of the segment
+    void Close(uint8_t const & segment) {
+        if (segment >= OUTBOUND_SEGMENT_COUNT || m_files[segment] == nullptr) {
+            return;
+        }
+        (void)fclose(m_files[segment]);
+        m_files[segment] = nullptr;
+    }
+
+    char const * m_base_path = {};                      // Path every segment file starts with
+    FILE         *m_files[OUTBOUND_SEGMENT_COUNT] = {}; // Open file of every segment, nullptr if it has not been opened yet or has been erased
+};
+
+#endif // File_Outbound_Storage_h
@@ -0,0 +1,19 @@
+#ifndef Fixed_Point_h
+#define Fixed_Point_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <stdint.h>
+
+
+/// @brief Integer-scaled fixed-point value, that is sent as a decimal number without requiring any floating point math on the device
+/// @note Allows to directly send values that sensors already measure as scaled integers, for example a temperature in centi-degrees { 2345, 2 } is sent as 23.45.
+/// Especially useful on targets without a floating point unit like the ESP8266, where converting into a float and formatting it would require soft-float emulation
+struct Fixed_Point {
+    int64_t value = {};    // Integer-scaled value, for example 2345 for 23.45
+    uint8_t decimals = {}; // Amount of decimal places the value is scaled by, for example 2 for 23.45
+};
+
+#endif // Fixed_Point_h
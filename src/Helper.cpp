@@ -6,6 +6,13 @@
 #include <algorithm>
 #endif // THINGSBOARD_ENABLE_STL
 #include <string.h>
+#if THINGSBOARD_USE_ESP_TIMER
+#include <esp_timer.h>
+#elif defined(ARDUINO)
+#include <Arduino.h>
+#elif THINGSBOARD_ENABLE_STL
+#include <chrono>
+#endif // THINGSBOARD_USE_ESP_TIMER
 
 size_t Helper::Calculate_Symbol_Occurences(uint8_t const * bytes, char symbol, uint32_t length) {
     size_t count = 0;
@@ -24,10 +31,66 @@ size_t Helper::Calculate_Symbol_Occurences(uint8_t const * bytes, char symbol, u
     return count;
 }
 
+ArduinoJson::Allocator * Helper::Get_Json_Allocator(ArduinoJson::Allocator * allocator) {
+    if (allocator != nullptr) {
+        return allocator;
+    }
+    // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal DefaultAllocator declaration, previously accessible with ARDUINOJSON_NAMESPACE
+    return ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::DefaultAllocator::instance();
+}
+
 bool Helper::String_IsNull_Or_Empty(char const * str) {
     return str == nullptr || str[0] == '\0';
 }
 
-size_t Helper::Split_Topic_Into_Request_ID(char const * received_topic, size_t const & end_position) {
-    return atoi(received_topic + end_position);
+bool Helper::Topic_Starts_With(char const * topic, size_t const & topic_length, char const * prefix, size_t const & prefix_length) {
+    return topic_length >= prefix_length && memcmp(topic, prefix, prefix_length) == 0;
+}
+
+size_t Helper::Split_Topic_Into_Request_ID(char const * received_topic, size_t const & topic_length, size_t const & end_position) {
+    size_t request_id = 0U;
+    for (size_t position = end_position; position < topic_length; ++position) {
+        uint8_t const digit = static_cast<uint8_t>(received_topic[position] - '0');
+        if (digit > 9U) {
+            break;
+        }
+        request_id = request_id * 10U + digit;
+    }
+    return request_id;
+}
+
+uint32_t Helper::Calculate_CRC32(uint8_t const * bytes, size_t const & length, uint32_t const & previous_crc) {
+    // Checksums of every possible nibble for the reflected polynomial 0xEDB88320
+    static uint32_t constexpr CRC32_NIBBLE_TABLE[16U] = {
+        0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+        0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+    };
+    uint32_t crc = ~previous_crc;
+    if (bytes == nullptr) {
+        return ~crc;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        crc = CRC32_NIBBLE_TABLE[(crc ^ bytes[i]) & 0x0FU] ^ (crc >> 4U);
+        crc = CRC32_NIBBLE_TABLE[(crc ^ (bytes[i] >> 4U)) & 0x0FU] ^ (crc >> 4U);
+    }
+    return ~crc;
+}
+
+uint64_t Helper::Get_Uptime_Milliseconds() {
+#if THINGSBOARD_USE_ESP_TIMER
+    return static_cast<uint64_t>(esp_timer_get_time()) / 1000U;
+#elif defined(ARDUINO)
+    static uint32_t previous_milliseconds = 0U;
+    static uint64_t overflowed_milliseconds = 0U;
+    uint32_t const current_milliseconds = millis();
+    if (current_milliseconds < previous_milliseconds) {
+        overflowed_milliseconds += (static_cast<uint64_t>(1U) << 32U);
+    }
+    previous_milliseconds = current_milliseconds;
+    return overflowed_milliseconds + current_milliseconds;
+#elif THINGSBOARD_ENABLE_STL
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    return 0U;
+#endif // THINGSBOARD_USE_ESP_TIMER
 }
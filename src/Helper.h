@@ -50,17 +50,30 @@ class Helper {
     /// @return Wheter the given string is a nullptr or empty
     static bool String_IsNull_Or_Empty(char const * str);
 
+    /// @brief Returns whether the given received topic starts with the given prefix
+    /// @note Received topics are passed together with their length and are not guaranteed to be null terminated,
+    /// therefore the comparison never reads more than the given amount of characters from the received topic
+    /// @param topic Non owning pointer to the received topic, does not need to be null terminated.
+    /// Does not need to be kept alive, because the received topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic
+    /// @param prefix Non owning pointer to the prefix the received topic should start with
+    /// @param prefix_length Amount of characters in the prefix, can simply be the value returned by calling strlen() on a constant prefix, which is already calculated at compile time
+    /// @return Whether the received topic is atleast as long as the prefix and starts with it
+    static bool Topic_Starts_With(char const * topic, size_t const & topic_length, char const * prefix, size_t const & prefix_length);
+
     /// @brief Splits the topic at the given position and extracts the request id parameter from the remaining string
     /// @note Should contain the request id that the original request was sent with. Is used to know which received response is connected to which inital request,
     /// so that the correct request can be informed that a response has been received.
-    /// To achieve this the function removes the not needed part of the received topic string, which is everything before the request id
-    /// and then simply call the atoi function on the remaning topic string.
+    /// To achieve this the function skips the not needed part of the received topic string, which is everything before the request id
+    /// and then parses the following decimal digits, stopping at the first other character or at the end of the received topic.
+    /// Unlike atoi the received topic therefore does not need to be null terminated and is never read past the given length
     /// @param received_topic Non owning pointer to the received topic that contains the base topic as well as the request id parameter (v1/devices/me/rpc/response/$request_id).
     /// Does not need to be kept alive, because the received topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, does not include any null termination
     /// @param end_position Number indicating the amount of characters that have to be incremented to reach the position where the $request_id lies in the received topic.
     /// Most of the time it can simply be the value returned by calling strlen() on the base version of the topic. So for example on (v1/devices/me/rpc/response/) instead of the received topic (v1/devices/me/rpc/response/42)
-    /// @return Converted integral request id if possible or 0 if parsing as an integer failed
-    static size_t Split_Topic_Into_Request_ID(char const * received_topic, size_t const & end_position);
+    /// @return Converted integral request id if possible or 0 if the received topic does not contain any digits at the given position
+    static size_t Split_Topic_Into_Request_ID(char const * received_topic, size_t const & topic_length, size_t const & end_position);
 
     /// @brief Calculates the total size of the string the serializeJson method would produce including the null end terminator.
     /// @note Be aware that null terminator will later not be serialized in the serializeJson method,
@@ -74,6 +87,41 @@ class Helper {
         return measureJson(source) + 1U;
     }
 
+    /// @brief Returns the given allocator or the default ArduinoJson heap allocator if none was given
+    /// @note Constructing a JsonDocument with a nullptr allocator results in a crash as soon as any memory is allocated, which can happen if the allocator is received over a callback,
+    /// that has not been set yet or whose ThingsBoard instance has not been subscribed yet. Every JsonDocument created with a received allocator should therefore use this method
+    /// @param allocator Non owning pointer to the allocator that should be used, nullptr to use the default ArduinoJson heap allocator
+    /// @return Non owning pointer to the given allocator or the default ArduinoJson heap allocator, never nullptr
+    static ArduinoJson::Allocator * Get_Json_Allocator(ArduinoJson::Allocator * allocator);
+
+    /// @brief Calculates the CRC-32 (IEEE 802.3, the same as used by zlib) checksum of the given byte payload
+    /// @note Uses a table with 16 entries and processes the payload one nibble at a time, which is a good trade-off between the required flash memory and the performance.
+    /// The payload can be processed in multiple chunks by passing the result of the previous call as the initial value of the next call
+    /// @param bytes Non owning pointer to the byte payload that we want to calculate the checksum for.
+    /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
+    /// @param length Length of the byte payload
+    /// @param previous_crc Checksum of the previous chunk of the payload, has to be 0 for the first chunk, default = 0
+    /// @return Checksum of the given payload and all previous chunks
+    static uint32_t Calculate_CRC32(uint8_t const * bytes, size_t const & length, uint32_t const & previous_crc = 0U);
+
+    /// @brief Returns the amount of milliseconds that have passed since the device started
+    /// @note Uses the esp timer if it exists, because it already counts in 64 bits and does therefore not overflow.
+    /// Otherwise the Arduino millis() method is used instead, which overflows after roughly 49 days. That overflow is detected and extended to 64 bits,
+    /// as long as this method is called atleast once between two overflows, which is the case as long as any of the internal loop() methods is called regularly
+    /// @return Amount of milliseconds since the device started
+    static uint64_t Get_Uptime_Milliseconds();
+
+    /// @brief Returns whether @ref Get_Uptime_Milliseconds is backed by an actual clock on the current target
+    /// @note Without the esp timer, Arduino or STL support no clock is available and the uptime is always 0, therefore timeouts that rely on it would never expire
+    /// @return Whether the uptime increases over time
+    static constexpr bool Has_Uptime_Clock() {
+#if THINGSBOARD_USE_ESP_TIMER || defined(ARDUINO) || THINGSBOARD_ENABLE_STL
+        return true;
+#else
+        return false;
+#endif // THINGSBOARD_USE_ESP_TIMER || defined(ARDUINO) || THINGSBOARD_ENABLE_STL
+    }
+
     /// @brief Calculates the distance between two iterators
     /// @tparam InputIterator Class that allows for forward incrementable access to data
     /// of the given data container, allows for using / passing either std::vector or std::array.
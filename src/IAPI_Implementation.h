@@ -50,29 +50,96 @@ class IAPI_Implementation {
     /// If the response only wants to be handled after serialization Process_Json_Response should contain the implementation instead and Get_Process_Type should return API_Process_Type::JSON
     /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
     /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
     /// @param payload Non owning pointer to the payload that was sent over the cloud and received over the given topic.
     /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
     /// @param length Total length of the received payload
-    virtual void Process_Response(char const * topic, uint8_t * payload, uint32_t length) = 0;
+    virtual void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) = 0;
+
+    /// @brief Process callback that will be called for every fragment of a response, that is bigger than the receive buffer of the client and is therefore delivered in multiple fragments
+    /// @note Only called for API implementations that return API_Process_Type::RAW and only if the client supports delivering messages in multiple fragments, see @ref IMQTT_Client::set_data_fragment_callback.
+    /// Allows to handle responses of any size without ever holding them in memory completely, fragments are passed in order and the response is complete once the offset plus the length reaches the total length.
+    /// The default implementation does not handle fragments and returns false, which means the response is discarded
+    /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
+    /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
+    /// @param payload Non owning pointer to the fragment of the payload that was sent over the cloud and received over the given topic.
+    /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
+    /// @param length Length of the received fragment
+    /// @param offset Position of the first byte of the fragment in the complete payload
+    /// @param total_length Total length of the complete payload
+    /// @return Whether the fragment has been handled, default = false
+    virtual bool Process_Response_Fragment(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length, uint32_t offset, uint32_t total_length) {
+        return false;
+    }
+
+    /// @brief Sets whether responses that are bigger than the receive buffer of the client are delivered in multiple fragments to @ref Process_Response_Fragment, instead of being discarded
+    /// @note Allows API implementations that handle big responses to keep the receive buffer small, instead of increasing it to the size of the biggest expected response.
+    /// Directly set by the used ThingsBoard client once the API implementation is subscribed. The default implementation ignores the value
+    /// @param fragmented_delivery Whether the client delivers responses bigger than the receive buffer in multiple fragments
+    virtual void Set_Fragmented_Delivery(bool const & fragmented_delivery) {
+        // Nothing to do
+    }
+
+    /// @brief Process callback that will be called upon response arrival, before the payload is deserialized into json
+    /// @note Only called for API implementations that return API_Process_Type::JSON. Allows to handle selected responses with a custom parser instead, for example a streaming parser for very big payloads,
+    /// which removes the memory required for deserializing the complete payload into a JsonDocument. If the response is handled, it is not deserialized at all
+    /// and neither this nor any other API implementation is called with @ref Process_Json_Response for it. The default implementation does not handle any response and returns false
+    /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
+    /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
+    /// @param payload Non owning pointer to the unserialized json payload that was sent over the cloud and received over the given topic.
+    /// Does not need to be kept alive, because the byte payload is only used for the scope of the method itself
+    /// @param length Total length of the received payload
+    /// @return Whether the response has been handled completely and should therefore not be deserialized, default = false
+    virtual bool Process_Raw_Json_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) {
+        return false;
+    }
 
     /// @brief Process callback that will be called upon response arrival
     /// @note Responsible for handling the alredy serialized payload.
     /// If the response only wants to be handled before serialization Process_Response should contain the implementation instead and Get_Process_Type should return API_Process_Type::RAW
     /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
     /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
     /// @param data Payload sent by the server over our given topic, that contains our key value pairs
-    virtual void Process_Json_Response(char const * topic, JsonDocument const & data) = 0;
+    virtual void Process_Json_Response(char const * topic, size_t const & topic_length, JsonDocument const & data) = 0;
+
+    /// @brief Returns the ArduinoJson filter document, that contains every key of the received payload that is actually read in @ref Process_Json_Response
+    /// @note The filter is passed to the deserialization, which skips every key that is not contained in the filter instead of allocating memory for it.
+    /// See https://arduinojson.org/v7/how-to/deserialize-a-very-large-document/ for more information on filtering. The filter is owned by the API implementation and should only be built again once the read keys change,
+    /// for example when callbacks are subscribed, instead of for every received response. Every read key is set to true, nested keys are set to true in a nested object with the name of the parent key.
+    /// The filter has to use its own allocator and never the allocator of the received payload, because it would otherwise count against the maximum response size of @ref ThingsBoard::Set_Max_Response_Size.
+    /// Is only called for API implementations that return API_Process_Type::JSON and match the received topic. The default implementation returns nullptr,
+    /// which means the API implementation requires the complete payload and disables filtering for any response it handles
+    /// @param topic Non owning pointer to the topic the response was received over.
+    /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
+    /// @return Non owning pointer to the filter document, which has to stay valid until the response has been deserialized, or nullptr if the complete payload is required, default = nullptr
+    virtual JsonDocument const * Get_Deserialization_Filter(char const * topic, size_t const & topic_length) {
+        return nullptr;
+    }
 
     /// @brief Compares received response topic and the topic this api implementation handles responses on,
     /// messages from all other topics are ignored and only messages from topics that match are handled
-    /// @note For the comparsion we either compare the full expected string with null termination,
+    /// @note For the comparsion we either compare the full expected string and additionally require the received topic to have the same length,
     /// if the response topic does not include additional parameters, example being shared attribute update (v1/devices/me/attributes).
-    /// Or we compare only before the null termination for topics that include additional parameters in the response.
+    /// Or we compare only the start of the received topic for topics that include additional parameters in the response.
     /// Like for example the original request id in the response of the attribute request (v1/devices/me/attributes/response/1)
     /// @param topic Non owning pointer to the previously subscribed topic, we got the response over.
     /// Does not need to be kept alive, because the topic is only used for the scope of the method itself
+    /// @param topic_length Amount of characters in the received topic, the topic is not guaranteed to be null terminated and should therefore never be read past this length
     /// @return Whether the received response topic matches the topic this api implementation handles responses on
-    virtual bool Is_Response_Topic_Matching(char const * topic) const = 0;
+    virtual bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const = 0;
+
+    /// @brief Returns the constant start of every topic this api implementation handles responses on
+    /// @note Is used to build the sorted routing table, which allows to find the API implementations that might handle a received response without comparing the topic with every single one of them.
+    /// Only API implementations whose prefix matches the received topic are then additionally confirmed with @ref Is_Response_Topic_Matching.
+    /// The default implementation returns nullptr, which means the API implementation is not routed and instead @ref Is_Response_Topic_Matching is called for every received response
+    /// @return Non owning pointer to the response topic prefix, has to be kept alive for the lifetime of the API implementation, default = nullptr
+    virtual char const * Get_Response_Topic_Prefix() const {
+        return nullptr;
+    }
 
     /// @brief Unsubcribes all callbacks, to clear up any ongoing subscriptions and stop receiving information over the previously subscribed topic
     /// @return Whether unsubscribing all the previously subscribed callbacks
@@ -84,6 +151,13 @@ class IAPI_Implementation {
     /// @return Whether resubscribing was successfull or not
     virtual bool Resubscribe_Permanent_Subscriptions() = 0;
 
+    /// @brief Clears up any ongoing single-event subscriptions (Provision, Attribute Request, RPC Request), without resubscribing the topic of any permanent subscription
+    /// @note Called instead of @ref Resubscribe_Permanent_Subscriptions once the connection has been established, if resubscribing has been disabled with @ref ThingsBoard::Set_Resubscribe_On_Connect,
+    /// because single-event subscriptions would never receive an answer over the new connection either way. The default implementation does nothing, because the API has no single-event subscriptions
+    virtual void Clear_Single_Event_Subscriptions() {
+        // Nothing to do
+    }
+
 #if !THINGSBOARD_USE_ESP_TIMER
     /// @brief Internal loop method to update inernal timers for API calls that can timeout
     /// @note Only exists on boards that can not use the ESP Timer, because that one uses the FreeRTOS timer in the background instead
@@ -91,6 +165,13 @@ class IAPI_Implementation {
     virtual void loop() = 0;
 #endif // !THINGSBOARD_USE_ESP_TIMER
 
+    /// @brief Internal method that is called from every @ref ThingsBoard::loop call, independent of the used timer implementation
+    /// @note Allows API implementations to send messages that have been prepared on other tasks, because the underlying client is only ever called from the task calling the loop method.
+    /// The default implementation does nothing
+    virtual void Process_Deferred() {
+        // Nothing to do
+    }
+
     /// @brief Method that allows to construct internal objects, after the required callback member methods have been set already
     /// @note Required for API Implementations that subscribe further API calls, because immediately calling in the constructor can lead,
     /// to attempted subscriptions before the client callbacks are actually subscribed. Therefore we have to call methods like that,
@@ -108,7 +189,8 @@ class IAPI_Implementation {
     /// @param get_send_size_callback Method which allows to get the current underlying send size of the buffer, points to m_client.get_send_buffer_size per default
     /// @param set_buffer_size_callback Method which allows to set the current underlying size of the buffer, points to m_client.set_buffer_size per default
     /// @param get_request_id_callback Method which allows to get the current request id as a mutable reference, points to getRequestID per default
-    virtual void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) = 0;
+    /// @param get_json_allocator_callback Method which allows to get the allocator every JsonDocument that is sent should be created with, points to Get_Json_Allocator per default
+    virtual void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) = 0;
 };
 
 #endif // IAPI_Implementation_h
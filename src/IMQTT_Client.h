@@ -40,11 +40,25 @@ class IMQTT_Client {
     virtual ~IMQTT_Client() {}
 
     /// @brief Sets the callback that is called, if any message is received by the MQTT broker
-    /// @note The callback is called with the topic string that the message was received over,
-    /// as well as the payload data and the size of that payload data. Directly set by the used ThingsBoard client to its internal methods,
+    /// @note The callback is called with the topic string that the message was received over and the amount of characters in that topic,
+    /// as well as the payload data and the size of that payload data. The topic is not guaranteed to be null terminated, which allows implementations to pass the topic directly out of their receive buffer,
+    /// instead of having to copy it into a null terminated string first. Directly set by the used ThingsBoard client to its internal methods,
     /// therefore calling again and overriding as a user ist not recommended, unless you know what you are doing
     /// @param callback Method that should be called on received MQTT response
-    virtual void set_data_callback(Callback<void, char *, uint8_t *, unsigned int>::function callback) = 0;
+    virtual void set_data_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int>::function callback) = 0;
+
+    /// @brief Sets the callback that is called for every fragment of a received message, that is bigger than the receive buffer and is therefore delivered in multiple fragments
+    /// @note Allows to receive messages of any size with a small receive buffer, as long as the consumer can process the message in parts, like the firmware chunks of an OTA update.
+    /// Fragments are delivered in order and the callback is called with the topic of the message for every fragment, even if the underlying client only receives the topic with the first fragment.
+    /// Messages that fit into the receive buffer are still passed completely to the callback set with @ref set_data_callback instead. Directly set by the used ThingsBoard client to its internal methods,
+    /// therefore calling again and overriding as a user ist not recommended, unless you know what you are doing. The default implementation does not support this feature,
+    /// meaning messages bigger than the receive buffer are discarded, and therefore returns false
+    /// @param callback Method that should be called with the topic, the amount of characters in the topic, the fragment, the length of the fragment, the offset of the fragment in the message and the total length of the message.
+    /// The same as for @ref set_data_callback the topic is not guaranteed to be null terminated
+    /// @return Whether the implementation delivers messages bigger than the receive buffer in multiple fragments
+    virtual bool set_data_fragment_callback(Callback<void, char const *, size_t, uint8_t *, unsigned int, unsigned int, unsigned int>::function callback) {
+        return false;
+    }
 
     /// @brief Sets the callback that is called, if we have successfully established a connection with the MQTT broker
     /// @note Directly set by the used ThingsBoard client to its internal method, therefore calling again and overriding as a user ist not recommended, unless you know what you are doing.
@@ -126,6 +140,43 @@ class IMQTT_Client {
     /// @return Whether publishing the payload on the given topic was successful or not
     virtual bool publish(char const * topic, uint8_t const * payload, size_t const & length) = 0;
 
+    /// @brief Acquires exclusive access to a buffer owned by the client, the payload of the next message can then be written directly into that buffer
+    /// @note Allows to serialize a payload exactly once, instead of first measuring it, then serializing it into a temporary copy and then copying that temporary copy again with @ref publish.
+    /// Once the payload has been written, it has to be published with @ref commit_publish_buffer or if writing the payload failed, the buffer has to be given back with @ref release_publish_buffer instead.
+    /// Acquiring fails if the buffer is still in use, because it has not been committed or released yet, for example because another task is currently sending data.
+    /// In that case or if the implementation does not support this feature at all the caller is expected to fall back to @ref publish instead.
+    /// The default implementation does not support this feature and therefore always returns nullptr
+    /// @param available Amount of bytes that can be written into the returned buffer, is set to 0 if acquiring the buffer failed
+    /// @return Non owning pointer to the start of the buffer or nullptr if the buffer is still in use or the feature is not supported
+    virtual uint8_t * acquire_publish_buffer(size_t & available) {
+        available = 0U;
+        return nullptr;
+    }
+
+    /// @brief Sends the given amount of bytes from the start of the buffer previously returned by @ref acquire_publish_buffer over the previously established connection
+    /// @note Gives back the access to the buffer independent of whether publishing was successful or not
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param length Amount of bytes that have been written into the acquired buffer
+    /// @return Whether publishing the payload on the given topic was successful or not
+    virtual bool commit_publish_buffer(char const * topic, size_t const & length) {
+        return false;
+    }
+
+    /// @brief Gives back the access to the buffer previously returned by @ref acquire_publish_buffer, without sending anything
+    virtual void release_publish_buffer() {
+        // Nothing to do
+    }
+
+    /// @brief Whether every message that has been published so far has been written to the connection, meaning none of them is still waiting in an outbox of the client
+    /// @note Required for clients that send asynchronously, where @ref publish returns once the message has been stored in an outbox, but not yet written to the connection.
+    /// Disconnecting before the outbox has been flushed discards the contained messages, therefore data should only be discarded by the caller once this method returns true.
+    /// The default implementation expects @ref publish to write the message directly and therefore always returns true
+    /// @return Whether no published message is still waiting to be sent
+    virtual bool outbox_empty() const {
+        return true;
+    }
+
     /// @brief Subscribes to MQTT message on the given topic, which will cause an internal callback to be called for each message received on that topic from the server,
     /// it should then, call the previously configured callback with set_data_callback() with the received data
     /// @param topic Non owning pointer to topic we want to receive a notification about if messages are sent by the server.
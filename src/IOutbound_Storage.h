@@ -0,0 +1,50 @@
+#ifndef IOutbound_Storage_h
+#define IOutbound_Storage_h
+
+// Local include.
+#include "Configuration.h"
+
+// Library include.
+#include <stddef.h>
+#include <stdint.h>
+
+
+// Amount of segments the outbound queue stores its records in, segment indices are always smaller than this value.
+uint8_t constexpr OUTBOUND_SEGMENT_COUNT = 2U;
+
+
+/// @brief Storage interface that contains the methods a class that can be used to persist messages for the @ref Outbound_Queue has to implement
+/// @note The storage consists of multiple seperate segments, which are only ever appended to, read from or erased as a whole.
+/// This allows to implement the interface on top of nearly every kind of persistent storage, for example files on a LittleFS, SPIFFS or FAT file system or raw flash sectors
+class IOutbound_Storage {
+  public:
+    /// @copydoc Callback::~Callback
+    virtual ~IOutbound_Storage() {}
+
+    /// @brief Returns the amount of bytes currently stored in the given segment
+    /// @param segment Index of the segment
+    /// @return Amount of bytes stored in the given segment, 0 if it does not exist or has been erased
+    virtual size_t size(uint8_t const & segment) = 0;
+
+    /// @brief Reads the given amount of bytes starting at the given offset from the given segment
+    /// @param segment Index of the segment
+    /// @param offset Amount of bytes from the start of the segment the read should start at
+    /// @param data Buffer the read bytes should be copied into, has to be atleast length bytes big
+    /// @param length Amount of bytes that should be read
+    /// @return Amount of bytes that were successfully read
+    virtual size_t read(uint8_t const & segment, size_t const & offset, uint8_t * data, size_t const & length) = 0;
+
+    /// @brief Appends the given bytes to the end of the given segment, creates the segment if it does not exist yet
+    /// @param segment Index of the segment
+    /// @param data Bytes that should be appended
+    /// @param length Amount of bytes that should be appended
+    /// @return Amount of bytes that were successfully appended
+    virtual size_t append(uint8_t const & segment, uint8_t const * data, size_t const & length) = 0;
+
+    /// @brief Erases the complete content of the given segment
+    /// @param segment Index of the segment
+    /// @return Whether erasing was successful or not, also successful if the segment did not exist
+    virtual bool erase(uint8_t const & segment) = 0;
+};
+
+#endif // IOutbound_Storage_h
@@ -0,0 +1,49 @@
+#ifndef IRPC_Response_Queue_h
+#define IRPC_Response_Queue_h
+
+// Local include.
+#include "Callback.h"
+#include "RPC_Response_Handle.h"
+
+// Library include.
+#include <stddef.h>
+
+
+/// @brief Response queue interface that contains the methods a class has to implement, so that server-side RPC requests can be completed later on from any task
+/// and their responses are sent in the @ref ThingsBoard::loop method, see @ref Deferred_RPC_Callback for more information
+/// @note Decouples the task that handles the request from the task that receives it, the request only reserves an entry in the queue and the subscribed callback returns immediately,
+/// while the response is written into the reserved entry once it is known and sent later on the task that calls @ref ThingsBoard::loop.
+/// Only the complete methods are called from the task handling the request and the reserve method from the task receiving it, which is the esp-mqtt task when using the Espressif_MQTT_Client.
+/// All other methods are only called from the task calling @ref ThingsBoard::loop
+class IRPC_Response_Queue {
+  public:
+    /// @copydoc Callback::~Callback
+    virtual ~IRPC_Response_Queue() {}
+
+    /// @brief Reserves an entry for the received request, which is later completed with the response over the created handle
+    /// @param request_id Id the request was received with and the response has to be sent with
+    /// @param timeout_milliseconds Amount of milliseconds after which an error response is sent instead, if the request has not been completed until then, 0 means the request never times out
+    /// @param handle Handle that is set to the reserved entry
+    /// @return Whether reserving an entry was successful, fails if every entry is already reserved
+    virtual bool Reserve(size_t const & request_id, uint64_t const & timeout_milliseconds, RPC_Response_Handle & handle) = 0;
+
+    /// @brief Serializes the given response into the given reserved entry, see @ref RPC_Response_Handle::Complete
+    /// @param slot Position of the reserved entry
+    /// @param ticket Unique number the entry has been reserved with
+    /// @param response Response that should be sent to the server, if it is null no response is sent and the entry is simply freed
+    /// @return Whether the response has been written into the entry
+    virtual bool Complete(size_t const & slot, uint32_t const & ticket, JsonDocument const & response) = 0;
+
+    /// @brief Copies the given serialized json response into the given reserved entry, see @ref RPC_Response_Handle::Complete
+    /// @param slot Position of the reserved entry
+    /// @param ticket Unique number the entry has been reserved with
+    /// @param json Non owning pointer to the serialized json response
+    /// @return Whether the response has been written into the entry
+    virtual bool Complete(size_t const & slot, uint32_t const & ticket, char const * json) = 0;
+
+    /// @brief Sends the responses of every completed entry and an error response for every entry that has timed out, entries are freed once their response has been sent
+    /// @param send_json_string_callback Callback that sends the given json string over the given topic, entries where sending failed are kept and sent again with the next call instead
+    virtual void Send_Completed(Callback<bool, char const * const, char const * const> const & send_json_string_callback) = 0;
+};
+
+#endif // IRPC_Response_Queue_h
@@ -0,0 +1,38 @@
+#ifndef ITelemetry_Sampler_h
+#define ITelemetry_Sampler_h
+
+// Local include.
+#include "Configuration.h"
+#include "Telemetry_Encoder.h"
+
+// Library include.
+#include <stddef.h>
+
+
+/// @brief Sampler interface that contains the methods a class has to implement, so that its buffered samples can be drained and sent in the @ref ThingsBoard::loop method
+/// @note Decouples the code that produces samples from the code that sends them, the producer only has to append the sample to the buffer of the sampler,
+/// while the time consuming serialization and network handling is done later on the task that calls @ref ThingsBoard::loop.
+/// All methods of this interface are only called from that consuming task
+class ITelemetry_Sampler {
+  public:
+    /// @copydoc Callback::~Callback
+    virtual ~ITelemetry_Sampler() {}
+
+    /// @brief Returns the amount of samples that have been completely written by the producer and can therefore be consumed
+    /// @return Amount of samples that can be consumed
+    virtual size_t Available() const = 0;
+
+    /// @brief Writes atmost the given amount of samples, starting with the oldest one, as a json array into the given encoder, as fit into the given maximum size
+    /// @note Does not remove the written samples, because the encoder might be called multiple times for the same payload, see @ref ThingsBoard::Send_Encoded_Json
+    /// @param encoder Encoder the json array should be written into
+    /// @param count Maximum amount of samples that should be written, has to be smaller or equal to the amount returned by @ref Available
+    /// @param maximum_size Maximum size the written json array is allowed to have, including the null termination
+    /// @return Amount of samples that have been written into the json array
+    virtual size_t Encode_Samples(Telemetry_Encoder & encoder, size_t const & count, size_t const & maximum_size) const = 0;
+
+    /// @brief Removes the given amount of samples, starting with the oldest one, which allows the producer to reuse their space
+    /// @param count Amount of samples that should be removed, has to be smaller or equal to the amount returned by @ref Available
+    virtual void Pop(size_t const & count) = 0;
+};
+
+#endif // ITelemetry_Sampler_h
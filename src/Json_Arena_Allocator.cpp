@@ -0,0 +1,202 @@
+// Header include.
+#include "Json_Arena_Allocator.h"
+
+// Library includes.
+#include <stdlib.h>
+#include <string.h>
+
+// Every allocation is aligned to the strictest fundamental alignment, because ArduinoJson places doubles, 64 bit integers and pointers into the handed out memory
+size_t constexpr ARENA_ALIGNMENT = alignof(max_align_t);
+// Every allocation is preceded by its requested size, padded so that the handed out memory is still aligned
+size_t constexpr ARENA_HEADER_SIZE = ((sizeof(size_t) + ARENA_ALIGNMENT - 1U) / ARENA_ALIGNMENT) * ARENA_ALIGNMENT;
+
+/// @brief Rounds the given size up to the next multiple of the arena alignment
+/// @param size Size that should be rounded up
+/// @return Aligned size
+static size_t Align_Size(size_t const & size) {
+    return ((size + ARENA_ALIGNMENT - 1U) / ARENA_ALIGNMENT) * ARENA_ALIGNMENT;
+}
+
+Json_Arena_Allocator::Json_Arena_Allocator(size_t const & capacity)
+  : m_buffer(nullptr)
+  , m_capacity(0U)
+  , m_requested_capacity(capacity)
+  , m_offset(0U)
+  , m_required_size(0U)
+  , m_peak_size(0U)
+  , m_allocations(0U)
+  , m_buffer_failed(false)
+#if THINGSBOARD_USE_ESP_MQTT
+  , m_mutex(xSemaphoreCreateMutex())
+#endif // THINGSBOARD_USE_ESP_MQTT
+{
+    Apply_Capacity();
+}
+
+Json_Arena_Allocator::~Json_Arena_Allocator() {
+    delete[] m_buffer;
+    m_buffer = nullptr;
+#if THINGSBOARD_USE_ESP_MQTT
+    vSemaphoreDelete(m_mutex);
+#endif // THINGSBOARD_USE_ESP_MQTT
+}
+
+void Json_Arena_Allocator::Set_Capacity(size_t const & capacity) {
+    Lock();
+    m_requested_capacity = capacity;
+    if (m_allocations == 0U) {
+        Apply_Capacity();
+    }
+    Unlock();
+}
+
+size_t const & Json_Arena_Allocator::Get_Capacity() const {
+    return m_capacity;
+}
+
+size_t const & Json_Arena_Allocator::Get_Required_Size() const {
+    return m_required_size;
+}
+
+size_t const & Json_Arena_Allocator::Get_Peak_Size() const {
+    return m_peak_size;
+}
+
+void * Json_Arena_Allocator::allocate(size_t size) {
+    Lock();
+    void * pointer = Allocate_Locked(size);
+    Unlock();
+    return pointer;
+}
+
+void Json_Arena_Allocator::deallocate(void * pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    Lock();
+    if (m_buffer == nullptr) {
+        free(pointer);
+    }
+    // Memory of any allocation besides the most recent one is only reclaimed once the buffer is reset
+    else if (Is_Last_Allocation(pointer)) {
+        m_offset = static_cast<uint8_t *>(pointer) - m_buffer - ARENA_HEADER_SIZE;
+    }
+    Release_Allocation();
+    Unlock();
+}
+
+void * Json_Arena_Allocator::reallocate(void * pointer, size_t new_size) {
+    if (pointer == nullptr) {
+        return allocate(new_size);
+    }
+    Lock();
+    void * new_pointer = nullptr;
+    if (m_buffer == nullptr) {
+        new_pointer = realloc(pointer, new_size);
+    }
+    // The most recent allocation can simply be shrunk or grown in place, which is the common case while ArduinoJson builds a string or shrinks its pools
+    else if (Is_Last_Allocation(pointer)) {
+        size_t const start = static_cast<uint8_t *>(pointer) - m_buffer;
+        size_t const required_size = start + Align_Size(new_size);
+        if (required_size > m_capacity) {
+            m_required_size = required_size;
+        }
+        else {
+            memcpy(m_buffer + start - ARENA_HEADER_SIZE, &new_size, sizeof(new_size));
+            m_offset = required_size;
+            m_peak_size = m_offset > m_peak_size ? m_offset : m_peak_size;
+            new_pointer = pointer;
+        }
+    }
+    else {
+        size_t const size = Get_Allocation_Size(pointer);
+        new_pointer = Allocate_Locked(new_size);
+        if (new_pointer != nullptr) {
+            memcpy(new_pointer, pointer, size < new_size ? size : new_size);
+            // The previous allocation has been replaced, its memory is reclaimed once the buffer is reset
+            Release_Allocation();
+        }
+    }
+    Unlock();
+    return new_pointer;
+}
+
+void * Json_Arena_Allocator::Allocate_Locked(size_t const & size) {
+    // Retried once nothing is handed out anymore, because the heap might have enough contiguous memory again
+    if (m_buffer_failed && m_allocations == 0U) {
+        Apply_Capacity();
+    }
+    if (m_buffer_failed) {
+        m_required_size = size;
+        return nullptr;
+    }
+    else if (m_buffer == nullptr) {
+        void * pointer = malloc(size);
+        m_allocations += (pointer != nullptr) ? 1U : 0U;
+        return pointer;
+    }
+    size_t const required_size = m_offset + ARENA_HEADER_SIZE + Align_Size(size);
+    if (required_size > m_capacity) {
+        m_required_size = required_size;
+        return nullptr;
+    }
+    uint8_t * header = m_buffer + m_offset;
+    memcpy(header, &size, sizeof(size));
+    m_offset = required_size;
+    m_peak_size = m_offset > m_peak_size ? m_offset : m_peak_size;
+    m_allocations++;
+    return header + ARENA_HEADER_SIZE;
+}
+
+void Json_Arena_Allocator::Apply_Capacity() {
+    if (m_requested_capacity == m_capacity && !m_buffer_failed) {
+        return;
+    }
+    delete[] m_buffer;
+    m_buffer = nullptr;
+    m_capacity = 0U;
+    m_offset = 0U;
+    m_buffer_failed = false;
+    if (m_requested_capacity == 0U) {
+        return;
+    }
+    m_buffer = new uint8_t[m_requested_capacity];
+    if (m_buffer != nullptr) {
+        m_capacity = m_requested_capacity;
+    }
+    else {
+        m_buffer_failed = true;
+    }
+}
+
+void Json_Arena_Allocator::Release_Allocation() {
+    m_allocations = (m_allocations > 0U) ? m_allocations - 1U : 0U;
+    if (m_allocations != 0U) {
+        return;
+    }
+    m_offset = 0U;
+    Apply_Capacity();
+}
+
+size_t Json_Arena_Allocator::Get_Allocation_Size(void const * pointer) const {
+    size_t size = 0U;
+    memcpy(&size, static_cast<uint8_t const *>(pointer) - ARENA_HEADER_SIZE, sizeof(size));
+    return size;
+}
+
+bool Json_Arena_Allocator::Is_Last_Allocation(void const * pointer) const {
+    size_t const start = static_cast<uint8_t const *>(pointer) - m_buffer;
+    return start + Align_Size(Get_Allocation_Size(pointer)) == m_offset;
+}
+
+void Json_Arena_Allocator::Lock() {
+#if THINGSBOARD_USE_ESP_MQTT
+    (void)xSemaphoreTake(m_mutex, portMAX_DELAY);
+#endif // THINGSBOARD_USE_ESP_MQTT
+}
+
+void Json_Arena_Allocator::Unlock() {
+#if THINGSBOARD_USE_ESP_MQTT
+    (void)xSemaphoreGive(m_mutex);
+#endif // THINGSBOARD_USE_ESP_MQTT
+}
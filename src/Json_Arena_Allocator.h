@@ -0,0 +1,112 @@
+#ifndef Json_Arena_Allocator_h
+#define Json_Arena_Allocator_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+#if THINGSBOARD_USE_ESP_MQTT
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif // THINGSBOARD_USE_ESP_MQTT
+
+
+/// @brief ArduinoJson allocator, that hands out the memory of JsonDocument instances from a single buffer, which is allocated once and reused for every message.
+/// See https://arduinojson.org/v7/api/jsondocument/constructor/ for more information on custom allocators
+/// @note Memory is handed out by simply increasing an offset into the buffer (bump allocation) and the complete buffer is reset once every handed out allocation has been freed again,
+/// which is the case as soon as every JsonDocument using this allocator has been destroyed. This removes every heap allocation and deallocation from the processing of messages,
+/// prevents fragmenting the heap and results in a deterministic upper bound for the memory used per message.
+/// Once the buffer is exhausted every further allocation fails instead of falling back to the heap, which causes the deserialization to fail with DeserializationError::NoMemory or the JsonDocument to overflow.
+/// Only the most recent allocation can be freed or resized in place, all other freed memory is reclaimed once the buffer is reset. If the capacity is 0 the allocator instead directly forwards to the heap without any limit.
+/// JsonDocument that are created while others still use the allocator, for example because a message is sent from inside of a subscribed callback, simply share the remaining memory.
+/// If the buffer itself can not be allocated, every allocation fails as well instead of falling back to the heap, so that the configured upper bound is never exceeded. Allocating the buffer is retried once no allocation is handed out anymore.
+/// With the Espressif MQTT client received messages are processed on the task of the MQTT client, while messages are sent from the application task at the same time,
+/// therefore every access to the buffer is guarded by a mutex on those targets. On all other targets the allocator has to be used from a single task, which is the case for the Arduino MQTT client
+class Json_Arena_Allocator : public ArduinoJson::Allocator {
+  public:
+    /// @brief Constructor
+    /// @param capacity Amount of bytes the buffer can hold, 0 means allocations are forwarded to the heap instead, default = 0
+    explicit Json_Arena_Allocator(size_t const & capacity = 0U);
+
+    /// @brief Destructor
+    ~Json_Arena_Allocator();
+
+    /// @brief Deleted copy constructor
+    /// @note Copying would result in two instances owning and freeing the same buffer. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Json_Arena_Allocator(Json_Arena_Allocator const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying would result in two instances owning and freeing the same buffer. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Json_Arena_Allocator const & other) = delete;
+
+    /// @brief Sets the amount of bytes the buffer can hold
+    /// @note The buffer is reallocated directly if no memory is currently handed out, otherwise once every handed out allocation has been freed.
+    /// Ensures memory that is still used by a JsonDocument is never freed
+    /// @param capacity Amount of bytes the buffer can hold, 0 means allocations are forwarded to the heap instead
+    void Set_Capacity(size_t const & capacity);
+
+    /// @brief Returns the amount of bytes the buffer can hold
+    /// @return Amount of bytes the buffer can hold, 0 if allocations are forwarded to the heap instead
+    size_t const & Get_Capacity() const;
+
+    /// @brief Returns the amount of bytes the last failed allocation would have required in total, allows to inform the user how much the capacity would need to be increased
+    /// @return Amount of bytes that would have been used in total, if the last failed allocation would have been successful
+    size_t const & Get_Required_Size() const;
+
+    /// @brief Returns the highest amount of bytes that has ever been used at once, allows to find the smallest capacity that is still big enough for all sent or received messages
+    /// @return Highest amount of bytes used at once, including the internal bookkeeping of every allocation, always 0 if allocations are forwarded to the heap
+    size_t const & Get_Peak_Size() const;
+
+    void * allocate(size_t size) override;
+
+    void deallocate(void * pointer) override;
+
+    void * reallocate(void * pointer, size_t new_size) override;
+
+  private:
+    /// @brief Allocates the buffer with the requested capacity, if it differs from the current one
+    void Apply_Capacity();
+
+    /// @brief Allocates the given amount of bytes, expects the mutex to be taken already
+    /// @param size Amount of bytes that should be allocated
+    /// @return Non owning pointer to the allocated memory or nullptr if the buffer is exhausted
+    void * Allocate_Locked(size_t const & size);
+
+    /// @brief Takes the mutex guarding the buffer, does nothing on targets where the allocator is only used from a single task
+    void Lock();
+
+    /// @brief Gives back the mutex guarding the buffer, does nothing on targets where the allocator is only used from a single task
+    void Unlock();
+
+    /// @brief Marks one allocation as freed and resets the buffer once no allocation is handed out anymore
+    void Release_Allocation();
+
+    /// @brief Returns the amount of bytes that was requested for the given allocation, which is kept in front of the handed out memory
+    /// @param pointer Non owning pointer to memory previously handed out by this allocator
+    /// @return Requested amount of bytes
+    size_t Get_Allocation_Size(void const * pointer) const;
+
+    /// @brief Whether the given allocation is the most recent one, which allows to free or resize it in place
+    /// @param pointer Non owning pointer to memory previously handed out by this allocator
+    /// @return Whether the given allocation ends at the current offset
+    bool Is_Last_Allocation(void const * pointer) const;
+
+    uint8_t *m_buffer = {};             // Buffer all memory is handed out from, nullptr if allocations are forwarded to the heap
+    size_t  m_capacity = {};            // Amount of bytes the buffer can hold
+    size_t  m_requested_capacity = {};  // Amount of bytes the buffer should hold, applied once no allocation is handed out
+    size_t  m_offset = {};              // Amount of bytes that have been handed out since the last reset
+    size_t  m_required_size = {};       // Amount of bytes the last failed allocation would have required in total
+    size_t  m_peak_size = {};           // Highest amount of bytes that has ever been used at once
+    size_t  m_allocations = {};         // Amount of allocations that are currently handed out and have not been freed yet
+    bool    m_buffer_failed = {};       // Whether allocating the buffer with the requested capacity failed, every allocation fails instead of being forwarded to the heap
+#if THINGSBOARD_USE_ESP_MQTT
+    SemaphoreHandle_t m_mutex = {};     // Mutex guarding the buffer, because messages are received and sent from different tasks
+#endif // THINGSBOARD_USE_ESP_MQTT
+};
+
+#endif // Json_Arena_Allocator_h
@@ -0,0 +1,327 @@
+// Header include.
+#include "Number_Formatter.h"
+
+// Library includes.
+#include <string.h>
+
+// Binary layout of IEEE 754 floating points.
+uint8_t constexpr DOUBLE_SIGNIFICAND_BITS = 52U;
+uint32_t constexpr DOUBLE_EXPONENT_MASK = 0x7FFU;
+int32_t constexpr DOUBLE_EXPONENT_BIAS = 1023;
+uint8_t constexpr FLOAT_SIGNIFICAND_BITS = 23U;
+uint32_t constexpr FLOAT_EXPONENT_MASK = 0xFFU;
+int32_t constexpr FLOAT_EXPONENT_BIAS = 127;
+// Shortest representation.
+uint8_t constexpr MAX_SHORTEST_DIGITS = 20U;
+int32_t constexpr MAX_PLAIN_INTEGRAL_DIGITS = 21;
+int32_t constexpr MIN_PLAIN_DECIMAL_POINT = -6;
+int32_t constexpr MIN_TARGET_EXPONENT = -61;
+int64_t constexpr LOG10_2_FIXED_POINT = 1292913987; // log10(2) * 2^32, allows to calculate the decimal exponent with integer math
+uint8_t constexpr FIXED_POINT_FRACTION_BITS = 32U;
+// Cached powers of ten from 10^-348 to 10^340 in steps of 8, normalized to a 64 bit significand, which covers the complete range of double.
+int32_t constexpr CACHED_POWER_MIN_DECIMAL_EXPONENT = -348;
+int32_t constexpr CACHED_POWER_DECIMAL_EXPONENT_STEP = 8;
+int32_t constexpr CACHED_POWER_INDEX_OFFSET = 347;
+uint64_t constexpr CACHED_POWER_SIGNIFICANDS[] = {
+    0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL, 0xCF42894A5DCE35EAULL,
+    0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL, 0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL,
+    0xBE5691EF416BD60CULL, 0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+    0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL, 0xC21094364DFB5637ULL,
+    0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL, 0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL,
+    0xB23867FB2A35B28EULL, 0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+    0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL, 0xB5B5ADA8AAFF80B8ULL,
+    0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL, 0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL,
+    0xA6DFBD9FB8E5B88FULL, 0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+    0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL, 0xAA242499697392D3ULL,
+    0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL, 0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL,
+    0x9C40000000000000ULL, 0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+    0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL, 0x9F4F2726179A2245ULL,
+    0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL, 0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL,
+    0x924D692CA61BE758ULL, 0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+    0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL, 0x952AB45CFA97A0B3ULL,
+    0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL, 0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL,
+    0x88FCF317F22241E2ULL, 0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+    0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL, 0x8BAB8EEFB6409C1AULL,
+    0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL, 0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL,
+    0x80444B5E7AA7CF85ULL, 0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+    0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL,
+};
+int16_t constexpr CACHED_POWER_EXPONENTS[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+    -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+    -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+    481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+uint64_t constexpr POWERS_OF_TEN[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+size_t constexpr POWERS_OF_TEN_COUNT = sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]);
+// Decimal formatting.
+double constexpr MAX_SCALED_DECIMAL_VALUE = 9.2e18;
+
+size_t Number_Formatter::Format_Shortest(double const & value, char * buffer) {
+    if (sizeof(double) == sizeof(float)) {
+        // Some targets like the AVR implement double as a 32 bit float, in that case the float precision is the actual precision of the value
+        return Format_Shortest(static_cast<float>(value), buffer);
+    }
+    uint64_t bits = 0U;
+    memcpy(&bits, &value, sizeof(value));
+    uint32_t const biased_exponent = static_cast<uint32_t>(bits >> DOUBLE_SIGNIFICAND_BITS) & DOUBLE_EXPONENT_MASK;
+    if (biased_exponent == DOUBLE_EXPONENT_MASK) {
+        return 0U;
+    }
+    uint64_t const hidden_bit = static_cast<uint64_t>(1U) << DOUBLE_SIGNIFICAND_BITS;
+    uint64_t significand = bits & (hidden_bit - 1U);
+    // Subnormal values do not have the hidden bit set and use the smallest possible exponent
+    int32_t exponent = 1 - DOUBLE_EXPONENT_BIAS - DOUBLE_SIGNIFICAND_BITS;
+    if (biased_exponent != 0U) {
+        significand |= hidden_bit;
+        exponent = static_cast<int32_t>(biased_exponent) - DOUBLE_EXPONENT_BIAS - DOUBLE_SIGNIFICAND_BITS;
+    }
+    return Format_Binary((bits >> 63U) != 0U, significand, exponent, significand == hidden_bit, buffer);
+}
+
+size_t Number_Formatter::Format_Shortest(float const & value, char * buffer) {
+    static_assert(sizeof(float) == sizeof(uint32_t), "Float has to be a 32 bit IEEE 754 floating point");
+    uint32_t bits = 0U;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t const biased_exponent = (bits >> FLOAT_SIGNIFICAND_BITS) & FLOAT_EXPONENT_MASK;
+    if (biased_exponent == FLOAT_EXPONENT_MASK) {
+        return 0U;
+    }
+    uint32_t const hidden_bit = static_cast<uint32_t>(1U) << FLOAT_SIGNIFICAND_BITS;
+    uint32_t significand = bits & (hidden_bit - 1U);
+    // Subnormal values do not have the hidden bit set and use the smallest possible exponent
+    int32_t exponent = 1 - FLOAT_EXPONENT_BIAS - FLOAT_SIGNIFICAND_BITS;
+    if (biased_exponent != 0U) {
+        significand |= hidden_bit;
+        exponent = static_cast<int32_t>(biased_exponent) - FLOAT_EXPONENT_BIAS - FLOAT_SIGNIFICAND_BITS;
+    }
+    return Format_Binary((bits >> 31U) != 0U, significand, exponent, significand == hidden_bit, buffer);
+}
+
+size_t Number_Formatter::Format_Decimals(double const & value, uint8_t decimals, char * buffer) {
+    if (decimals > MAX_FORMATTED_DECIMALS) {
+        decimals = MAX_FORMATTED_DECIMALS;
+    }
+    double const scaled = value * static_cast<double>(POWERS_OF_TEN[decimals]);
+    // Inverted comparison, so that NaN fails the check as well and is handled by the shortest formatting instead
+    if (!(scaled > -MAX_SCALED_DECIMAL_VALUE && scaled < MAX_SCALED_DECIMAL_VALUE)) {
+        return Format_Shortest(value, buffer);
+    }
+    // Round half away from zero, the same as printf would do
+    int64_t const rounded = static_cast<int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    return Format_Fixed_Point(rounded, decimals, buffer);
+}
+
+size_t Number_Formatter::Format_Fixed_Point(int64_t const & value, uint8_t decimals, char * buffer) {
+    if (decimals > MAX_FORMATTED_DECIMALS) {
+        decimals = MAX_FORMATTED_DECIMALS;
+    }
+    size_t length = 0U;
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (value < 0) {
+        buffer[length++] = '-';
+        // Negate in the unsigned domain, because negating the smallest possible signed value would overflow
+        magnitude = 0U - magnitude;
+    }
+    uint64_t const divisor = POWERS_OF_TEN[decimals];
+    length += Write_Unsigned(magnitude / divisor, buffer + length);
+    uint64_t fraction = magnitude % divisor;
+    if (fraction == 0U) {
+        return length;
+    }
+
+    // Trailing zeros do not change the value and are therefore removed to keep the payload as small as possible
+    while (fraction % 10U == 0U) {
+        fraction /= 10U;
+        decimals--;
+    }
+    buffer[length++] = '.';
+    // Digits are written from the back, so that the leading zeros of the fraction are kept
+    for (size_t position = decimals; position-- > 0U;) {
+        buffer[length + position] = static_cast<char>('0' + (fraction % 10U));
+        fraction /= 10U;
+    }
+    return length + decimals;
+}
+
+size_t Number_Formatter::Format_Binary(bool const & negative, uint64_t const & significand, int32_t const & exponent, bool const & lower_boundary_closer, char * buffer) {
+    // Zero can not be normalized and is always written without sign, because -0 is the same json number
+    if (significand == 0U) {
+        buffer[0U] = '0';
+        return 1U;
+    }
+    size_t length = 0U;
+    if (negative) {
+        buffer[length++] = '-';
+    }
+
+    // Boundaries halfway to the next bigger and smaller representable value, every number in between reads back as the same binary value
+    Extended_Float const upper = Normalize({(significand << 1U) + 1U, exponent - 1});
+    Extended_Float lower = lower_boundary_closer ? Extended_Float{(significand << 2U) - 1U, exponent - 2} : Extended_Float{(significand << 1U) - 1U, exponent - 1};
+    lower.significand <<= lower.exponent - upper.exponent;
+    lower.exponent = upper.exponent;
+
+    int32_t decimal_exponent = 0;
+    Extended_Float const cached_power = Get_Cached_Power(upper.exponent, decimal_exponent);
+    Extended_Float const scaled_value = Multiply(Normalize({significand, exponent}), cached_power);
+    Extended_Float scaled_upper = Multiply(upper, cached_power);
+    Extended_Float scaled_lower = Multiply(lower, cached_power);
+    // Shrink the boundaries by one unit, to account for the rounding error of the multiplications and therefore never leave the exact boundaries
+    scaled_lower.significand++;
+    scaled_upper.significand--;
+
+    char digits[MAX_SHORTEST_DIGITS] = {};
+    uint8_t digit_count = 0U;
+    Generate_Digits(scaled_value, scaled_upper, scaled_upper.significand - scaled_lower.significand, digits, digit_count, decimal_exponent);
+    return length + Write_Digits(digits, digit_count, static_cast<int32_t>(digit_count) + decimal_exponent, buffer + length);
+}
+
+void Number_Formatter::Generate_Digits(Extended_Float const & value, Extended_Float const & upper, uint64_t delta, char * digits, uint8_t & length, int32_t & decimal_exponent) {
+    // Split the upper boundary into its integral and fractional part, the cached power ensures the integral part always fits into 32 bits
+    uint8_t const shift = static_cast<uint8_t>(-upper.exponent);
+    uint64_t const one = static_cast<uint64_t>(1U) << shift;
+    uint64_t const distance = upper.significand - value.significand;
+    uint32_t integral = static_cast<uint32_t>(upper.significand >> shift);
+    uint64_t fraction = upper.significand & (one - 1U);
+
+    int32_t kappa = 0;
+    while (kappa < 10 && integral >= POWERS_OF_TEN[kappa]) {
+        kappa++;
+    }
+    length = 0U;
+    while (kappa > 0) {
+        uint32_t const weight = static_cast<uint32_t>(POWERS_OF_TEN[kappa - 1]);
+        uint8_t const digit = static_cast<uint8_t>(integral / weight);
+        integral %= weight;
+        if (digit != 0U || length != 0U) {
+            digits[length++] = static_cast<char>('0' + digit);
+        }
+        kappa--;
+        uint64_t const rest = (static_cast<uint64_t>(integral) << shift) + fraction;
+        // Stop as soon as the remaining digits would lie within the boundaries anyway
+        if (rest <= delta) {
+            decimal_exponent += kappa;
+            Round_Digit(digits, length, delta, rest, POWERS_OF_TEN[kappa] << shift, distance);
+            return;
+        }
+    }
+
+    while (true) {
+        fraction *= 10U;
+        delta *= 10U;
+        uint8_t const digit = static_cast<uint8_t>(fraction >> shift);
+        if (digit != 0U || length != 0U) {
+            digits[length++] = static_cast<char>('0' + digit);
+        }
+        fraction &= one - 1U;
+        kappa--;
+        if (fraction < delta) {
+            decimal_exponent += kappa;
+            size_t const index = static_cast<size_t>(-kappa);
+            Round_Digit(digits, length, delta, fraction, one, index < POWERS_OF_TEN_COUNT ? distance * POWERS_OF_TEN[index] : 0U);
+            return;
+        }
+    }
+}
+
+void Number_Formatter::Round_Digit(char * digits, uint8_t const & length, uint64_t const & delta, uint64_t rest, uint64_t const & ten_kappa, uint64_t const & distance) {
+    while (rest < distance && delta - rest >= ten_kappa && (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance)) {
+        digits[length - 1U]--;
+        rest += ten_kappa;
+    }
+}
+
+size_t Number_Formatter::Write_Digits(char const * digits, uint8_t const & length, int32_t const & point, char * buffer) {
+    int32_t const digit_count = static_cast<int32_t>(length);
+    // Integral value, missing digits up to the decimal point are filled with zeros (1234e3 --> 1234000)
+    if (point >= digit_count && point <= MAX_PLAIN_INTEGRAL_DIGITS) {
+        memcpy(buffer, digits, length);
+        memset(buffer + length, '0', point - digit_count);
+        return static_cast<size_t>(point);
+    }
+    // Decimal point within the digits (1234e-2 --> 12.34)
+    if (point > 0 && point <= MAX_PLAIN_INTEGRAL_DIGITS) {
+        memcpy(buffer, digits, point);
+        buffer[point] = '.';
+        memcpy(buffer + point + 1U, digits + point, digit_count - point);
+        return length + 1U;
+    }
+    // Decimal point in front of the digits, missing digits after it are filled with zeros (1234e-6 --> 0.001234)
+    if (point > MIN_PLAIN_DECIMAL_POINT && point <= 0) {
+        size_t const leading_zeros = static_cast<size_t>(-point);
+        buffer[0U] = '0';
+        buffer[1U] = '.';
+        memset(buffer + 2U, '0', leading_zeros);
+        memcpy(buffer + 2U + leading_zeros, digits, length);
+        return 2U + leading_zeros + length;
+    }
+
+    // Exponential notation for very big or small values (1234e-12 --> 1.234e-9)
+    size_t position = 0U;
+    buffer[position++] = digits[0U];
+    if (length > 1U) {
+        buffer[position++] = '.';
+        memcpy(buffer + position, digits + 1U, length - 1U);
+        position += length - 1U;
+    }
+    buffer[position++] = 'e';
+    int32_t exponent = point - 1;
+    if (exponent < 0) {
+        buffer[position++] = '-';
+        exponent = -exponent;
+    }
+    return position + Write_Unsigned(static_cast<uint64_t>(exponent), buffer + position);
+}
+
+size_t Number_Formatter::Write_Unsigned(uint64_t value, char * buffer) {
+    // Biggest possible 64 bit value has 20 decimal digits, the digits are written from the back because that is the order they are calculated in
+    char digits[20U] = {};
+    size_t position = sizeof(digits);
+    do {
+        digits[--position] = static_cast<char>('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+    size_t const length = sizeof(digits) - position;
+    memcpy(buffer, digits + position, length);
+    return length;
+}
+
+Number_Formatter::Extended_Float Number_Formatter::Normalize(Extended_Float value) {
+    while ((value.significand & (static_cast<uint64_t>(1U) << 63U)) == 0U) {
+        value.significand <<= 1U;
+        value.exponent--;
+    }
+    return value;
+}
+
+Number_Formatter::Extended_Float Number_Formatter::Multiply(Extended_Float const & lhs, Extended_Float const & rhs) {
+    // Schoolbook multiplication of the 32 bit halves, because not every target supports 128 bit integers
+    uint64_t constexpr lower_half_mask = 0xFFFFFFFFU;
+    uint64_t const a = lhs.significand >> 32U;
+    uint64_t const b = lhs.significand & lower_half_mask;
+    uint64_t const c = rhs.significand >> 32U;
+    uint64_t const d = rhs.significand & lower_half_mask;
+    uint64_t const ac = a * c;
+    uint64_t const bc = b * c;
+    uint64_t const ad = a * d;
+    uint64_t const bd = b * d;
+    uint64_t middle = (bd >> 32U) + (ad & lower_half_mask) + (bc & lower_half_mask);
+    // Round the discarded lower 64 bits to nearest
+    middle += static_cast<uint64_t>(1U) << 31U;
+    return { ac + (ad >> 32U) + (bc >> 32U) + (middle >> 32U), lhs.exponent + rhs.exponent + 64 };
+}
+
+Number_Formatter::Extended_Float Number_Formatter::Get_Cached_Power(int32_t const & exponent, int32_t & decimal_exponent) {
+    // Smallest decimal exponent that scales the value into the target range, ceil((MIN_TARGET_EXPONENT - exponent) * log10(2)) calculated in 32.32 fixed-point, instead of with floating point math
+    int64_t const scaled = static_cast<int64_t>(MIN_TARGET_EXPONENT - exponent) * LOG10_2_FIXED_POINT;
+    int32_t const k = static_cast<int32_t>((scaled + ((static_cast<int64_t>(1) << FIXED_POINT_FRACTION_BITS) - 1)) >> FIXED_POINT_FRACTION_BITS) + CACHED_POWER_INDEX_OFFSET;
+    size_t const index = static_cast<size_t>((k >> 3) + 1);
+    decimal_exponent = -(CACHED_POWER_MIN_DECIMAL_EXPONENT + static_cast<int32_t>(index) * CACHED_POWER_DECIMAL_EXPONENT_STEP);
+    return { CACHED_POWER_SIGNIFICANDS[index], CACHED_POWER_EXPONENTS[index] };
+}
@@ -0,0 +1,121 @@
+#ifndef Number_Formatter_h
+#define Number_Formatter_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Maximum amount of characters any of the formatting methods writes, without null termination
+size_t constexpr MAX_FORMATTED_NUMBER_LENGTH = 32U;
+/// @brief Maximum amount of decimal places supported by the decimal and fixed-point formatting, because 10^19 is the biggest power of ten that still fits into 64 bits
+uint8_t constexpr MAX_FORMATTED_DECIMALS = 19U;
+
+
+/// @brief Static helper class that formats numbers as json text without relying on printf or the formatting of ArduinoJson
+/// @note Floating points are formatted with the shortest decimal representation that still reads back as the exact same binary value (Grisu2 by Florian Loitsch, see https://doi.org/10.1145/1806596.1806623),
+/// which only requires a handful of 64 bit integer multiplications instead of the repeated soft-float divisions the previous formatting required on targets without a floating point unit like the ESP8266.
+/// Because the shortest representation depends on the precision of the binary value, floats are formatted with the precision of a float ("23.45") instead of the precision of the double they were converted into ("23.450000762939453").
+/// Integer-scaled fixed-point values (centi-degrees as 2345 with 2 decimals --> "23.45") are formatted with integer math only.
+/// The methods write into a caller provided buffer of atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes and never null terminate it
+class Number_Formatter {
+  public:
+    /// @brief Formats the given double with the shortest representation that reads back as the same double
+    /// @note Switches to the exponential notation for values with more than 21 integral digits or less than -6 leading zeros, the same as JavaScript would do
+    /// @param value Value that should be formatted
+    /// @param buffer Buffer the formatted value is written into, has to be atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes big
+    /// @return Amount of written characters, 0 if the value is NaN or infinity, because they can not be represented as json numbers
+    static size_t Format_Shortest(double const & value, char * buffer);
+
+    /// @brief Formats the given float with the shortest representation that reads back as the same float
+    /// @param value Value that should be formatted
+    /// @param buffer Buffer the formatted value is written into, has to be atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes big
+    /// @return Amount of written characters, 0 if the value is NaN or infinity, because they can not be represented as json numbers
+    static size_t Format_Shortest(float const & value, char * buffer);
+
+    /// @brief Formats the given double rounded to the given amount of decimal places, trailing zeros are removed because they do not change the value
+    /// @note Falls back to @ref Format_Shortest if the scaled value does not fit into 64 bits
+    /// @param value Value that should be formatted
+    /// @param decimals Maximum amount of decimal places, is limited to @ref MAX_FORMATTED_DECIMALS
+    /// @param buffer Buffer the formatted value is written into, has to be atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes big
+    /// @return Amount of written characters, 0 if the value is NaN or infinity, because they can not be represented as json numbers
+    static size_t Format_Decimals(double const & value, uint8_t decimals, char * buffer);
+
+    /// @brief Formats the given integer-scaled fixed-point value with the given amount of decimal places, without any floating point math
+    /// @note Trailing zeros are removed because they do not change the value (2350 with 2 decimals --> "23.5")
+    /// @param value Integer-scaled value, for example centi-degrees
+    /// @param decimals Amount of decimal places the value is scaled by, is limited to @ref MAX_FORMATTED_DECIMALS
+    /// @param buffer Buffer the formatted value is written into, has to be atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes big
+    /// @return Amount of written characters
+    static size_t Format_Fixed_Point(int64_t const & value, uint8_t decimals, char * buffer);
+
+  private:
+    /// @brief Unnormalized floating point with a 64 bit significand, value = significand * 2^exponent
+    struct Extended_Float {
+        uint64_t significand = {}; // Significand of the value
+        int32_t  exponent = {};    // Binary exponent of the value
+    };
+
+    /// @brief Formats the given binary floating point with the shortest representation that lies within the rounding boundaries of its precision
+    /// @param negative Whether the value is negative
+    /// @param significand Significand of the value including the hidden bit, 0 is formatted as "0"
+    /// @param exponent Binary exponent of the value
+    /// @param lower_boundary_closer Whether the next smaller representable value is closer than the next bigger one, which is the case for powers of two
+    /// @param buffer Buffer the formatted value is written into
+    /// @return Amount of written characters
+    static size_t Format_Binary(bool const & negative, uint64_t const & significand, int32_t const & exponent, bool const & lower_boundary_closer, char * buffer);
+
+    /// @brief Generates the shortest digits of the given scaled value, whose first digits have to lie within the scaled boundaries
+    /// @param value Scaled value
+    /// @param upper Scaled upper boundary
+    /// @param delta Distance between the scaled lower and upper boundary
+    /// @param digits Buffer the digits are written into
+    /// @param length Amount of generated digits
+    /// @param decimal_exponent Decimal exponent of the cached power, is adjusted so that the value is digits * 10^decimal_exponent afterwards
+    static void Generate_Digits(Extended_Float const & value, Extended_Float const & upper, uint64_t delta, char * digits, uint8_t & length, int32_t & decimal_exponent);
+
+    /// @brief Rounds the last generated digit down while the result is still within the boundaries and closer to the scaled value
+    /// @param digits Generated digits
+    /// @param length Amount of generated digits
+    /// @param delta Distance between the scaled lower and upper boundary
+    /// @param rest Remaining distance between the generated digits and the upper boundary
+    /// @param ten_kappa Weight of the last generated digit
+    /// @param distance Distance between the scaled value and the upper boundary
+    static void Round_Digit(char * digits, uint8_t const & length, uint64_t const & delta, uint64_t rest, uint64_t const & ten_kappa, uint64_t const & distance);
+
+    /// @brief Writes the given digits with the decimal point at the given position, or in exponential notation if that position is too far outside of the digits
+    /// @param digits Generated digits
+    /// @param length Amount of generated digits
+    /// @param point Position of the decimal point relative to the first digit
+    /// @param buffer Buffer the formatted value is written into
+    /// @return Amount of written characters
+    static size_t Write_Digits(char const * digits, uint8_t const & length, int32_t const & point, char * buffer);
+
+    /// @brief Writes the given unsigned integral as decimal digits
+    /// @param value Value that should be written
+    /// @param buffer Buffer the digits are written into
+    /// @return Amount of written characters
+    static size_t Write_Unsigned(uint64_t value, char * buffer);
+
+    /// @brief Shifts the given value to the left until its highest bit is set
+    /// @param value Value that should be normalized, is not allowed to be 0
+    /// @return Normalized value
+    static Extended_Float Normalize(Extended_Float value);
+
+    /// @brief Multiplies the given values and rounds the result to the upper 64 bits of the significand
+    /// @param lhs First value
+    /// @param rhs Second value
+    /// @return Product of both values
+    static Extended_Float Multiply(Extended_Float const & lhs, Extended_Float const & rhs);
+
+    /// @brief Returns the cached power of ten, that scales a value with the given binary exponent into the range the digits can be generated in with 64 bit integers
+    /// @param exponent Binary exponent of the normalized upper boundary
+    /// @param decimal_exponent Negated decimal exponent of the returned power of ten
+    /// @return Normalized power of ten
+    static Extended_Float Get_Cached_Power(int32_t const & exponent, int32_t & decimal_exponent);
+};
+
+#endif // Number_Formatter_h
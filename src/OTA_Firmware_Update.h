@@ -12,6 +12,7 @@ uint8_t constexpr MAX_FW_TOPIC_SIZE = 33U;
 uint8_t constexpr OTA_ATTRIBUTE_KEYS_AMOUNT = 5U;
 char constexpr NO_FW_REQUEST_RESPONSE[] = "Did not receive requested shared attribute firmware keys. Ensure keys exist and device is connected";
 // Firmware topics.
+char constexpr FIRMWARE_RESPONSE_BASE_TOPIC[] = "v2/fw/response/";
 char constexpr FIRMWARE_RESPONSE_TOPIC[] = "v2/fw/response/%u/chunk/";
 char constexpr FIRMWARE_REQUEST_TOPIC[] = "v2/fw/request/%u/chunk/%u";
 // Firmware data keys.
@@ -73,15 +74,18 @@ class OTA_Firmware_Update : public IAPI_Implementation {
       , m_get_send_size_callback()
       , m_set_buffer_size_callback()
       , m_get_request_id_callback()
+      , m_get_json_allocator_callback()
       , m_fw_callback()
       , m_previous_buffer_size(0U)
       , m_changed_buffer_size(false)
+      , m_fragmented_delivery(false)
 #if THINGSBOARD_ENABLE_STL
       , m_ota(std::bind(&OTA_Firmware_Update::Publish_Chunk_Request, this, std::placeholders::_1, std::placeholders::_2), std::bind(&OTA_Firmware_Update::Firmware_Send_State, this, std::placeholders::_1, std::placeholders::_2), std::bind(&OTA_Firmware_Update::Firmware_OTA_Unsubscribe, this))
 #else
       , m_ota(OTA_Firmware_Update::staticPublishChunk, OTA_Firmware_Update::staticFirmwareSend, OTA_Firmware_Update::staticUnsubscribe)
 #endif // THINGSBOARD_ENABLE_STL
       , m_response_topic()
+      , m_response_topic_length(0U)
       , m_fw_attribute_update()
       , m_fw_attribute_request()
     {
@@ -89,6 +93,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         // It just has to be set to an actual value that is not an empty string, because that would make the internal callback receive all other responses from the server as well,
         // even if they are not meant for this class and we are not currently updating the device
         (void)snprintf(m_response_topic, sizeof(m_response_topic), FIRMWARE_RESPONSE_TOPIC, 0U);
+        m_response_topic_length = strlen(m_response_topic);
 #if !THINGSBOARD_ENABLE_STL
         m_subscribedInstance = nullptr;
 #endif // !THINGSBOARD_ENABLE_STL
@@ -162,18 +167,31 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         return API_Process_Type::RAW;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
-        auto const & request_id = m_fw_callback.Get_Request_ID();
-        auto const chunk = Helper::Split_Topic_Into_Request_ID(topic, Helper::Calculate_Print_Size(FIRMWARE_RESPONSE_TOPIC, request_id));
+    void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
+        auto const chunk = Helper::Split_Topic_Into_Request_ID(topic, topic_length, m_response_topic_length);
         m_ota.Process_Firmware_Packet(chunk, payload, length);
     }
 
-    void Process_Json_Response(char const * topic, JsonVariantConst data) override {
+    bool Process_Response_Fragment(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length, uint32_t offset, uint32_t total_length) override {
+        auto const chunk = Helper::Split_Topic_Into_Request_ID(topic, topic_length, m_response_topic_length);
+        m_ota.Process_Firmware_Fragment(chunk, payload, length, offset, total_length);
+        return true;
+    }
+
+    void Set_Fragmented_Delivery(bool const & fragmented_delivery) override {
+        m_fragmented_delivery = fragmented_delivery;
+    }
+
+    void Process_Json_Response(char const * topic, size_t const & topic_length, JsonVariantConst data) override {
         // Nothing to do
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(m_response_topic, topic, strlen(m_response_topic)) == 0;
+    bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+        return Helper::Topic_Starts_With(topic, topic_length, m_response_topic, m_response_topic_length);
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return FIRMWARE_RESPONSE_BASE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -196,7 +214,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_subscribe_api_callback.Call_Callback(m_fw_attribute_request);
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
         m_subscribe_api_callback.Set_Callback(subscribe_api_callback);
         m_send_json_callback.Set_Callback(send_json_callback);
         m_send_json_string_callback.Set_Callback(send_json_string_callback);
@@ -206,6 +224,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_get_send_size_callback.Set_Callback(get_send_size_callback);
         m_set_buffer_size_callback.Set_Callback(set_buffer_size_callback);
         m_get_request_id_callback.Set_Callback(get_request_id_callback);
+        m_get_json_allocator_callback.Set_Callback(get_json_allocator_callback);
     }
 
   private:
@@ -215,7 +234,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     /// @param current_fw_version Current device firmware version
     /// @return Whether sending the current device firmware information was successful or not
     bool Firmware_Send_Info(char const * current_fw_title, char const * current_fw_version) {
-        JsonDocument current_firmware_info;
+        JsonDocument current_firmware_info(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
         current_firmware_info[CURR_FW_TITLE_KEY] = current_fw_title;
         current_firmware_info[CURR_FW_VER_KEY] = current_fw_version;
         return m_send_json_callback.Call_Callback(TELEMETRY_TOPIC, current_firmware_info);
@@ -228,7 +247,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     /// simply do not enter a value and the default value will be used which overwrites the firmware error messages, default = ""
     /// @return Whether sending the current firmware download state was successful or not
     bool Firmware_Send_State(char const * current_fw_state, char const * fw_error = "") {
-        JsonDocument current_firmware_state;
+        JsonDocument current_firmware_state(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
         current_firmware_state[FW_ERROR_KEY] = fw_error;
         current_firmware_state[FW_STATE_KEY] = current_fw_state;
         return m_send_json_callback.Call_Callback(TELEMETRY_TOPIC, current_firmware_state);
@@ -259,6 +278,7 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         m_fw_callback = callback;
         m_fw_callback.Set_Request_ID(++request_id);
         (void)snprintf(m_response_topic, sizeof(m_response_topic), FIRMWARE_RESPONSE_TOPIC, request_id);
+        m_response_topic_length = strlen(m_response_topic);
         return true;
     }
 
@@ -387,8 +407,9 @@ class OTA_Firmware_Update : public IAPI_Implementation {
         const uint16_t& chunk_size = m_fw_callback.Get_Chunk_Size();
 
         // Get the previous buffer size and cache it so the previous settings can be restored after the update has finished.
+        // If the client delivers chunks bigger than the receive buffer in fragments, they are written directly as they are received and the buffer does not have to be increased at all
         m_previous_buffer_size = m_get_receive_size_callback.Call_Callback();
-        m_changed_buffer_size = m_previous_buffer_size < (chunk_size + 50U);
+        m_changed_buffer_size = !m_fragmented_delivery && m_previous_buffer_size < (chunk_size + 50U);
 
         // Increase size of receive buffer according to the actual chunk size required for the OTA update to work correctly.
         if (m_changed_buffer_size && !m_set_buffer_size_callback.Call_Callback(chunk_size + 50U, m_get_send_size_callback.Call_Callback())) {
@@ -449,12 +470,15 @@ class OTA_Firmware_Update : public IAPI_Implementation {
     Callback<uint16_t>                                       m_get_send_size_callback = {};            // Get client send buffer size callback
     Callback<bool, uint16_t, uint16_t>                       m_set_buffer_size_callback = {};          // Set client buffer size callback
     Callback<size_t *>                                       m_get_request_id_callback = {};           // Get internal request id callback
+    Callback<ArduinoJson::Allocator *>                       m_get_json_allocator_callback = {};       // Get send json allocator callback
 
     OTA_Update_Callback                                      m_fw_callback = {};                       // OTA update response callback
     uint16_t                                                 m_previous_buffer_size = {};              // Previous buffer size of the underlying client, used to revert to the previously configured buffer size if it was temporarily increased by the OTA update
     bool                                                     m_changed_buffer_size = {};               // Whether the buffer size had to be changed, because the previous internal buffer size was to small to hold the firmware chunks
+    bool                                                     m_fragmented_delivery = {};               // Whether the client delivers firmware chunks bigger than the receive buffer in fragments, which removes the need to increase the buffer size
     OTA_Handler<Logger>                                      m_ota = {};                               // Class instance that handles the flashing and creating a hash from the given received binary firmware data
     char                                                     m_response_topic[MAX_FW_TOPIC_SIZE] = {}; // Firmware response topic that contains the specific request ID of the firmware we actually want to download
+    size_t                                                   m_response_topic_length = {};             // Amount of characters in the firmware response topic, the chunk index of a received response starts directly afterwards
     Update_Callback_Container                                m_fw_attribute_update = {};               // API implementation to be informed if needed fw attributes have been updated
     Request_Callback_Container                               m_fw_attribute_request = {};              // API implementation to request the needed fw attributes to start updating
 };
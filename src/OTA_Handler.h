@@ -64,6 +64,7 @@ class OTA_Handler {
       , m_hash()
       , m_total_chunks(0U)
       , m_requested_chunks(0U)
+      , m_received_bytes(0U)
       , m_retries(0U)
     {
 #if !THINGSBOARD_ENABLE_STL
@@ -114,40 +115,69 @@ class OTA_Handler {
     /// Does not need to be kept alive, because the formatting message is only used for the scope of the method itself
     /// @param total_bytes Amount of bytes in the current firmware packet data
     void Process_Firmware_Packet(size_t const & current_chunk, uint8_t * payload, size_t const & total_bytes)  {
+        Process_Firmware_Fragment(current_chunk, payload, total_bytes, 0U, total_bytes);
+    }
+
+    /// @brief Called for every fragment of the chunk response, if the client delivers responses bigger than its receive buffer in multiple fragments, see @ref IMQTT_Client::set_data_fragment_callback
+    /// @note Every fragment is directly written with the given @ref IUpdater implementation and into the hash function, therefore the chunk never has to be held in memory completely,
+    /// which allows to use chunk sizes that are far bigger than the receive buffer of the client. The size of the chunk is validated with the first fragment
+    /// and the next chunk is only requested once the last fragment has been written. Fragments are expected in order, fragments that do not continue the currently received chunk are ignored.
+    /// If processing fails after parts of the chunk have already been written, the complete update is restarted, because the written data can not be removed from the hash anymore
+    /// @param current_chunk Index of the chunk we recieved the binary data for
+    /// @param payload Non owning pointer to the fragment of the firmware packet data of the current chunk.
+    /// Does not need to be kept alive, because the formatting message is only used for the scope of the method itself
+    /// @param length Amount of bytes in the current fragment
+    /// @param offset Position of the first byte of the fragment in the current firmware packet data
+    /// @param total_bytes Amount of bytes in the complete current firmware packet data
+    void Process_Firmware_Fragment(size_t const & current_chunk, uint8_t * payload, size_t const & length, size_t const & offset, size_t const & total_bytes)  {
         if (current_chunk != m_requested_chunks) {
-            Logger::printfln(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks);
+            // Only logged once per chunk, instead of once for every fragment of the unexpected chunk
+            if (offset == 0U) {
+                Logger::printfln(RECEIVED_UNEXPECTED_CHUNK, current_chunk, m_requested_chunks);
+            }
             return;
         }
-        size_t expected_chunk_size = 0U;
-        if (!Received_Valid_Chunk_Size(total_bytes, expected_chunk_size)) {
-            Logger::printfln(RECEIVED_UNEXPECTED_CHUNK_SIZE, expected_chunk_size, total_bytes);
+        else if (offset != m_received_bytes) {
             return;
         }
 
-        auto & request_timeout = m_fw_callback->Get_Request_Timeout();
-        request_timeout.Stop_Timeout_Timer();
+        auto fw_updater = m_fw_callback->Get_Updater();
+        if (offset == 0U) {
+            size_t expected_chunk_size = 0U;
+            if (!Received_Valid_Chunk_Size(total_bytes, expected_chunk_size)) {
+                Logger::printfln(RECEIVED_UNEXPECTED_CHUNK_SIZE, expected_chunk_size, total_bytes);
+                return;
+            }
     #if THINGSBOARD_ENABLE_DEBUG
-        Logger::printfln(FW_CHUNK, current_chunk, total_bytes);
+            Logger::printfln(FW_CHUNK, current_chunk, total_bytes);
     #endif // THINGSBOARD_ENABLE_DEBUG
 
-        auto fw_updater = m_fw_callback->Get_Updater();
-        if (current_chunk == 0U && !fw_updater->begin(m_fw_size)) {
-            Logger::printfln(ERROR_UPDATE_BEGIN);
-            return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
+            if (current_chunk == 0U && !fw_updater->begin(m_fw_size)) {
+                Logger::printfln(ERROR_UPDATE_BEGIN);
+                return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, ERROR_UPDATE_BEGIN);
+            }
         }
 
-        auto const written_bytes = fw_updater->write(payload, total_bytes);
-        if (written_bytes != total_bytes) {
-            char message[Helper::Calculate_Print_Size(ERROR_UPDATE_WRITE, written_bytes, total_bytes)] = {};
-            (void)snprintf(message, sizeof(message), ERROR_UPDATE_WRITE, written_bytes, total_bytes);
+        auto const written_bytes = fw_updater->write(payload, length);
+        if (written_bytes != length) {
+            char message[Helper::Calculate_Print_Size(ERROR_UPDATE_WRITE, written_bytes, length)] = {};
+            (void)snprintf(message, sizeof(message), ERROR_UPDATE_WRITE, written_bytes, length);
             Logger::printfln(message);
             return Handle_Failure(OTA_Failure_Response::RETRY_UPDATE, message);
         }
 
         // Update hash value only if writing with updater implementation was a success, result is ignored,
         // because it can only fail if the input parameters are invalid
-        (void)m_hash.update(payload, total_bytes);
+        (void)m_hash.update(payload, length);
+
+        m_received_bytes += length;
+        if (m_received_bytes < total_bytes) {
+            return;
+        }
 
+        auto & request_timeout = m_fw_callback->Get_Request_Timeout();
+        request_timeout.Stop_Timeout_Timer();
+        m_received_bytes = 0U;
         m_requested_chunks = current_chunk + 1;
         m_fw_callback->Call_Progress_Callback(m_requested_chunks, m_total_chunks);
 
@@ -197,6 +227,7 @@ class OTA_Handler {
     /// @brief Restarts or starts the firmware update and its needed components and then requests the first firmware chunk
     void Request_First_Firmware_Packet()  {
         m_requested_chunks = 0U;
+        m_received_bytes = 0U;
         Reset_Retries();
         // Hash start result is ignored, because it can only fail if the input parameters are invalid
         (void)m_hash.start(m_fw_checksum_algorithm);
@@ -216,6 +247,8 @@ class OTA_Handler {
             return;
         }
 
+        // Fragments of a previous response to the same chunk are ignored, because the chunk is received again from the start
+        m_received_bytes = 0U;
         if (!m_publish_callback.Call_Callback(m_fw_callback->Get_Request_ID(), m_requested_chunks)) {
             Logger::printfln(UNABLE_TO_REQUEST_CHUNCKS);
         }
@@ -309,7 +342,8 @@ class OTA_Handler {
         char message[Helper::Calculate_Print_Size(CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout)] = {};
         (void)snprintf(message, sizeof(message), CHUNK_REQUEST_TIMED_OUT, m_requested_chunks, timeout);
         Logger::printfln(message);
-        Handle_Failure(OTA_Failure_Response::RETRY_CHUNK, message);
+        // Parts of a chunk that was received in fragments have already been written and hashed, therefore only requesting the same chunk again would write them twice
+        Handle_Failure(m_received_bytes == 0U ? OTA_Failure_Response::RETRY_CHUNK : OTA_Failure_Response::RETRY_UPDATE, message);
     }
 
 #if !THINGSBOARD_ENABLE_STL
@@ -333,6 +367,7 @@ class OTA_Handler {
     HashGenerator                                          m_hash = {};                              // Class instance that allows to generate a hash from received firmware binary data
     size_t                                                 m_total_chunks = {};                      // Total amount of chunks that need to be received to get the complete firmware binary
     size_t                                                 m_requested_chunks = {};                  // Amount of successfully requested and received firmware binary chunks
+    size_t                                                 m_received_bytes = {};                    // Amount of bytes of the currently requested chunk, that have already been received in previous fragments
     uint8_t                                                m_retries = {};                           // Amount of request retries we attempt for each chunk, increasing makes the connection more stable
 };
 
@@ -0,0 +1,302 @@
+// Header include.
+#include "Outbound_Queue.h"
+
+// Local includes.
+#include "Helper.h"
+
+// Log messages.
+char constexpr QUEUE_MESSAGE_TOO_BIG[] = "Message (%u) is too big for the outbound queue segment size (%u)";
+char constexpr QUEUE_APPEND_FAILED[] = "Appending (%u) bytes to the outbound queue storage failed";
+char constexpr QUEUE_SEGMENT_OVERWRITTEN[] = "Outbound queue is full, dropping unsent messages of the oldest segment";
+// Record layout.
+uint8_t constexpr RECORD_SYNC_BYTE = 0xA5U;
+size_t constexpr RECORD_HEADER_SIZE = 9U;
+// Segment layout.
+uint8_t constexpr SEGMENT_MAGIC[4U] = { 'T', 'B', 'O', 'Q' };
+size_t constexpr SEGMENT_HEADER_SIZE = 8U;
+// Start of a json object that contains a timestamp and can therefore be merged without losing values.
+char constexpr TIMESTAMPED_JSON_PREFIX[] = "{\"ts\":";
+
+Outbound_Queue::Outbound_Queue(IOutbound_Storage & storage, size_t const & segment_size, size_t const & block_size)
+  : m_storage(storage)
+  , m_max_segment_size(segment_size)
+  , m_block_size(block_size > 0U ? block_size : 1U)
+  , m_block(nullptr)
+  , m_drain_buffer(nullptr)
+  , m_drain_buffer_size(0U)
+  , m_pending(0U)
+  , m_segment_sizes()
+  , m_sequences()
+  , m_write_segment(0U)
+  , m_read()
+  , m_dropped(0U)
+  , m_initialized(false)
+{
+    // Nothing to do
+}
+
+Outbound_Queue::~Outbound_Queue() {
+    if (m_initialized) {
+        (void)Flush();
+    }
+    delete[] m_block;
+    m_block = nullptr;
+    delete[] m_drain_buffer;
+    m_drain_buffer = nullptr;
+}
+
+bool Outbound_Queue::Enqueue(char const * topic, uint8_t const * payload, size_t const & length) {
+    if (topic == nullptr || (payload == nullptr && length != 0U) || !Initialize()) {
+        return false;
+    }
+
+    size_t const topic_length = strlen(topic);
+    size_t const record_size = RECORD_HEADER_SIZE + topic_length + length;
+    if (topic_length >= MAX_QUEUED_TOPIC_SIZE || length > UINT16_MAX || SEGMENT_HEADER_SIZE + record_size > m_max_segment_size) {
+        DefaultLogger::printfln(QUEUE_MESSAGE_TOO_BIG, record_size, m_max_segment_size);
+        m_dropped++;
+        return false;
+    }
+    if (m_segment_sizes[m_write_segment] + m_pending + record_size > m_max_segment_size && (!Flush() || !Rotate())) {
+        return false;
+    }
+
+    uint8_t header[RECORD_HEADER_SIZE] = {};
+    header[0U] = RECORD_SYNC_BYTE;
+    header[1U] = static_cast<uint8_t>(topic_length);
+    header[2U] = static_cast<uint8_t>(topic_length >> 8U);
+    header[3U] = static_cast<uint8_t>(length);
+    header[4U] = static_cast<uint8_t>(length >> 8U);
+    uint32_t crc = Helper::Calculate_CRC32(header + 1U, 4U);
+    crc = Helper::Calculate_CRC32(reinterpret_cast<uint8_t const *>(topic), topic_length, crc);
+    crc = Helper::Calculate_CRC32(payload, length, crc);
+    for (uint8_t i = 0U; i < 4U; ++i) {
+        header[5U + i] = static_cast<uint8_t>(crc >> (8U * i));
+    }
+
+    if (m_pending + record_size > m_block_size && !Flush()) {
+        return false;
+    }
+    if (record_size > m_block_size) {
+        // Records bigger than a single block could never be collected in the RAM buffer and are therefore appended directly instead
+        size_t written = m_storage.append(m_write_segment, header, RECORD_HEADER_SIZE);
+        written += m_storage.append(m_write_segment, reinterpret_cast<uint8_t const *>(topic), topic_length);
+        written += m_storage.append(m_write_segment, payload, length);
+        // Account for partially written records as well, because they still occupy space in the segment and are skipped when reading
+        m_segment_sizes[m_write_segment] += written;
+        if (written != record_size) {
+            DefaultLogger::printfln(QUEUE_APPEND_FAILED, record_size);
+            m_dropped++;
+            return false;
+        }
+        return true;
+    }
+    memcpy(m_block + m_pending, header, RECORD_HEADER_SIZE);
+    memcpy(m_block + m_pending + RECORD_HEADER_SIZE, topic, topic_length);
+    memcpy(m_block + m_pending + RECORD_HEADER_SIZE + topic_length, payload, length);
+    m_pending += record_size;
+    return true;
+}
+
+bool Outbound_Queue::Flush() {
+    if (!Initialize()) {
+        return false;
+    }
+    if (m_pending == 0U) {
+        return true;
+    }
+    size_t const written = m_storage.append(m_write_segment, m_block, m_pending);
+    m_segment_sizes[m_write_segment] += written;
+    bool const result = written == m_pending;
+    if (!result) {
+        DefaultLogger::printfln(QUEUE_APPEND_FAILED, m_pending);
+        m_dropped++;
+    }
+    // Clear the RAM buffer even if appending failed, because otherwise it would never be able to collect new records again
+    m_pending = 0U;
+    return result;
+}
+
+bool Outbound_Queue::Empty() {
+    if (!Initialize()) {
+        return true;
+    }
+    return m_pending == 0U && m_read.segment == m_write_segment && m_read.offset >= m_segment_sizes[m_write_segment];
+}
+
+size_t const & Outbound_Queue::Get_Dropped() const {
+    return m_dropped;
+}
+
+bool Outbound_Queue::Initialize() {
+    if (m_initialized) {
+        return true;
+    }
+    if (m_block == nullptr) {
+        m_block = new uint8_t[m_block_size];
+        if (m_block == nullptr) {
+            return false;
+        }
+    }
+
+    bool valid[OUTBOUND_SEGMENT_COUNT] = {};
+    for (uint8_t segment = 0U; segment < OUTBOUND_SEGMENT_COUNT; ++segment) {
+        m_segment_sizes[segment] = m_storage.size(segment);
+        uint8_t header[SEGMENT_HEADER_SIZE] = {};
+        valid[segment] = m_segment_sizes[segment] >= SEGMENT_HEADER_SIZE && m_storage.read(segment, 0U, header, SEGMENT_HEADER_SIZE) == SEGMENT_HEADER_SIZE && memcmp(header, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) == 0;
+        if (valid[segment]) {
+            m_sequences[segment] = static_cast<uint32_t>(header[4U]) | (static_cast<uint32_t>(header[5U]) << 8U) | (static_cast<uint32_t>(header[6U]) << 16U) | (static_cast<uint32_t>(header[7U]) << 24U);
+        }
+    }
+
+    if (valid[0U] && valid[1U]) {
+        // Both segments contain records, the segment with the higher sequence number contains the newer ones
+        m_write_segment = (m_sequences[1U] > m_sequences[0U]) ? 1U : 0U;
+        m_read.segment = 1U - m_write_segment;
+    }
+    else if (valid[0U] || valid[1U]) {
+        m_write_segment = valid[1U] ? 1U : 0U;
+        m_read.segment = m_write_segment;
+        (void)m_storage.erase(1U - m_write_segment);
+        m_segment_sizes[1U - m_write_segment] = 0U;
+    }
+    else {
+        m_write_segment = 0U;
+        m_read.segment = m_write_segment;
+        (void)m_storage.erase(1U);
+        m_segment_sizes[1U] = 0U;
+        if (!Start_Segment(m_write_segment, 0U)) {
+            return false;
+        }
+    }
+    m_read.offset = SEGMENT_HEADER_SIZE;
+    m_initialized = true;
+    return true;
+}
+
+bool Outbound_Queue::Start_Segment(uint8_t const & segment, uint32_t const & sequence) {
+    m_segment_sizes[segment] = 0U;
+    if (!m_storage.erase(segment)) {
+        return false;
+    }
+    uint8_t header[SEGMENT_HEADER_SIZE] = {};
+    memcpy(header, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    for (uint8_t i = 0U; i < 4U; ++i) {
+        header[4U + i] = static_cast<uint8_t>(sequence >> (8U * i));
+    }
+    m_segment_sizes[segment] = m_storage.append(segment, header, SEGMENT_HEADER_SIZE);
+    m_sequences[segment] = sequence;
+    return m_segment_sizes[segment] == SEGMENT_HEADER_SIZE;
+}
+
+bool Outbound_Queue::Rotate() {
+    uint8_t const other_segment = 1U - m_write_segment;
+    if (m_read.segment == other_segment) {
+        if (m_read.offset < m_segment_sizes[other_segment]) {
+            DefaultLogger::printfln(QUEUE_SEGMENT_OVERWRITTEN);
+            m_dropped++;
+        }
+        m_read.segment = m_write_segment;
+        m_read.offset = SEGMENT_HEADER_SIZE;
+    }
+    if (!Start_Segment(other_segment, m_sequences[m_write_segment] + 1U)) {
+        // Reinitialize from the storage the next time the queue is used, because the segment state is unknown now
+        m_initialized = false;
+        return false;
+    }
+    m_write_segment = other_segment;
+    return true;
+}
+
+bool Outbound_Queue::Read_Record(Position & position, char * topic, uint8_t * payload, size_t const & payload_size, size_t & length, bool const & drop_oversized) {
+    while (true) {
+        size_t const segment_size = m_segment_sizes[position.segment];
+        if (position.offset + RECORD_HEADER_SIZE > segment_size) {
+            // Remaining bytes can not contain another record, continue with the newer segment or stop if this already is the newest one
+            if (position.segment == m_write_segment) {
+                position.offset = (segment_size > position.offset) ? segment_size : position.offset;
+                return false;
+            }
+            position.segment = m_write_segment;
+            position.offset = SEGMENT_HEADER_SIZE;
+            continue;
+        }
+
+        uint8_t header[RECORD_HEADER_SIZE] = {};
+        if (m_storage.read(position.segment, position.offset, header, RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE) {
+            position.offset = segment_size;
+            continue;
+        }
+        size_t const topic_length = static_cast<size_t>(header[1U]) | (static_cast<size_t>(header[2U]) << 8U);
+        size_t const payload_length = static_cast<size_t>(header[3U]) | (static_cast<size_t>(header[4U]) << 8U);
+        size_t const record_size = RECORD_HEADER_SIZE + topic_length + payload_length;
+        // Partially written or otherwise corrupted data, search for the next sync byte that starts a valid record instead
+        if (header[0U] != RECORD_SYNC_BYTE || topic_length >= MAX_QUEUED_TOPIC_SIZE || position.offset + record_size > segment_size) {
+            position.offset++;
+            continue;
+        }
+        if (payload_length > payload_size) {
+            if (!drop_oversized) {
+                return false;
+            }
+            m_dropped++;
+            position.offset += record_size;
+            continue;
+        }
+
+        uint8_t * topic_bytes = reinterpret_cast<uint8_t *>(topic);
+        if (m_storage.read(position.segment, position.offset + RECORD_HEADER_SIZE, topic_bytes, topic_length) != topic_length || m_storage.read(position.segment, position.offset + RECORD_HEADER_SIZE + topic_length, payload, payload_length) != payload_length) {
+            position.offset++;
+            continue;
+        }
+        uint32_t crc = Helper::Calculate_CRC32(header + 1U, 4U);
+        crc = Helper::Calculate_CRC32(topic_bytes, topic_length, crc);
+        crc = Helper::Calculate_CRC32(payload, payload_length, crc);
+        uint32_t const expected_crc = static_cast<uint32_t>(header[5U]) | (static_cast<uint32_t>(header[6U]) << 8U) | (static_cast<uint32_t>(header[7U]) << 16U) | (static_cast<uint32_t>(header[8U]) << 24U);
+        if (crc != expected_crc) {
+            position.offset++;
+            continue;
+        }
+
+        topic[topic_length] = '\0';
+        length = payload_length;
+        position.offset += record_size;
+        return true;
+    }
+}
+
+void Outbound_Queue::Commit(Position const & position) {
+    if (position.segment != m_read.segment) {
+        // All messages of the older segment have been sent, erasing it ensures they are not sent again after a restart
+        (void)m_storage.erase(m_read.segment);
+        m_segment_sizes[m_read.segment] = 0U;
+    }
+    m_read = position;
+    // Restart the segment once all messages have been sent, to ensure they are not sent again after a restart and to start with an empty segment again
+    if (m_read.segment == m_write_segment && m_read.offset >= m_segment_sizes[m_write_segment] && m_pending == 0U) {
+        if (!Start_Segment(m_write_segment, m_sequences[m_write_segment] + 1U)) {
+            m_initialized = false;
+            return;
+        }
+        m_read.offset = SEGMENT_HEADER_SIZE;
+    }
+}
+
+bool Outbound_Queue::Is_Timestamped_Json(uint8_t const * payload, size_t const & length) {
+    size_t const prefix_length = sizeof(TIMESTAMPED_JSON_PREFIX) - 1U;
+    if (length >= prefix_length + 1U && payload[length - 1U] == '}') {
+        return memcmp(payload, TIMESTAMPED_JSON_PREFIX, prefix_length) == 0;
+    }
+    if (length >= prefix_length + 3U && payload[0U] == '[' && payload[length - 1U] == ']') {
+        return memcmp(payload + 1U, TIMESTAMPED_JSON_PREFIX, prefix_length) == 0;
+    }
+    return false;
+}
+
+size_t Outbound_Queue::Unwrap_Json_Array(uint8_t * payload, size_t const & length) {
+    if (payload[0U] != '[') {
+        return length;
+    }
+    memmove(payload, payload + 1U, length - 2U);
+    return length - 2U;
+}
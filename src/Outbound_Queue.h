@@ -0,0 +1,209 @@
+#ifndef Outbound_Queue_h
+#define Outbound_Queue_h
+
+// Local includes.
+#include "IOutbound_Storage.h"
+#include "DefaultLogger.h"
+
+// Library includes.
+#include <string.h>
+
+
+// Maximum size of a topic that can be stored in the queue including the null termination
+size_t constexpr MAX_QUEUED_TOPIC_SIZE = 128U;
+
+
+/// @brief Persistent store-and-forward queue for outgoing messages, which are sent while there is no connection to the MQTT broker.
+/// Allows to send the messages once the connection has been established again, instead of losing them.
+/// @note The messages are stored log-structured in two segments of the given @ref IOutbound_Storage, where new messages are only ever appended to the end of the newer segment.
+/// Each message is stored as a record consisting of a sync byte, the length of the topic and payload and a CRC-32 checksum over all of them, followed by the topic and the payload itself.
+/// This allows to detect records that have only been partially written because of a power loss and to skip over them, by searching for the next valid record instead.
+/// To reduce the wear on the flash memory, records are first collected in a RAM buffer of the given block size and only appended once that block is full or before the queue is drained.
+/// Be aware that this means that the messages contained in that RAM buffer are lost if the device loses power before the block is appended.
+/// Once the newer segment is full, the older segment is erased and used for new messages instead, meaning the total size is bounded to twice the segment size and the oldest messages are dropped first.
+/// Segments are only erased once all their messages have been sent, therefore messages of partially sent segments are sent again after a restart (at-least-once delivery)
+class Outbound_Queue {
+  public:
+    /// @brief Constructor
+    /// @param storage Storage the segments are persisted in.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param segment_size Maximum amount of bytes a single segment can contain, total amount of stored bytes is atmost twice this value, default = 16384
+    /// @param block_size Amount of bytes that are collected in RAM before they are appended to the storage, ideally the page size of the underlying file system or flash, default = 256
+    Outbound_Queue(IOutbound_Storage & storage, size_t const & segment_size = 16384U, size_t const & block_size = 256U);
+
+    /// @brief Destructor
+    /// @note Appends the remaining collected records before the RAM buffers are freed
+    ~Outbound_Queue();
+
+    /// @brief Deleted copy constructor
+    /// @note Copying an active queue writing to the same storage, makes no sense as it would overwrite the stored records. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Outbound_Queue(Outbound_Queue const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying an active queue writing to the same storage, makes no sense as it would overwrite the stored records. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    void operator=(Outbound_Queue const & other) = delete;
+
+    /// @brief Appends the given message to the end of the queue
+    /// @param topic Non owning pointer to the topic the message should be sent over once the connection has been established again.
+    /// Does not need to be kept alive, because it is copied into the queue
+    /// @param payload Non owning pointer to the payload of the message.
+    /// Does not need to be kept alive, because it is copied into the queue
+    /// @param length Length of the given payload
+    /// @return Whether appending the message was successful or not
+    bool Enqueue(char const * topic, uint8_t const * payload, size_t const & length);
+
+    /// @brief Appends all records that are still collected in the RAM buffer to the storage
+    /// @return Whether appending the records was successful or not
+    bool Flush();
+
+    /// @brief Whether the queue contains any messages that have not been sent yet
+    /// @return Whether the queue is empty or not
+    bool Empty();
+
+    /// @brief Returns the amount of messages that have been dropped, because they were too big or because the segment they were contained in has been overwritten.
+    /// Messages that have been overwritten as part of a complete segment only count as one
+    /// @return Amount of dropped messages
+    size_t const & Get_Dropped() const;
+
+    /// @brief Sends the oldest messages contained in the queue with the given function and removes them once they have been sent successfully
+    /// @note Consecutive messages over the given merge topic that contain a timestamped json object ({"ts":1451649600512,"values":{"key1":"value1"}}) or an array of them are merged into one json array,
+    /// which allows to send many small messages with a single publish, as long as the merged array fits into the buffer.
+    /// Messages without a timestamp are never merged and sent with one publish each instead, because the server would stamp every element of the merged array with the same time,
+    /// meaning only the last value of each key would be kept. Such messages are still stamped with the time they are received by the server, so to keep the original time they should contain a timestamp themselves.
+    /// The payloads are read into a buffer owned by the queue, which is allocated on first use and only reallocated if the given size changes
+    /// @tparam PublishFunction Callable that receives the topic, the payload and its length and returns whether sending the message was successful or not
+    /// @param max_messages Maximum amount of stored messages that should be sent, allows to limit the rate the queue is drained with
+    /// @param buffer_size Size of the buffer the payloads are read into, has to be atleast as big as the biggest message that should be sent, bigger messages are dropped
+    /// @param merge_topic Non owning pointer to the topic whose messages should be merged, nullptr if no messages should be merged
+    /// @param publish Function that sends the message
+    /// @return Amount of stored messages that have been sent and removed from the queue
+    template<typename PublishFunction>
+    size_t Drain(size_t const & max_messages, size_t const & buffer_size, char const * merge_topic, PublishFunction publish) {
+        if (buffer_size < 3U || !Flush()) {
+            return 0U;
+        }
+        if (m_drain_buffer == nullptr || m_drain_buffer_size != buffer_size) {
+            delete[] m_drain_buffer;
+            m_drain_buffer = new uint8_t[buffer_size];
+            m_drain_buffer_size = (m_drain_buffer != nullptr) ? buffer_size : 0U;
+            if (m_drain_buffer == nullptr) {
+                return 0U;
+            }
+        }
+        uint8_t * buffer = m_drain_buffer;
+
+        char topic[MAX_QUEUED_TOPIC_SIZE] = {};
+        char next_topic[MAX_QUEUED_TOPIC_SIZE] = {};
+        size_t sent = 0U;
+        while (sent < max_messages) {
+            Position end = m_read;
+            size_t length = 0U;
+            // Leave space for the opening and closing bracket of the json array, in case multiple messages can be merged
+            if (!Read_Record(end, topic, buffer + 1U, buffer_size - 2U, length, true)) {
+                // Skipped invalid records and segments that do not contain any more records can be committed as well
+                Commit(end);
+                break;
+            }
+
+            size_t merged = 1U;
+            bool const mergeable = merge_topic != nullptr && strcmp(topic, merge_topic) == 0 && Is_Timestamped_Json(buffer + 1U, length);
+            if (mergeable) {
+                length = Unwrap_Json_Array(buffer + 1U, length);
+                while (sent + merged < max_messages) {
+                    // Seperator and the closing bracket have to fit after the next message as well
+                    size_t const used = 1U + length;
+                    if (used + 2U >= buffer_size) {
+                        break;
+                    }
+                    Position next = end;
+                    size_t next_length = 0U;
+                    if (!Read_Record(next, next_topic, buffer + used + 1U, buffer_size - used - 2U, next_length, false) || strcmp(next_topic, topic) != 0 || !Is_Timestamped_Json(buffer + used + 1U, next_length)) {
+                        break;
+                    }
+                    buffer[used] = ',';
+                    length += 1U + Unwrap_Json_Array(buffer + used + 1U, next_length);
+                    end = next;
+                    merged++;
+                }
+                buffer[0U] = '[';
+                buffer[length + 1U] = ']';
+                length += 2U;
+            }
+
+            if (!publish(topic, mergeable ? buffer : buffer + 1U, length)) {
+                break;
+            }
+            Commit(end);
+            sent += merged;
+        }
+        return sent;
+    }
+
+  private:
+    /// @brief Position of a record in the storage
+    struct Position {
+        uint8_t segment = {}; // Index of the segment the record is stored in
+        size_t  offset = {};  // Amount of bytes from the start of the segment to the start of the record
+    };
+
+    /// @brief Reads the existing segments from the storage and decides which one contains the oldest messages and which one new messages are appended to
+    /// @note Is only executed once, the first time the queue is used
+    /// @return Whether initalizing was successful or not
+    bool Initialize();
+
+    /// @brief Erases the given segment and writes the header with the given sequence number into it
+    /// @param segment Index of the segment
+    /// @param sequence Sequence number of the segment, allows to decide which segment is the older one after a restart
+    /// @return Whether starting the segment was successful or not
+    bool Start_Segment(uint8_t const & segment, uint32_t const & sequence);
+
+    /// @brief Erases the older segment and appends new records to it instead, drops all messages that have not been sent from that segment yet
+    /// @return Whether rotating the segments was successful or not
+    bool Rotate();
+
+    /// @brief Reads the next valid record starting at the given position, skipping any invalid or partially written records
+    /// @param position Position the search should start at, is set to the position following the read record if it was read successfully
+    /// @param topic Buffer with a size of MAX_QUEUED_TOPIC_SIZE the topic of the record is copied into, including null termination
+    /// @param payload Buffer the payload of the record is copied into
+    /// @param payload_size Size of the given payload buffer
+    /// @param length Length of the read payload
+    /// @param drop_oversized Whether records that are too big for the given payload buffer should be dropped or the read should simply fail instead
+    /// @return Whether a record was read successfully, false if there are no more records or the next record is too big and should not be dropped
+    bool Read_Record(Position & position, char * topic, uint8_t * payload, size_t const & payload_size, size_t & length, bool const & drop_oversized);
+
+    /// @brief Marks all records before the given position as sent, erases the older segment if all its messages have been sent
+    /// and restarts the newer segment if all messages of the queue have been sent
+    /// @param position Position of the first record that has not been sent yet
+    void Commit(Position const & position);
+
+    /// @brief Whether the given payload contains a timestamped json object or a non empty json array of timestamped objects and can therefore be merged with other payloads
+    /// @note Only the first element of an array is checked, because the arrays built by this library either timestamp all their elements or none of them
+    /// @param payload Payload that should be checked
+    /// @param length Length of the payload
+    /// @return Whether the payload can be merged
+    static bool Is_Timestamped_Json(uint8_t const * payload, size_t const & length);
+
+    /// @brief Removes the enclosing brackets if the given payload is a json array, so that its elements can be merged into another json array
+    /// @param payload Payload that should be unwrapped
+    /// @param length Length of the payload
+    /// @return Length of the unwrapped payload
+    static size_t Unwrap_Json_Array(uint8_t * payload, size_t const & length);
+
+    IOutbound_Storage & m_storage;                // Storage the segments are persisted in
+    size_t              m_max_segment_size;       // Maximum amount of bytes a single segment can contain
+    size_t              m_block_size;             // Amount of bytes that are collected in RAM before they are appended to the storage
+    uint8_t             *m_block = {};            // RAM buffer records are collected in, allocated on first use
+    uint8_t             *m_drain_buffer = {};     // RAM buffer the payloads are read into while draining, allocated on first use
+    size_t              m_drain_buffer_size = {}; // Size the drain buffer was allocated with
+    size_t              m_pending = {};           // Amount of bytes currently collected in the RAM buffer
+    size_t              m_segment_sizes[2U] = {}; // Amount of bytes stored in each segment, 0 if the segment has been erased
+    uint32_t            m_sequences[2U] = {};     // Sequence number of each segment, the segment with the higher number contains the newer records
+    uint8_t             m_write_segment = {};     // Index of the segment new records are appended to
+    Position            m_read = {};              // Position of the oldest record that has not been sent yet
+    size_t              m_dropped = {};           // Amount of dropped messages
+    bool                m_initialized = {};       // Whether the existing segments have already been read from the storage
+};
+
+#endif // Outbound_Queue_h
@@ -0,0 +1,20 @@
+#ifndef Payload_Codec_h
+#define Payload_Codec_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible payload formats the device profile of the device on the server has been configured to use, over the same MQTT topics.
+/// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+/// @note Uploaded telemetry and attribute data in the protobuf format have to be sent with @ref ThingsBoard::Send_Encoded_Protobuf or the field based send methods instead of the json based ones,
+/// because their schema is defined freely by the user in the device profile. The server-side RPC messages in contrast are transcoded automatically,
+/// as long as the default RPC request (method = 1, requestId = 2, params = 3) and response (payload = 1) schemas of the device profile are used.
+/// Client-side RPC, attribute requests, attribute responses and shared attribute updates use fixed transport messages, which can not be configured in the device profile, and are transcoded automatically as well.
+/// Claiming and provisioning messages are not transcoded
+enum class Payload_Codec : uint8_t {
+    JSON, ///< Default, all payloads are sent and received as json
+    PROTOBUF ///< RPC and attribute messages are sent and received as protobuf messages, which are transcoded from and into the json the API implementations use
+};
+
+#endif // Payload_Codec_h
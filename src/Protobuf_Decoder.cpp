@@ -0,0 +1,136 @@
+// Header include.
+#include "Protobuf_Decoder.h"
+
+// Library includes.
+#include <string.h>
+
+// Varint decoding.
+uint8_t constexpr VARINT_DATA_MASK = 0x7FU;
+uint8_t constexpr VARINT_MORE_BYTES_BIT = 0x80U;
+uint8_t constexpr MAX_VARINT_SHIFT = 63U;
+// Tag decoding.
+uint8_t constexpr TAG_WIRE_TYPE_BITS = 3U;
+uint8_t constexpr TAG_WIRE_TYPE_MASK = 0x07U;
+
+Protobuf_Decoder::Protobuf_Decoder(uint8_t const * payload, size_t const & length)
+  : m_payload(payload)
+  , m_length(payload != nullptr ? length : 0U)
+  , m_position(0U)
+  , m_error(false)
+{
+    // Nothing to do
+}
+
+bool Protobuf_Decoder::Next_Field(uint32_t & field_number, Protobuf_Wire_Type & wire_type) {
+    if (m_error || m_position >= m_length) {
+        return false;
+    }
+    uint64_t tag = 0U;
+    if (!Read_Varint(tag)) {
+        return false;
+    }
+    field_number = static_cast<uint32_t>(tag >> TAG_WIRE_TYPE_BITS);
+    wire_type = static_cast<Protobuf_Wire_Type>(tag & TAG_WIRE_TYPE_MASK);
+    // Field number 0 is reserved and never valid
+    if (field_number == 0U) {
+        return Fail();
+    }
+    return true;
+}
+
+bool Protobuf_Decoder::Read_Varint(uint64_t & value) {
+    value = 0U;
+    for (uint8_t shift = 0U; shift <= MAX_VARINT_SHIFT; shift += 7U) {
+        if (m_error || m_position >= m_length) {
+            return Fail();
+        }
+        uint8_t const byte = m_payload[m_position++];
+        value |= static_cast<uint64_t>(byte & VARINT_DATA_MASK) << shift;
+        if ((byte & VARINT_MORE_BYTES_BIT) == 0U) {
+            return true;
+        }
+    }
+    // More than 10 bytes can never be a valid 64 bit value
+    return Fail();
+}
+
+bool Protobuf_Decoder::Read_Signed(int64_t & value) {
+    uint64_t encoded = 0U;
+    if (!Read_Varint(encoded)) {
+        return false;
+    }
+    value = static_cast<int64_t>(encoded >> 1U) ^ -static_cast<int64_t>(encoded & 1U);
+    return true;
+}
+
+bool Protobuf_Decoder::Read_Double(double & value) {
+    uint64_t bits = 0U;
+    if (!Read_Little_Endian(bits, sizeof(bits))) {
+        return false;
+    }
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool Protobuf_Decoder::Read_Float(float & value) {
+    uint64_t bits = 0U;
+    if (!Read_Little_Endian(bits, sizeof(uint32_t))) {
+        return false;
+    }
+    uint32_t const float_bits = static_cast<uint32_t>(bits);
+    memcpy(&value, &float_bits, sizeof(value));
+    return true;
+}
+
+bool Protobuf_Decoder::Read_Length_Delimited(uint8_t const * & value, size_t & length) {
+    uint64_t encoded_length = 0U;
+    if (!Read_Varint(encoded_length)) {
+        return false;
+    }
+    if (encoded_length > m_length - m_position) {
+        return Fail();
+    }
+    value = m_payload + m_position;
+    length = static_cast<size_t>(encoded_length);
+    m_position += length;
+    return true;
+}
+
+bool Protobuf_Decoder::Skip_Field(Protobuf_Wire_Type const & wire_type) {
+    uint64_t ignored = 0U;
+    switch (wire_type) {
+        case Protobuf_Wire_Type::VARINT:
+            return Read_Varint(ignored);
+        case Protobuf_Wire_Type::FIXED64:
+            return Read_Little_Endian(ignored, sizeof(uint64_t));
+        case Protobuf_Wire_Type::FIXED32:
+            return Read_Little_Endian(ignored, sizeof(uint32_t));
+        case Protobuf_Wire_Type::LENGTH_DELIMITED: {
+            uint8_t const * value = nullptr;
+            size_t length = 0U;
+            return Read_Length_Delimited(value, length);
+        }
+        default:
+            return Fail();
+    }
+}
+
+bool Protobuf_Decoder::Has_Error() const {
+    return m_error;
+}
+
+bool Protobuf_Decoder::Read_Little_Endian(uint64_t & value, uint8_t const & bytes) {
+    if (m_error || bytes > m_length - m_position) {
+        return Fail();
+    }
+    value = 0U;
+    for (uint8_t index = 0U; index < bytes; ++index) {
+        value |= static_cast<uint64_t>(m_payload[m_position++]) << (8U * index);
+    }
+    return true;
+}
+
+bool Protobuf_Decoder::Fail() {
+    m_error = true;
+    return false;
+}
@@ -0,0 +1,87 @@
+#ifndef Protobuf_Decoder_h
+#define Protobuf_Decoder_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Protobuf_Wire_Type.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Minimal protobuf reader, which iterates over the fields of a received message without copying or allocating anything.
+/// See https://protobuf.dev/programming-guides/encoding/ for more information on the binary format
+/// @note Allows to handle RPC requests or attribute responses for devices whose device profile has been configured to use protobuf instead of json.
+/// The fields are read in the order they are contained in the message, by first calling @ref Next_Field and then reading the value with the method matching the returned wire type.
+/// Fields whose number is unknown or not required can simply be skipped with @ref Skip_Field. Length delimited values are returned as non owning pointers into the given payload,
+/// therefore the payload has to be kept alive as long as the values are used. Any malformed or truncated data stops the iteration and is reported with @ref Has_Error
+class Protobuf_Decoder {
+  public:
+    /// @brief Constructs a decoder that reads from the given payload
+    /// @param payload Non owning pointer to the received message.
+    /// Has to be kept alive for as long as the decoder and the read length delimited values are used
+    /// @param length Length of the received message
+    Protobuf_Decoder(uint8_t const * payload, size_t const & length);
+
+    /// @brief Reads the tag of the next field
+    /// @param field_number Number of the read field in the message schema
+    /// @param wire_type Wire type the value of the read field is encoded with
+    /// @return Whether another field was read successfully, false once the end of the message has been reached or the tag was malformed
+    bool Next_Field(uint32_t & field_number, Protobuf_Wire_Type & wire_type);
+
+    /// @brief Reads the value of a variable length integer field, used for int32, int64, uint32, uint64, bool and enum fields
+    /// @note Negative int32 and int64 values can be restored by simply casting the read value to the signed type
+    /// @param value Read value
+    /// @return Whether reading the value was successful or not
+    bool Read_Varint(uint64_t & value);
+
+    /// @brief Reads the value of a zig-zag encoded variable length integer field, used for sint32 and sint64 fields
+    /// @param value Read value
+    /// @return Whether reading the value was successful or not
+    bool Read_Signed(int64_t & value);
+
+    /// @brief Reads the value of a 8 byte field, used for double fields
+    /// @param value Read value
+    /// @return Whether reading the value was successful or not
+    bool Read_Double(double & value);
+
+    /// @brief Reads the value of a 4 byte field, used for float fields
+    /// @param value Read value
+    /// @return Whether reading the value was successful or not
+    bool Read_Float(float & value);
+
+    /// @brief Reads the value of a length delimited field, used for string, bytes and embedded message fields
+    /// @note Strings are not null terminated, embedded messages can be read by constructing another decoder from the returned value
+    /// @param value Non owning pointer into the payload to the start of the value
+    /// @param length Length of the value
+    /// @return Whether reading the value was successful or not
+    bool Read_Length_Delimited(uint8_t const * & value, size_t & length);
+
+    /// @brief Skips the value of the previously read field
+    /// @param wire_type Wire type of the previously read field
+    /// @return Whether skipping the value was successful or not, fails for the unsupported group wire types
+    bool Skip_Field(Protobuf_Wire_Type const & wire_type);
+
+    /// @brief Whether the message was malformed or truncated
+    /// @return Whether any read failed because of invalid data
+    bool Has_Error() const;
+
+  private:
+    /// @brief Reads the given amount of bytes in little endian order
+    /// @param value Read value
+    /// @param bytes Amount of bytes that should be read
+    /// @return Whether enough bytes were left to read the value
+    bool Read_Little_Endian(uint64_t & value, uint8_t const & bytes);
+
+    /// @brief Marks the message as malformed and stops any further reads
+    /// @return Always false, allows to directly return the result
+    bool Fail();
+
+    uint8_t const *m_payload = {}; // Non owning pointer to the received message
+    size_t        m_length = {};   // Length of the received message
+    size_t        m_position = {}; // Amount of already read bytes
+    bool          m_error = {};    // Whether the message was malformed or truncated
+};
+
+#endif // Protobuf_Decoder_h
@@ -0,0 +1,110 @@
+// Header include.
+#include "Protobuf_Encoder.h"
+
+// Library includes.
+#include <string.h>
+
+// Varint encoding.
+uint8_t constexpr VARINT_PAYLOAD_MASK = 0x7FU;
+uint8_t constexpr VARINT_CONTINUATION_BIT = 0x80U;
+uint8_t constexpr MAX_VARINT_SIZE = 10U;
+// Tag encoding.
+uint8_t constexpr WIRE_TYPE_BITS = 3U;
+
+Protobuf_Encoder::Protobuf_Encoder(uint8_t * buffer, size_t const & size)
+  : m_buffer(buffer)
+  , m_size(buffer != nullptr ? size : 0U)
+  , m_length(0U)
+{
+    // Nothing to do
+}
+
+void Protobuf_Encoder::Write_Unsigned(uint32_t const & field_number, uint64_t const & value) {
+    Write_Tag(field_number, Protobuf_Wire_Type::VARINT);
+    Write_Varint(value);
+}
+
+void Protobuf_Encoder::Write_Integer(uint32_t const & field_number, int64_t const & value) {
+    Write_Tag(field_number, Protobuf_Wire_Type::VARINT);
+    // Negative values are encoded as their 64 bit two's complement representation, the same as the reference implementation does
+    Write_Varint(static_cast<uint64_t>(value));
+}
+
+void Protobuf_Encoder::Write_Signed(uint32_t const & field_number, int64_t const & value) {
+    Write_Tag(field_number, Protobuf_Wire_Type::VARINT);
+    // Zig-zag encoding maps values with a small absolute value to small unsigned values (0 --> 0, -1 --> 1, 1 --> 2, ...), the right shift is required to be arithmetic
+    Write_Varint((static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63U));
+}
+
+void Protobuf_Encoder::Write_Bool(uint32_t const & field_number, bool const & value) {
+    Write_Tag(field_number, Protobuf_Wire_Type::VARINT);
+    Write_Varint(value ? 1U : 0U);
+}
+
+void Protobuf_Encoder::Write_Double(uint32_t const & field_number, double const & value) {
+    static_assert(sizeof(double) == sizeof(uint64_t), "Double has to be a 64 bit IEEE 754 floating point");
+    Write_Tag(field_number, Protobuf_Wire_Type::FIXED64);
+    uint64_t bits = 0U;
+    memcpy(&bits, &value, sizeof(bits));
+    Write_Little_Endian(bits, sizeof(bits));
+}
+
+void Protobuf_Encoder::Write_Float(uint32_t const & field_number, float const & value) {
+    static_assert(sizeof(float) == sizeof(uint32_t), "Float has to be a 32 bit IEEE 754 floating point");
+    Write_Tag(field_number, Protobuf_Wire_Type::FIXED32);
+    uint32_t bits = 0U;
+    memcpy(&bits, &value, sizeof(bits));
+    Write_Little_Endian(bits, sizeof(bits));
+}
+
+void Protobuf_Encoder::Write_String(uint32_t const & field_number, char const * value) {
+    if (value == nullptr) {
+        Write_Bytes(field_number, nullptr, 0U);
+        return;
+    }
+    Write_Bytes(field_number, reinterpret_cast<uint8_t const *>(value), strlen(value));
+}
+
+void Protobuf_Encoder::Write_Bytes(uint32_t const & field_number, uint8_t const * value, size_t const & length) {
+    Write_Tag(field_number, Protobuf_Wire_Type::LENGTH_DELIMITED);
+    Write_Varint(length);
+    Write_Raw(value, length);
+}
+
+size_t const & Protobuf_Encoder::Get_Length() const {
+    return m_length;
+}
+
+bool Protobuf_Encoder::Is_Complete() const {
+    return m_buffer == nullptr || m_length <= m_size;
+}
+
+void Protobuf_Encoder::Write_Tag(uint32_t const & field_number, Protobuf_Wire_Type const & wire_type) {
+    Write_Varint((static_cast<uint64_t>(field_number) << WIRE_TYPE_BITS) | static_cast<uint8_t>(wire_type));
+}
+
+void Protobuf_Encoder::Write_Varint(uint64_t value) {
+    uint8_t bytes[MAX_VARINT_SIZE] = {};
+    size_t length = 0U;
+    while (value > VARINT_PAYLOAD_MASK) {
+        bytes[length++] = static_cast<uint8_t>(value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUATION_BIT;
+        value >>= 7U;
+    }
+    bytes[length++] = static_cast<uint8_t>(value);
+    Write_Raw(bytes, length);
+}
+
+void Protobuf_Encoder::Write_Little_Endian(uint64_t const & value, uint8_t const & bytes) {
+    uint8_t little_endian[sizeof(uint64_t)] = {};
+    for (uint8_t index = 0U; index < bytes; ++index) {
+        little_endian[index] = static_cast<uint8_t>(value >> (8U * index));
+    }
+    Write_Raw(little_endian, bytes);
+}
+
+void Protobuf_Encoder::Write_Raw(uint8_t const * bytes, size_t const & length) {
+    if (bytes != nullptr && length != 0U && m_length + length <= m_size) {
+        memcpy(m_buffer + m_length, bytes, length);
+    }
+    m_length += length;
+}
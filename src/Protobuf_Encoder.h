@@ -0,0 +1,122 @@
+#ifndef Protobuf_Encoder_h
+#define Protobuf_Encoder_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Protobuf_Wire_Type.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+
+
+/// @brief Minimal protobuf writer, which serializes fields directly into a caller provided buffer.
+/// See https://protobuf.dev/programming-guides/encoding/ for more information on the binary format
+/// @note Allows to send telemetry and attribute data to devices whose device profile has been configured to use protobuf instead of json,
+/// where the resulting payload is typically multiple times smaller than the equivalent json, because keys are replaced by field numbers and numbers are not formatted as text.
+/// The encoder never allocates any memory itself. If the given buffer is too small the encoder keeps counting the amount of bytes the complete message would require,
+/// but stops writing into the buffer once it is full. This allows to use the same instance with a nullptr buffer and a size of 0 to simply measure the required size beforehand.
+/// Because protobuf is a binary format the payload is not null terminated and may contain null bytes, therefore it always has to be sent together with its length
+class Protobuf_Encoder {
+  public:
+    /// @brief Constructs an encoder that writes into the given buffer
+    /// @param buffer Non owning pointer to the buffer the serialized message is written into, nullptr to only measure the required size.
+    /// Has to be kept alive for as long as the encoder is used
+    /// @param size Total size of the given buffer in bytes
+    Protobuf_Encoder(uint8_t * buffer, size_t const & size);
+
+    /// @brief Writes the given unsigned integral as a variable length integer field, used for uint32, uint64 and enum fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Unsigned(uint32_t const & field_number, uint64_t const & value);
+
+    /// @brief Writes the given signed integral as a variable length integer field, used for int32 and int64 fields
+    /// @note Negative values always require 10 bytes in this encoding, if the schema contains negative values use sint32 or sint64 fields with @ref Write_Signed instead
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Integer(uint32_t const & field_number, int64_t const & value);
+
+    /// @brief Writes the given signed integral as a zig-zag encoded variable length integer field, used for sint32 and sint64 fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Signed(uint32_t const & field_number, int64_t const & value);
+
+    /// @brief Writes the given boolean as a variable length integer field, used for bool fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Bool(uint32_t const & field_number, bool const & value);
+
+    /// @brief Writes the given floating point as a 8 byte field, used for double fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Double(uint32_t const & field_number, double const & value);
+
+    /// @brief Writes the given floating point as a 4 byte field, used for float fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Value that should be written
+    void Write_Float(uint32_t const & field_number, float const & value);
+
+    /// @brief Writes the given string as a length delimited field, used for string fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Non owning pointer to the null terminated string that should be written, nullptr is written as an empty string.
+    /// Does not need to be kept alive, because the value is copied into the buffer
+    void Write_String(uint32_t const & field_number, char const * value);
+
+    /// @brief Writes the given bytes as a length delimited field, used for bytes and string fields
+    /// @param field_number Number of the field in the message schema
+    /// @param value Non owning pointer to the bytes that should be written.
+    /// Does not need to be kept alive, because the value is copied into the buffer
+    /// @param length Amount of bytes that should be written
+    void Write_Bytes(uint32_t const & field_number, uint8_t const * value, size_t const & length);
+
+    /// @brief Writes the fields written by the given function as an embedded message field
+    /// @note The length of an embedded message has to be written before its content, therefore the given function is first called with a measuring encoder and then a second time to actually write the fields.
+    /// Because of that the given function is expected to write the exact same fields on every call
+    /// @tparam EncodeFunction Callable that receives a mutable reference to the @ref Protobuf_Encoder and writes the fields of the embedded message
+    /// @param field_number Number of the field in the message schema
+    /// @param encode Function that writes the fields of the embedded message
+    template<typename EncodeFunction>
+    void Write_Message(uint32_t const & field_number, EncodeFunction encode) {
+        Protobuf_Encoder measure_encoder(nullptr, 0U);
+        encode(measure_encoder);
+        Write_Tag(field_number, Protobuf_Wire_Type::LENGTH_DELIMITED);
+        Write_Varint(measure_encoder.Get_Length());
+        encode(*this);
+    }
+
+    /// @brief Returns the length of the complete message
+    /// @note Is also returned if the buffer was too small, which allows to use the value to allocate a big enough buffer
+    /// @return Amount of bytes the complete message requires
+    size_t const & Get_Length() const;
+
+    /// @brief Whether the complete message fits into the given buffer
+    /// @note Always true if the encoder is only used to measure the required size, because no buffer has been given
+    /// @return Whether all written bytes fit into the buffer
+    bool Is_Complete() const;
+
+  private:
+    /// @brief Writes the tag of a field, consisting of its number and wire type
+    /// @param field_number Number of the field in the message schema
+    /// @param wire_type Wire type the value of the field is encoded with
+    void Write_Tag(uint32_t const & field_number, Protobuf_Wire_Type const & wire_type);
+
+    /// @brief Writes the given value as a variable length integer, where every byte contains 7 bits of the value and the highest bit marks whether another byte follows
+    /// @param value Value that should be written
+    void Write_Varint(uint64_t value);
+
+    /// @brief Writes the given amount of lowest bytes of the given value in little endian order
+    /// @param value Value that should be written
+    /// @param bytes Amount of bytes that should be written
+    void Write_Little_Endian(uint64_t const & value, uint8_t const & bytes);
+
+    /// @brief Writes the given amount of bytes into the buffer, if there is still space left for them
+    /// @param bytes Non owning pointer to the bytes that should be written
+    /// @param length Amount of bytes that should be written
+    void Write_Raw(uint8_t const * bytes, size_t const & length);
+
+    uint8_t *m_buffer = {}; // Non owning pointer to the buffer the message is written into, nullptr if we only measure the required size
+    size_t  m_size = {};    // Total size of the buffer
+    size_t  m_length = {};  // Current amount of written bytes, is increased even if the bytes did not fit into the buffer anymore
+};
+
+#endif // Protobuf_Encoder_h
@@ -0,0 +1,16 @@
+#ifndef Protobuf_Field_h
+#define Protobuf_Field_h
+
+// Local includes.
+#include "Telemetry.h"
+
+
+/// @brief Telemetry or attribute value together with the number of the protobuf field it should be sent as, because protobuf identifies fields by their number instead of their key.
+/// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information on how the message schema is configured in the device profile
+/// @note The key of the contained telemetry record is not sent, but can still be set to keep the same records usable for json and protobuf payloads
+struct Protobuf_Field {
+    uint32_t  field_number = {}; // Number of the field in the message schema of the device profile
+    Telemetry telemetry = {};    // Value that should be sent in the field
+};
+
+#endif // Protobuf_Field_h
@@ -0,0 +1,20 @@
+#ifndef Protobuf_Wire_Type_h
+#define Protobuf_Wire_Type_h
+
+// Library include.
+#include <stdint.h>
+
+
+/// @brief Possible wire types of a field in a protobuf message, which decide how the value following the tag of the field is encoded.
+/// See https://protobuf.dev/programming-guides/encoding/#structure for more information
+/// @note The deprecated group wire types are not supported by the @ref Protobuf_Encoder or the @ref Protobuf_Decoder, because ThingsBoard never uses them
+enum class Protobuf_Wire_Type : uint8_t {
+    VARINT = 0U, ///< Variable length integer, used for int32, int64, uint32, uint64, sint32, sint64, bool and enum fields
+    FIXED64 = 1U, ///< Little endian 8 byte value, used for fixed64, sfixed64 and double fields
+    LENGTH_DELIMITED = 2U, ///< Variable length integer containing the length followed by that amount of bytes, used for string, bytes, embedded messages and packed repeated fields
+    START_GROUP = 3U, ///< Deprecated start of a group, not supported
+    END_GROUP = 4U, ///< Deprecated end of a group, not supported
+    FIXED32 = 5U ///< Little endian 4 byte value, used for fixed32, sfixed32 and float fields
+};
+
+#endif // Protobuf_Wire_Type_h
@@ -55,7 +55,7 @@ class Provision : public IAPI_Implementation {
                         return false;
                 }
 
-                JsonDocument request_buffer;
+                JsonDocument request_buffer(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
                 char const * device_name = callback.Get_Device_Name();
                 char const * access_token = callback.Get_Device_Access_Token();
                 char const * cred_username = callback.Get_Credentials_Username();
@@ -99,11 +99,11 @@ class Provision : public IAPI_Implementation {
                 return API_Process_Type::JSON;
         }
 
-        void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+        void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
                 // Nothing to do
         }
 
-        void Process_Json_Response(char const * topic, const JsonDocument& data) override {
+        void Process_Json_Response(char const * topic, size_t const & topic_length, const JsonDocument& data) override {
                 auto & request_callback = m_provision_callback.Get_Request_Timeout();
                 request_callback.Stop_Timeout_Timer();
                 m_provision_callback.Call_Callback(data);
@@ -112,8 +112,12 @@ class Provision : public IAPI_Implementation {
                 (void)Provision_Unsubscribe();
         }
 
-        bool Is_Response_Topic_Matching(char const * topic) const override {
-                return strncmp(PROV_RESPONSE_TOPIC, topic, strlen(PROV_RESPONSE_TOPIC) + 1) == 0;
+        bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+                return topic_length == strlen(PROV_RESPONSE_TOPIC) && Helper::Topic_Starts_With(topic, topic_length, PROV_RESPONSE_TOPIC, topic_length);
+        }
+
+        char const * Get_Response_Topic_Prefix() const override {
+                return PROV_RESPONSE_TOPIC;
         }
 
         bool Unsubscribe() override {
@@ -121,10 +125,14 @@ class Provision : public IAPI_Implementation {
         }
 
         bool Resubscribe_Permanent_Subscriptions() override {
-                m_provision_callback = Provision_Callback();
+                Clear_Single_Event_Subscriptions();
                 return true;
         }
 
+        void Clear_Single_Event_Subscriptions() override {
+                m_provision_callback = Provision_Callback();
+        }
+
 #if !THINGSBOARD_USE_ESP_TIMER
         void loop() override {
                 auto & request_callback = m_provision_callback.Get_Request_Timeout();
@@ -136,8 +144,9 @@ class Provision : public IAPI_Implementation {
                 // Nothing to do
         }
 
-        void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, const JsonDocument&>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+        void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, const JsonDocument&>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
                 m_send_json_callback.Set_Callback(send_json_callback);
+                m_get_json_allocator_callback.Set_Callback(get_json_allocator_callback);
         }
 
 private:
@@ -156,6 +165,7 @@ private:
         }
 
         Callback<bool, char const * const, const JsonDocument&> m_send_json_callback = {};         // Send json document callback
+        Callback<ArduinoJson::Allocator *>                      m_get_json_allocator_callback = {}; // Get send json allocator callback
 
         Provision_Callback                                       m_provision_callback = {};         // Provision response callback
 };
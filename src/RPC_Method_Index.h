@@ -0,0 +1,170 @@
+#ifndef RPC_Method_Index_h
+#define RPC_Method_Index_h
+
+// Local includes.
+#include "Callback.h"
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Offset basis of the 32 bit FNV-1a hash, see http://www.isthe.com/chongo/tech/comp/fnv/index.html for more information
+uint32_t constexpr FNV_OFFSET_BASIS = 2166136261U;
+/// @brief Prime of the 32 bit FNV-1a hash
+uint32_t constexpr FNV_PRIME = 16777619U;
+/// @brief Position returned if a method name could not be found in any of the method indices
+size_t constexpr RPC_METHOD_NOT_FOUND = SIZE_MAX;
+
+
+/// @brief Exact-match hash index over the method names of the subscribed server-side RPC callbacks.
+/// Replaces the previous linear walk over every subscribed callback, which calculated the length of every subscribed method name and compared it to the received one.
+/// @note The index keeps the 32 bit FNV-1a hash of every method name together with the position of its callback, sorted by hash, which allows to find the received method name with a binary search,
+/// where only the entries with the exact same hash have to be compared with the complete string. Only the newly subscribed callbacks are inserted into the index, because callbacks are always appended,
+/// which keeps the position of every previously subscribed callback the same. Subscribing a single callback therefore only moves the entries with a bigger hash instead of sorting the complete index again.
+/// Method names have to match exactly, meaning a received "set" does not call the callback subscribed for "setValue" anymore. If the same method name has been subscribed multiple times,
+/// the callback that was subscribed first is found, the same as with the previous linear walk
+class RPC_Method_Index {
+  public:
+    /// @brief Constructor
+    RPC_Method_Index() = default;
+
+    /// @brief Calculates the 32 bit FNV-1a hash of the given null terminated string
+    /// @note Is constexpr, so that the same hash can be used to generate tables at compile time, see @ref Static_RPC_Method_Index
+    /// @param string Non owning pointer to the string that should be hashed
+    /// @param seed Initial value of the hash, allows to calculate different hashes for the same string, default = FNV_OFFSET_BASIS
+    /// @return Hash of the given string
+    static constexpr uint32_t Hash(char const * string, uint32_t const seed = FNV_OFFSET_BASIS) {
+        uint32_t hash = seed;
+        for (size_t index = 0U; string[index] != '\0'; ++index) {
+            hash = (hash ^ static_cast<uint8_t>(string[index])) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /// @brief Calculates the 32 bit FNV-1a hash of the given amount of characters of the given string, which does not have to be null terminated
+    /// @note Separate name instead of an overload, because size_t and uint32_t are the same type on some targets, which would make it ambiguous with the seed of @ref Hash
+    /// @param string Non owning pointer to the string that should be hashed
+    /// @param length Amount of characters that should be hashed
+    /// @return Hash of the given characters, the same as @ref Hash for a null terminated string with the given length
+    static constexpr uint32_t Hash_Characters(char const * string, size_t const & length) {
+        uint32_t hash = FNV_OFFSET_BASIS;
+        for (size_t index = 0U; index < length; ++index) {
+            hash = (hash ^ static_cast<uint8_t>(string[index])) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /// @brief Clears the previous index and rebuilds it from the method names of the given callbacks
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    template <typename InputIterator>
+    void Rebuild(InputIterator const & first, InputIterator const & last) {
+        m_entries.clear();
+        Append(first, last, 0U);
+    }
+
+    /// @brief Inserts the method names of the given callbacks, that have been appended to the end of the subscribed callbacks, into the index
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first appended callback
+    /// @param last Iterator pointing to the end of the appended callbacks (last element + 1)
+    /// @param position Position of the first appended callback in the subscribed callbacks
+    template <typename InputIterator>
+    void Append(InputIterator const & first, InputIterator const & last, size_t position) {
+        for (auto it = first; it != last; ++it, ++position) {
+            char const * method_name = it->Get_Name();
+            if (Helper::String_IsNull_Or_Empty(method_name)) {
+                continue;
+            }
+            Method_Entry entry = {};
+            entry.hash = Hash(method_name);
+            entry.position = position;
+            Insert_Sorted(entry);
+        }
+    }
+
+    /// @brief Searches for the callback subscribed for the given method name
+    /// @tparam Callbacks Container of the subscribed callbacks, that has been passed to @ref Rebuild and @ref Append
+    /// @param callbacks Subscribed callbacks, used to compare the complete method name of every entry with the same hash
+    /// @param method_name Non owning pointer to the received method name
+    /// @return Position of the subscribed callback or RPC_METHOD_NOT_FOUND if no callback has been subscribed for exactly this method name
+    template <typename Callbacks>
+    size_t Find(Callbacks const & callbacks, char const * method_name) const {
+        if (method_name == nullptr) {
+            return RPC_METHOD_NOT_FOUND;
+        }
+        return Find(callbacks, method_name, strlen(method_name));
+    }
+
+    /// @brief Searches for the callback subscribed for the given method name, which does not have to be null terminated
+    /// @note Allows to resolve a method name directly inside of a received payload, without having to copy it into a null terminated buffer first
+    /// @tparam Callbacks Container of the subscribed callbacks, that has been passed to @ref Rebuild and @ref Append
+    /// @param callbacks Subscribed callbacks, used to compare the complete method name of every entry with the same hash
+    /// @param method_name Non owning pointer to the received method name
+    /// @param length Amount of characters in the received method name
+    /// @return Position of the subscribed callback or RPC_METHOD_NOT_FOUND if no callback has been subscribed for exactly this method name
+    template <typename Callbacks>
+    size_t Find(Callbacks const & callbacks, char const * method_name, size_t const & length) const {
+        if (method_name == nullptr) {
+            return RPC_METHOD_NOT_FOUND;
+        }
+        uint32_t const hash = Hash_Characters(method_name, length);
+
+        // Binary search for the first entry with an equal or bigger hash
+        size_t low = 0U;
+        size_t high = m_entries.size();
+        while (low < high) {
+            size_t const middle = low + ((high - low) / 2U);
+            if (m_entries[middle].hash < hash) {
+                low = middle + 1U;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        for (; low < m_entries.size() && m_entries[low].hash == hash; ++low) {
+            size_t const position = m_entries[low].position;
+            char const * subscribed_name = callbacks[position].Get_Name();
+            if (strncmp(subscribed_name, method_name, length) == 0 && subscribed_name[length] == '\0') {
+                return position;
+            }
+        }
+        return RPC_METHOD_NOT_FOUND;
+    }
+
+  private:
+    /// @brief Hash of a subscribed method name and the position of its callback
+    struct Method_Entry {
+        uint32_t hash = {};     // FNV-1a hash of the method name
+        size_t   position = {}; // Position of the callback in the subscribed callbacks
+    };
+
+    using Entry_Container = Container<Method_Entry>;
+
+    /// @brief Inserts the given entry into the index, while keeping the index sorted by hash
+    /// @note Entries with the same hash keep the order they were inserted in, so that the callback subscribed first is found first
+    /// @param entry Entry that should be inserted
+    void Insert_Sorted(Method_Entry const & entry) {
+        m_entries.push_back(entry);
+        for (size_t index = m_entries.size() - 1U; index > 0U; --index) {
+            auto & current = m_entries[index];
+            auto & previous = m_entries[index - 1U];
+            if (previous.hash <= current.hash) {
+                break;
+            }
+            Method_Entry const temporary = previous;
+            previous = current;
+            current = temporary;
+        }
+    }
+
+    Entry_Container m_entries = {}; // Hash and callback position of every subscribed method name, sorted by hash
+};
+
+#endif // RPC_Method_Index_h
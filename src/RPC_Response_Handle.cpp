@@ -0,0 +1,40 @@
+// Header include.
+#include "RPC_Response_Handle.h"
+
+// Local includes.
+#include "IRPC_Response_Queue.h"
+
+// Library includes.
+#include <stdio.h>
+
+RPC_Response_Handle::RPC_Response_Handle(IRPC_Response_Queue * response_queue, size_t const & slot, uint32_t const & ticket, size_t const & request_id)
+  : m_response_queue(response_queue)
+  , m_slot(slot)
+  , m_ticket(ticket)
+  , m_request_id(request_id)
+  , m_response_topic()
+{
+    (void)snprintf(m_response_topic, sizeof(m_response_topic), RPC_SEND_RESPONSE_TOPIC, request_id);
+}
+
+size_t const & RPC_Response_Handle::Get_Request_ID() const {
+    return m_request_id;
+}
+
+char const * RPC_Response_Handle::Get_Response_Topic() const {
+    return m_response_topic;
+}
+
+bool RPC_Response_Handle::Complete(JsonDocument const & response) const {
+    if (m_response_queue == nullptr) {
+        return false;
+    }
+    return m_response_queue->Complete(m_slot, m_ticket, response);
+}
+
+bool RPC_Response_Handle::Complete(char const * json) const {
+    if (m_response_queue == nullptr) {
+        return false;
+    }
+    return m_response_queue->Complete(m_slot, m_ticket, json);
+}
@@ -0,0 +1,72 @@
+#ifndef RPC_Response_Handle_h
+#define RPC_Response_Handle_h
+
+// Local includes.
+#include "Configuration.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// server-side RPC topics.
+char constexpr RPC_SEND_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/%u";
+
+
+// Forward declaration, because the queue has to know the handle and the handle has to know the queue
+class IRPC_Response_Queue;
+
+
+/// @brief Lightweight handle to a received server-side RPC request, whose response is not created in the subscribed callback itself, but later on from any task.
+/// See @ref Deferred_RPC_Callback for more information
+/// @note Only contains the id of the request, the response topic that has already been formatted with that id and the position of the reserved entry in the response queue.
+/// Can therefore be copied freely, for example into the message queue of the task that handles the request, which then calls @ref Complete once the response is known.
+/// Every request can only be completed once, further calls or calls after the request has timed out are simply ignored and return false
+class RPC_Response_Handle {
+  public:
+    /// @brief Constructs an empty handle, where completing the request always fails
+    RPC_Response_Handle() = default;
+
+    /// @brief Constructs the handle to a request that has reserved an entry in the given response queue
+    /// @param response_queue Non owning pointer to the queue the response is written into
+    /// @param slot Position of the entry reserved in the response queue
+    /// @param ticket Unique number the entry has been reserved with, ensures a handle of a previous request can not complete a later request that reuses the same entry
+    /// @param request_id Id the request was received with and the response has to be sent with
+    RPC_Response_Handle(IRPC_Response_Queue * response_queue, size_t const & slot, uint32_t const & ticket, size_t const & request_id);
+
+    /// @brief Gets the id the request was received with and the response has to be sent with
+    /// @return Id of the request
+    size_t const & Get_Request_ID() const;
+
+    /// @brief Gets the topic the response to the request is sent over
+    /// @return Non owning pointer to the response topic (v1/devices/me/rpc/response/$request_id), owned by this handle
+    char const * Get_Response_Topic() const;
+
+    /// @brief Serializes the given response into the response queue, so it is sent with the next call to @ref ThingsBoard::loop.
+    /// Is safe to call from any task if THINGSBOARD_ENABLE_STL is set, otherwise it has to be called from the same task that calls @ref ThingsBoard::loop
+    /// @param response Response that should be sent to the server, if it is null no response is sent and the request is simply finished.
+    /// See https://arduinojson.org/v7/api/jsondocument/ for more information on how to enter data into a JsonDocument
+    /// @return Whether the response has been written into the response queue, fails if the request has already been completed or timed out,
+    /// or if the serialized response is bigger than the maximum response size of the queue
+    bool Complete(JsonDocument const & response) const;
+
+    /// @brief Copies the given already serialized json response into the response queue, so it is sent with the next call to @ref ThingsBoard::loop.
+    /// Is safe to call from any task if THINGSBOARD_ENABLE_STL is set, otherwise it has to be called from the same task that calls @ref ThingsBoard::loop
+    /// @param json Non owning pointer to the serialized json response, does not need to be kept alive, because it is copied into the queue
+    /// @return Whether the response has been written into the response queue, fails if the request has already been completed or timed out,
+    /// or if the response is bigger than the maximum response size of the queue
+    bool Complete(char const * json) const;
+
+  private:
+    /// @brief Amount of bytes required for the response topic with the longest possible request id, the 20 digits of a 64 bit integer replace the format specifier
+    static size_t constexpr RESPONSE_TOPIC_SIZE = sizeof(RPC_SEND_RESPONSE_TOPIC) + 20U;
+
+    IRPC_Response_Queue *m_response_queue = {};                     // Queue the response is written into, nullptr if the handle is empty
+    size_t              m_slot = {};                                // Position of the reserved entry in the response queue
+    uint32_t            m_ticket = {};                              // Unique number the entry has been reserved with
+    size_t              m_request_id = {};                          // Id of the request
+    char                m_response_topic[RESPONSE_TOPIC_SIZE] = {}; // Response topic formatted with the id of the request
+};
+
+#endif // RPC_Response_Handle_h
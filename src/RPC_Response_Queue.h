@@ -0,0 +1,200 @@
+#ifndef RPC_Response_Queue_h
+#define RPC_Response_Queue_h
+
+// Local includes.
+#include "Helper.h"
+#include "IRPC_Response_Queue.h"
+
+// Library includes.
+#include <string.h>
+#if THINGSBOARD_ENABLE_STL
+#include <atomic>
+#endif // THINGSBOARD_ENABLE_STL
+
+
+// Response sent for deferred server-side RPC requests that have not been completed in time.
+char constexpr RPC_RESPONSE_TIMEOUT_ERROR[] = "{\"error\":\"RPC response timed out\"}";
+
+
+/// @brief Bounded queue of fixed-size entries, which holds the responses of deferred server-side RPC requests until they are sent in the @ref ThingsBoard::loop method,
+/// once the queue has been set with @ref Server_Side_RPC::Set_Response_Queue. See @ref Deferred_RPC_Callback for more information
+/// @note Every received deferred request reserves one entry, which is freed again once its response has been sent. If every entry is reserved, further requests are answered with an error response immediately instead.
+/// Completing a request only claims the reserved entry with a single atomic compare and exchange and then serializes the response into the entry, it never blocks, allocates or logs.
+/// The compare and exchange also decides the race between a completion and the timeout of the same request, whichever claims the entry first is sent and the other one is ignored.
+/// Every reservation receives a unique ticket, which prevents a handle of an already finished request from completing a later request that reuses the same entry.
+/// Entries are reserved on the task that receives the requests, which is the esp-mqtt task when using the Espressif_MQTT_Client and the task calling @ref ThingsBoard::loop otherwise.
+/// Reserving only ever claims free entries, which no other task writes, therefore it does not have to be synchronized with the completions or with the loop method.
+/// On targets without STL support the entry state is not accessed atomically, therefore requests have to be completed from the same task that calls @ref ThingsBoard::loop
+/// @tparam Capacity Maximum amount of deferred requests that can be pending at once, default = 4
+/// @tparam MaxResponseSize Maximum size of a serialized response including the null termination, every entry requires this amount of memory, default = 128
+template <size_t Capacity = 4U, size_t MaxResponseSize = 128U>
+class RPC_Response_Queue : public IRPC_Response_Queue {
+    static_assert(Capacity > 0U, "Response queue has to be able to hold atleast one request");
+    static_assert(MaxResponseSize >= sizeof(RPC_RESPONSE_TIMEOUT_ERROR), "Response size has to be big enough to hold the timeout error response");
+
+  public:
+    /// @brief Constructs an empty queue
+    RPC_Response_Queue() = default;
+
+    ~RPC_Response_Queue() override = default;
+
+    bool Reserve(size_t const & request_id, uint64_t const & timeout_milliseconds, RPC_Response_Handle & handle) override {
+        for (size_t slot = 0U; slot < Capacity; ++slot) {
+            Response_Entry & entry = m_entries[slot];
+            if (Get_Entry_State(Load(entry.state)) != Entry_State::FREE) {
+                continue;
+            }
+            m_ticket++;
+            entry.handle = RPC_Response_Handle(this, slot, m_ticket, request_id);
+            entry.deadline = timeout_milliseconds == 0U ? 0U : Helper::Get_Uptime_Milliseconds() + timeout_milliseconds;
+            entry.length = 0U;
+            // Only publish the entry once it has been written completely, completions are only accepted for pending entries
+            Store(entry.state, Combine(m_ticket, Entry_State::PENDING));
+            handle = entry.handle;
+            return true;
+        }
+        return false;
+    }
+
+    bool Complete(size_t const & slot, uint32_t const & ticket, JsonDocument const & response) override {
+        size_t const length = response.isNull() ? 0U : Helper::Measure_Json(response) - 1U;
+        if (slot >= Capacity || length >= MaxResponseSize) {
+            return false;
+        }
+        Response_Entry & entry = m_entries[slot];
+        if (!Compare_Exchange(entry.state, Combine(ticket, Entry_State::PENDING), Combine(ticket, Entry_State::WRITING))) {
+            return false;
+        }
+        entry.length = length == 0U ? 0U : serializeJson(response, entry.response, MaxResponseSize);
+        Store(entry.state, Combine(ticket, Entry_State::READY));
+        return true;
+    }
+
+    bool Complete(size_t const & slot, uint32_t const & ticket, char const * json) override {
+        size_t const length = json == nullptr ? 0U : strlen(json);
+        if (slot >= Capacity || length >= MaxResponseSize) {
+            return false;
+        }
+        Response_Entry & entry = m_entries[slot];
+        if (!Compare_Exchange(entry.state, Combine(ticket, Entry_State::PENDING), Combine(ticket, Entry_State::WRITING))) {
+            return false;
+        }
+        if (length != 0U) {
+            (void)memcpy(entry.response, json, length + 1U);
+        }
+        entry.length = length;
+        Store(entry.state, Combine(ticket, Entry_State::READY));
+        return true;
+    }
+
+    void Send_Completed(Callback<bool, char const * const, char const * const> const & send_json_string_callback) override {
+        uint64_t const current_time = Helper::Get_Uptime_Milliseconds();
+        for (auto & entry : m_entries) {
+            uint32_t state = Load(entry.state);
+            uint32_t const ticket = state >> ENTRY_STATE_BITS;
+            if (Get_Entry_State(state) == Entry_State::PENDING && entry.deadline != 0U && current_time >= entry.deadline
+              && Compare_Exchange(entry.state, state, Combine(ticket, Entry_State::WRITING))) {
+                (void)memcpy(entry.response, RPC_RESPONSE_TIMEOUT_ERROR, sizeof(RPC_RESPONSE_TIMEOUT_ERROR));
+                entry.length = strlen(RPC_RESPONSE_TIMEOUT_ERROR);
+                state = Combine(ticket, Entry_State::READY);
+                Store(entry.state, state);
+            }
+
+            if (Get_Entry_State(state) != Entry_State::READY) {
+                continue;
+            }
+            else if (entry.length != 0U && !send_json_string_callback.Call_Callback(entry.handle.Get_Response_Topic(), entry.response)) {
+                continue;
+            }
+            Store(entry.state, Combine(ticket, Entry_State::FREE));
+        }
+    }
+
+  private:
+    /// @brief Amount of bits the entry state is kept in, the remaining bits of the state contain the ticket the entry has been reserved with
+    static uint32_t constexpr ENTRY_STATE_BITS = 2U;
+
+#if THINGSBOARD_ENABLE_STL
+    using State = std::atomic<uint32_t>;
+#else
+    using State = uint32_t volatile;
+#endif // THINGSBOARD_ENABLE_STL
+
+    /// @brief Current state of an entry
+    enum class Entry_State : uint8_t {
+        FREE, ///< Entry can be reserved by the next received request
+        PENDING, ///< Entry has been reserved and waits for the request to be completed or to time out
+        WRITING, ///< Response is currently written into the entry, either by the completing task or by the timeout
+        READY ///< Response has been written completely and waits to be sent
+    };
+
+    /// @brief Entry of the queue, reserved for a single deferred request
+    struct Response_Entry {
+        State               state = {};                     // Ticket the entry has been reserved with, combined with the current entry state
+        RPC_Response_Handle handle = {};                    // Handle the entry has been reserved with, contains the formatted response topic
+        uint64_t            deadline = {};                  // Uptime in milliseconds the request times out at, 0 if it never times out
+        size_t              length = {};                    // Length of the written response, 0 if no response should be sent
+        char                response[MaxResponseSize] = {}; // Serialized json response
+    };
+
+    /// @brief Combines the given ticket and entry state into the value kept in the state of an entry
+    /// @param ticket Unique number the entry has been reserved with
+    /// @param entry_state Current state of the entry
+    /// @return Combined value
+    static uint32_t Combine(uint32_t const & ticket, Entry_State const & entry_state) {
+        return (ticket << ENTRY_STATE_BITS) | static_cast<uint32_t>(entry_state);
+    }
+
+    /// @brief Extracts the entry state from the given combined value
+    /// @param state Combined value kept in the state of an entry
+    /// @return Current state of the entry
+    static Entry_State Get_Entry_State(uint32_t const & state) {
+        return static_cast<Entry_State>(state & ((1U << ENTRY_STATE_BITS) - 1U));
+    }
+
+    /// @brief Reads the given entry state, all writes of the other side that happened before it stored the state are visible afterwards
+    /// @param state Entry state that should be read
+    /// @return Value of the entry state
+    static uint32_t Load(State const & state) {
+#if THINGSBOARD_ENABLE_STL
+        return state.load(std::memory_order_acquire);
+#else
+        return state;
+#endif // THINGSBOARD_ENABLE_STL
+    }
+
+    /// @brief Writes the given entry state, all previous writes are visible to the other side once it reads the state
+    /// @param state Entry state that should be written
+    /// @param value Value the entry state should be set to
+    static void Store(State & state, uint32_t const & value) {
+#if THINGSBOARD_ENABLE_STL
+        state.store(value, std::memory_order_release);
+#else
+        // Prevents the compiler from moving the writes of the entry after the write of the state
+        __sync_synchronize();
+        state = value;
+#endif // THINGSBOARD_ENABLE_STL
+    }
+
+    /// @brief Sets the given entry state to the desired value, but only if it still contains the expected value
+    /// @param state Entry state that should be written
+    /// @param expected Value the entry state is expected to contain
+    /// @param desired Value the entry state should be set to
+    /// @return Whether the entry state contained the expected value and has therefore been set
+    static bool Compare_Exchange(State & state, uint32_t expected, uint32_t const & desired) {
+#if THINGSBOARD_ENABLE_STL
+        return state.compare_exchange_strong(expected, desired, std::memory_order_acquire);
+#else
+        if (state != expected) {
+            return false;
+        }
+        state = desired;
+        return true;
+#endif // THINGSBOARD_ENABLE_STL
+    }
+
+    Response_Entry m_entries[Capacity] = {}; // Entries of the queue, one for every pending deferred request
+    uint32_t       m_ticket = {};            // Ticket the last entry has been reserved with, is only written when reserving an entry and therefore only by the task receiving the requests
+};
+
+#endif // RPC_Response_Queue_h
@@ -0,0 +1,56 @@
+#ifndef Raw_RPC_Callback_h
+#define Raw_RPC_Callback_h
+
+// Local includes.
+#include "Callback.h"
+
+// Library includes.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// @brief Raw server-side RPC callback wrapper, where the received request is not deserialized into a JsonDocument before the callback is called.
+/// Instead the callback receives the unserialized json payload of the request and the id the response has to be sent with, which allows to parse very big parameters, like lookup tables,
+/// with a custom streaming parser, without additionally requiring the memory for the complete JsonDocument. The response can then be sent with @ref Server_Side_RPC::RPC_Send_Response.
+/// Documentation about the specific use of Server-side RPC in ThingsBoard can be found here https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc
+/// @note The method name is found by only reading the start of the payload, which is expected to begin with the method key ({"method":"$method_name",...}), the same as the requests sent by ThingsBoard.
+/// Requests where that is not the case, as well as requests received as protobuf, are processed as json instead and therefore never reach the callback
+class Raw_RPC_Callback : public Callback<void, uint8_t *, size_t, size_t> {
+    public:
+        /// @brief Constructs empty callback, will result in never being called. Internals are simply default constructed as nullptr
+        Raw_RPC_Callback() = default;
+
+        /// @brief Constructs callback that will be called upon server-side RPC request arrival with the given method name
+        /// @param method_name Non owning pointer to the name we expect to be sent with the server-side RPC request so that this method callback will be executed.
+        /// Additionally it has to be kept alive by the user for the lifetime of this server-side RPC callback, otherwise the callback method will never be called
+        /// @param callback callback method that will be called upon data arrival with the complete unserialized json payload of the request, its length and the id of the request.
+        /// The payload is owned by the MQTT client and only valid for the scope of the callback, but can be modified, for example by deserializing it in zero copy mode.
+        /// If nullptr is passed the callback will never be called and no response is sent
+        Raw_RPC_Callback(char const * method_name, function callback)
+            : Callback(callback)
+            , m_method_name(method_name)
+        {
+                // Nothing to do
+        }
+
+        ~Raw_RPC_Callback() override = default;
+
+        /// @brief Gets the name we expect to be sent with the server-side RPC request so that this method callback will be executed
+        /// @return Non owning pointer to the name we expect to be sent with the server-side RPC request.
+        /// Owned by the user that passed it originally in the constructor or with the @ref Set_Name method
+        char const * Get_Name() const {
+                return m_method_name;
+        }
+
+        /// @brief Sets the name we expect to be sent with the server-side RPC request so that this method callback will be executed
+        /// @param method_name Non owning pointer to the name we expect to be sent with the server-side RPC request.
+        /// Additionally it has to be kept alive by the user for the lifetime of this server-side RPC callback, otherwise the callback method will never be called
+        void Set_Name(char const * method_name) {
+                m_method_name = method_name;
+        }
+
+    private:
+        char const *m_method_name = {}; // Method name
+};
+
+#endif // Raw_RPC_Callback_h
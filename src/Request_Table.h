@@ -0,0 +1,272 @@
+#ifndef Request_Table_h
+#define Request_Table_h
+
+// Local includes.
+#include "Callback.h"
+
+
+/// @brief Open addressing hash table, which keeps the pending single-event requests (client-side RPC, attribute request) keyed by the id they were sent with.
+/// Replaces the previous container, where every received response had to walk all pending requests to find the one with the same id and then erase it, which shifted every later request.
+/// @note The slot of a request is calculated from its id with a simple modulo, because request ids are increased by one for every sent request, which distributes consecutive requests over consecutive slots without collisions.
+/// Colliding requests are placed into the next free slot (linear probing) and removed requests leave a marker behind, so that requests placed after them can still be found without moving any element.
+/// Inserting, finding and removing a request therefore only accesses a single slot in most cases, independent of how many requests are pending.
+/// Once no request is pending anymore all markers are cleared at once. The address of a pending request never changes while it is pending, which is required because the timeout timer of the request keeps a pointer to it.
+/// Therefore requests are allocated on the heap if THINGSBOARD_ENABLE_DYNAMIC is set, which allows to grow the table once more requests are pending than it has slots, without moving the requests themselves.
+/// Otherwise the requests are kept directly in the slots of a fixed-size array, which never moves either
+/// @tparam T Type of the pending requests, has to be CopyAssignable and Default-Constructible
+#if THINGSBOARD_ENABLE_DYNAMIC
+template <typename T>
+#else
+/// @tparam Capacity Maximum amount of requests that can be pending at once, inserting more requests fails
+template <typename T, size_t Capacity>
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+class Request_Table {
+  public:
+    /// @brief Constructor
+    Request_Table() = default;
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    /// @brief Destructor
+    ~Request_Table() {
+        clear();
+    }
+
+    /// @brief Deleted copy constructor
+    /// @note Copying would result in two tables owning the same heap allocated requests, which would then be deleted twice. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Request_Table(Request_Table const & other) = delete;
+
+    /// @brief Deleted copy assignment operator
+    /// @note Copying would result in two tables owning the same heap allocated requests, which would then be deleted twice. Therefore copying is disabled alltogether
+    /// @param other Other instance we disallow copying from
+    Request_Table & operator=(Request_Table const & other) = delete;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    /// @brief Inserts a copy of the given request with the given id
+    /// @param request_id Id the request is sent with and the response will be received with
+    /// @param request Request that should be copied into the table
+    /// @return Non owning pointer to the copied request, which stays valid until the request is removed, or nullptr if the maximum amount of pending requests has been reached
+    T * Insert(size_t const & request_id, T const & request) {
+        if (m_size == m_slots.size() && !Grow()) {
+            return nullptr;
+        }
+        // Reuse the first removed slot on the probe sequence, but still ensure the id is not already pending further down the sequence
+        size_t insert_position = m_slots.size();
+        size_t position = request_id % m_slots.size();
+        for (size_t probe = 0U; probe < m_slots.size(); ++probe, position = (position + 1U) % m_slots.size()) {
+            Slot & slot = m_slots[position];
+            if (slot.state == Slot_State::EMPTY) {
+                insert_position = insert_position == m_slots.size() ? position : insert_position;
+                break;
+            }
+            else if (slot.state == Slot_State::REMOVED) {
+                insert_position = insert_position == m_slots.size() ? position : insert_position;
+            }
+            else if (slot.request_id == request_id) {
+                Get_Request(slot) = request;
+                return &Get_Request(slot);
+            }
+        }
+
+        Slot & slot = m_slots[insert_position];
+#if THINGSBOARD_ENABLE_DYNAMIC
+        slot.request = new T(request);
+#else
+        slot.request = request;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        slot.request_id = request_id;
+        slot.state = Slot_State::OCCUPIED;
+        m_size++;
+        return &Get_Request(slot);
+    }
+
+    /// @brief Searches for the pending request with the given id
+    /// @param request_id Id the response was received with
+    /// @return Non owning pointer to the pending request or nullptr if no request with the given id is pending
+    T * Find(size_t const & request_id) {
+        size_t const position = Find_Position(request_id);
+        return position != m_slots.size() ? &Get_Request(m_slots[position]) : nullptr;
+    }
+
+    /// @copydoc Request_Table::Find
+    T const * Find(size_t const & request_id) const {
+        size_t const position = Find_Position(request_id);
+        return position != m_slots.size() ? &Get_Request(m_slots[position]) : nullptr;
+    }
+
+    /// @brief Removes the pending request with the given id, without moving any other pending request
+    /// @param request_id Id of the request that should be removed
+    void Remove(size_t const & request_id) {
+        size_t const position = Find_Position(request_id);
+        if (position == m_slots.size()) {
+            return;
+        }
+        Slot & slot = m_slots[position];
+#if THINGSBOARD_ENABLE_DYNAMIC
+        delete slot.request;
+        slot.request = nullptr;
+#else
+        slot.request = T();
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        slot.state = Slot_State::REMOVED;
+        m_size--;
+        if (m_size == 0U) {
+            Clear_Markers();
+        }
+    }
+
+    /// @brief Removes all pending requests
+    void clear() {
+        for (auto & slot : m_slots) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+            delete slot.request;
+            slot.request = nullptr;
+#else
+            if (slot.state == Slot_State::OCCUPIED) {
+                slot.request = T();
+            }
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        }
+        m_size = 0U;
+        Clear_Markers();
+    }
+
+    /// @brief Whether no request is pending
+    /// @return Whether the table is empty
+    bool empty() const {
+        return m_size == 0U;
+    }
+
+    /// @brief Returns the amount of pending requests
+    /// @return Amount of pending requests
+    size_t const & size() const {
+        return m_size;
+    }
+
+    /// @brief Calls the given function for every pending request
+    /// @tparam Function Callable that receives a mutable reference to the pending request
+    /// @param function Function that will be called with every pending request
+    template <typename Function>
+    void For_Each(Function function) {
+        for (auto & slot : m_slots) {
+            if (slot.state == Slot_State::OCCUPIED) {
+                function(Get_Request(slot));
+            }
+        }
+    }
+
+  private:
+    /// @brief Current state of a slot
+    enum class Slot_State : uint8_t {
+        EMPTY, ///< Slot has never been used since the table was last empty, ends the probe sequence
+        OCCUPIED, ///< Slot contains a pending request
+        REMOVED ///< Slot contained a request that has been removed, does not end the probe sequence
+    };
+
+    /// @brief Slot of the table
+    struct Slot {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        T          *request = {};   // Heap allocated pending request, nullptr if the slot is not occupied
+#else
+        T          request = {};    // Pending request
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+        size_t     request_id = {}; // Id of the pending request
+        Slot_State state = {};      // Whether the slot is empty, occupied or contained a removed request
+    };
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    using Slot_Container = Container<Slot>;
+
+    /// @brief Initial amount of slots, allocated once the first request is inserted
+    static size_t constexpr INITIAL_SLOT_COUNT = 4U;
+#else
+    using Slot_Container = Container<Slot, Capacity>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
+    /// @brief Returns the request kept in the given slot
+    /// @param slot Occupied slot
+    /// @return Reference to the pending request
+    static T & Get_Request(Slot & slot) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return *slot.request;
+#else
+        return slot.request;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @copydoc Request_Table::Get_Request
+    static T const & Get_Request(Slot const & slot) {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        return *slot.request;
+#else
+        return slot.request;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    /// @brief Searches for the slot of the pending request with the given id
+    /// @param request_id Id of the request
+    /// @return Position of the slot or the amount of slots if no request with the given id is pending
+    size_t Find_Position(size_t const & request_id) const {
+        if (m_size == 0U) {
+            return m_slots.size();
+        }
+        size_t position = request_id % m_slots.size();
+        for (size_t probe = 0U; probe < m_slots.size(); ++probe, position = (position + 1U) % m_slots.size()) {
+            Slot const & slot = m_slots[position];
+            if (slot.state == Slot_State::EMPTY) {
+                break;
+            }
+            else if (slot.state == Slot_State::OCCUPIED && slot.request_id == request_id) {
+                return position;
+            }
+        }
+        return m_slots.size();
+    }
+
+    /// @brief Marks every slot as empty again, only allowed once no request is pending anymore
+    void Clear_Markers() {
+        for (auto & slot : m_slots) {
+            slot.state = Slot_State::EMPTY;
+        }
+    }
+
+    /// @brief Increases the amount of slots, because every slot is occupied
+    /// @return Whether growing was successful, always fails if THINGSBOARD_ENABLE_DYNAMIC is not set and every slot has already been allocated
+    bool Grow() {
+#if THINGSBOARD_ENABLE_DYNAMIC
+        // Only the pointers to the pending requests are moved into the new slots, the requests themselves keep their address.
+        // Grow is only called once every slot is occupied, therefore every previous slot is moved
+        Slot_Container previous_slots = {};
+        for (auto const & slot : m_slots) {
+            previous_slots.push_back(slot);
+        }
+        size_t const slot_count = previous_slots.empty() ? INITIAL_SLOT_COUNT : previous_slots.size() * 2U;
+        m_slots.clear();
+        for (size_t position = 0U; position < slot_count; ++position) {
+            m_slots.push_back(Slot());
+        }
+        for (auto const & previous_slot : previous_slots) {
+            size_t position = previous_slot.request_id % slot_count;
+            while (m_slots[position].state == Slot_State::OCCUPIED) {
+                position = (position + 1U) % slot_count;
+            }
+            m_slots[position] = previous_slot;
+        }
+        return true;
+#else
+        if (m_slots.size() == Capacity) {
+            return false;
+        }
+        // Allocates every slot at once, so that the modulo does not change while requests are pending
+        while (m_slots.size() < Capacity) {
+            m_slots.push_back(Slot());
+        }
+        return true;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+    }
+
+    Slot_Container m_slots = {}; // Slots of the table, the slot of a request is calculated from its id
+    size_t         m_size = {};  // Amount of pending requests
+};
+
+#endif // Request_Table_h
@@ -0,0 +1,154 @@
+#ifndef Sampling_Scheduler_h
+#define Sampling_Scheduler_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Callback.h"
+#include "Helper.h"
+
+
+/// @brief Scheduler that reads sensors with individual periods and phases and sends all readings that became due at the same time with a single publish.
+/// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+/// @note Replaces manual millis() checks around the @ref ThingsBoard::loop method. Each registered sensor has a nominal deadline every period milliseconds, offset by its phase.
+/// If a publish interval is given, the nominal deadlines are aligned to the next boundary of the publish window, meaning every sensor that becomes due within the same window is read at the end of that window
+/// and all readings are sent together. This results in only one radio wake-up and one completely filled message per window, instead of one partially filled message per sensor.
+/// Sensors with a period shorter than the publish interval are therefore read only once per window. The earliest upcoming deadline can be retrieved with @ref Get_Next_Deadline,
+/// which allows the application to sleep until the next sensor has to be read. Be aware that the keys and string values of the returned key-value pairs are not copied,
+/// therefore ensure they are kept alive until they have been sent, which is most easily achieved by using string literals
+/// @tparam Capacity Maximum amount of sensors that can be registered, allows to allocate the sensors and their readings on the stack instead of the heap, default = 8
+template <size_t Capacity = 8U>
+class Sampling_Scheduler {
+  public:
+    /// @brief Sensor read callback signature, returns the read key-value pair or an empty instance if the sensor could not be read
+    using Read_Callback = Callback<Telemetry>;
+
+    /// @brief Constructs a scheduler that sends over the given ThingsBoard instance
+    /// @param thingsboard ThingsBoard instance the readings are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param publish_interval_milliseconds Length of the publish window in milliseconds that deadlines are aligned to, starting with the construction of this instance.
+    /// 0 means that deadlines are not aligned and every sensor is read at its own deadline, default = 0
+    explicit Sampling_Scheduler(ThingsBoard & thingsboard, uint64_t const & publish_interval_milliseconds = 0U)
+      : m_thingsboard(thingsboard)
+      , m_publish_interval(publish_interval_milliseconds)
+      , m_start(Helper::Get_Uptime_Milliseconds())
+      , m_sensors()
+      , m_size(0U)
+      , m_readings()
+      , m_publishes(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Registers a sensor that is read with the given period and phase
+    /// @param callback Callback that reads the sensor and returns the key-value pair that should be sent
+    /// @param period_milliseconds Amount of milliseconds between two nominal deadlines of the sensor, is not allowed to be 0
+    /// @param phase_milliseconds Offset of the nominal deadlines relative to the construction of this instance, allows to spread sensors with the same period if deadlines are not aligned, default = 0
+    /// @return Whether registering the sensor was successful or not, fails if the period is 0 or Capacity sensors have already been registered
+    bool Register_Sensor(typename Read_Callback::function callback, uint64_t const & period_milliseconds, uint64_t const & phase_milliseconds = 0U) {
+        if (period_milliseconds == 0U || m_size == Capacity) {
+            return false;
+        }
+        Sensor & sensor = m_sensors[m_size++];
+        sensor.callback.Set_Callback(callback);
+        sensor.period = period_milliseconds;
+        sensor.nominal_deadline = m_start + phase_milliseconds;
+        Advance_Past(sensor, Helper::Get_Uptime_Milliseconds());
+        return true;
+    }
+
+    /// @brief Reads every sensor whose aligned deadline has passed and sends all readings with a single publish
+    /// @note Has to be called regularly, ideally with the same frequency as the @ref ThingsBoard::loop method and directly after waking up at the deadline returned by @ref Get_Next_Deadline.
+    /// Deadlines that were missed completely, for example because the device was asleep for longer, are skipped instead of being read multiple times in a row
+    /// @return Whether sending the readings was successful or not, true if no sensor was due
+    bool loop() {
+        uint64_t const now = Helper::Get_Uptime_Milliseconds();
+        size_t count = 0U;
+        for (size_t index = 0U; index < m_size; ++index) {
+            Sensor & sensor = m_sensors[index];
+            if (sensor.aligned_deadline > now) {
+                continue;
+            }
+            Telemetry const reading = sensor.callback.Call_Callback();
+            if (!reading.IsEmpty()) {
+                m_readings[count++] = reading;
+            }
+            Advance_Past(sensor, now);
+        }
+        if (count == 0U) {
+            return true;
+        }
+        Telemetry const * first = m_readings;
+        if (!m_thingsboard.Send_Telemetry(first, first + count)) {
+            return false;
+        }
+        m_publishes++;
+        return true;
+    }
+
+    /// @brief Returns the uptime in milliseconds the next sensor has to be read at, allows the application to sleep until then
+    /// @return Earliest aligned deadline of all registered sensors, UINT64_MAX if no sensor has been registered
+    uint64_t Get_Next_Deadline() const {
+        uint64_t next_deadline = UINT64_MAX;
+        for (size_t index = 0U; index < m_size; ++index) {
+            if (m_sensors[index].aligned_deadline < next_deadline) {
+                next_deadline = m_sensors[index].aligned_deadline;
+            }
+        }
+        return next_deadline;
+    }
+
+    /// @brief Returns the amount of milliseconds until the next sensor has to be read, allows to directly pass the value to a sleep or delay function
+    /// @return Amount of milliseconds until the earliest aligned deadline, 0 if it has already passed and UINT64_MAX if no sensor has been registered
+    uint64_t Get_Milliseconds_Until_Next_Deadline() const {
+        uint64_t const next_deadline = Get_Next_Deadline();
+        uint64_t const now = Helper::Get_Uptime_Milliseconds();
+        return next_deadline > now ? next_deadline - now : 0U;
+    }
+
+    /// @brief Returns the amount of publishes that have been executed by this scheduler
+    /// @return Amount of successful publishes
+    size_t const & Get_Publishes() const {
+        return m_publishes;
+    }
+
+  private:
+    /// @brief Registered sensor with its current deadlines
+    struct Sensor {
+        Read_Callback callback = {};         // Callback that reads the sensor
+        uint64_t      period = {};           // Amount of milliseconds between two nominal deadlines
+        uint64_t      nominal_deadline = {}; // Uptime in milliseconds the sensor would be read at without alignment
+        uint64_t      aligned_deadline = {}; // Uptime in milliseconds the sensor is actually read at, which is the nominal deadline moved to the next publish window boundary
+    };
+
+    /// @brief Advances the nominal deadline of the given sensor by whole periods until it lies after the given uptime and aligns it afterwards
+    /// @param sensor Sensor whose deadlines should be advanced
+    /// @param now Uptime in milliseconds the nominal deadline has to lie after
+    void Advance_Past(Sensor & sensor, uint64_t const & now) const {
+        if (sensor.nominal_deadline <= now) {
+            // Skip all missed periods at once, instead of reading the sensor for each of them
+            sensor.nominal_deadline += ((now - sensor.nominal_deadline) / sensor.period + 1U) * sensor.period;
+        }
+        sensor.aligned_deadline = Align_To_Window(sensor.nominal_deadline);
+    }
+
+    /// @brief Moves the given deadline to the next boundary of the publish window, so that every sensor that becomes due within the same window is read at the same time
+    /// @param deadline Nominal deadline in milliseconds
+    /// @return Aligned deadline in milliseconds, the nominal deadline itself if it already is a boundary or alignment is disabled
+    uint64_t Align_To_Window(uint64_t const & deadline) const {
+        if (m_publish_interval == 0U || deadline <= m_start) {
+            return deadline;
+        }
+        uint64_t const windows = (deadline - m_start + m_publish_interval - 1U) / m_publish_interval;
+        return m_start + windows * m_publish_interval;
+    }
+
+    ThingsBoard & m_thingsboard;              // ThingsBoard instance the readings are sent with
+    uint64_t      m_publish_interval = {};    // Length of the publish window in milliseconds, 0 if deadlines are not aligned
+    uint64_t      m_start = {};               // Uptime in milliseconds this instance was constructed at, the publish windows and phases start at
+    Sensor        m_sensors[Capacity] = {};   // Registered sensors
+    size_t        m_size = {};                // Amount of registered sensors
+    Telemetry     m_readings[Capacity] = {};  // Readings of all sensors that became due in the current call to loop
+    size_t        m_publishes = {};           // Amount of successful publishes
+};
+
+#endif // Sampling_Scheduler_h
@@ -3,14 +3,21 @@
 
 // Local includes.
 #include "RPC_Callback.h"
+#include "Deferred_RPC_Callback.h"
+#include "Raw_RPC_Callback.h"
+#include "RPC_Method_Index.h"
 #include "IAPI_Implementation.h"
+#include "IRPC_Response_Queue.h"
 
 
 // server-side RPC topics.
 char constexpr RPC_SUBSCRIBE_TOPIC[] = "v1/devices/me/rpc/request/+";
 char constexpr RPC_REQUEST_TOPIC[] = "v1/devices/me/rpc/request/";
-char constexpr RPC_SEND_RESPONSE_TOPIC[] = "v1/devices/me/rpc/response/%u";
+// Response sent for deferred server-side RPC requests that could not reserve an entry in the response queue.
+char constexpr RPC_RESPONSE_QUEUE_FULL_ERROR[] = "{\"error\":\"RPC response queue full\"}";
 // Log messages.
+char constexpr RPC_RESPONSE_QUEUE_FULL[] = "Deferred server-side RPC response queue is full or not set, rejected request (%u)";
+char constexpr RPC_TIMEOUT_WITHOUT_CLOCK[] = "Deferred server-side RPC method (%s) has a timeout, but no uptime clock is available to measure it, rejected subscription";
 #if THINGSBOARD_ENABLE_DEBUG
 char constexpr SERVER_RPC_METHOD_NULL[] = "Server-side RPC method name is NULL";
 char constexpr RPC_RESPONSE_NULL[] = "Response JsonDocument is NULL, skipping sending";
@@ -21,13 +28,27 @@ char constexpr CALLING_RPC_CB[] = "Calling subscribed callback for rpc with meth
 
 /// @brief Handles the internal implementation of the ThingsBoard server-side RPC API.
 /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
+/// @note Received method names are resolved to the subscribed callback with the given method index, which requires the method name to match exactly.
+/// Methods that can not respond immediately can instead be subscribed as a @ref Deferred_RPC_Callback, whose response is completed later on from any task and sent in the @ref ThingsBoard::loop method,
+/// which keeps slow requests from blocking the task that receives all other messages. Requests are first resolved with the normal callbacks and only afterwards with the deferred ones.
+/// Methods with very big parameters can instead be subscribed as a @ref Raw_RPC_Callback, whose requests are passed on before they are deserialized, which are resolved before any other callback
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
-template <typename Logger = DefaultLogger>
+/// @tparam Method_Index Index that resolves the received method name to the position of the subscribed callback, either the @ref RPC_Method_Index that is built at runtime
+/// or the @ref Static_RPC_Method_Index that is generated at compile time for a statically known set of method names, default = RPC_Method_Index
+template <typename Logger = DefaultLogger, typename Method_Index = RPC_Method_Index>
 class Server_Side_RPC : public IAPI_Implementation {
   public:
     /// @brief Constructor
     Server_Side_RPC() = default;
 
+    /// @brief Constructs the instance with the given method index, required for method indices that are not default constructible like the @ref Static_RPC_Method_Index
+    /// @param method_index Method index that is copied and resolves the received method names
+    explicit Server_Side_RPC(Method_Index const & method_index)
+      : m_method_index(method_index)
+    {
+        // Nothing to do
+    }
+
     ~Server_Side_RPC() override = default;
 
     /// @brief Subscribes multiple server-side RPC callbacks, that will be called if a request from the server for the method with the given name is received
@@ -47,7 +68,9 @@ class Server_Side_RPC : public IAPI_Implementation {
     bool RPC_Subscribe(InputIterator const & first, InputIterator const & last) {
         (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
         // Push back complete vector into our local m_rpc_callbacks vector.
+        size_t const position = m_rpc_callbacks.size();
         m_rpc_callbacks.insert(m_rpc_callbacks.end(), first, last);
+        m_method_index.Append(first, last, position);
         return true;
     }
 
@@ -63,15 +86,126 @@ class Server_Side_RPC : public IAPI_Implementation {
     bool RPC_Subscribe(RPC_Callback const & callback) {
         (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
         m_rpc_callbacks.push_back(callback);
+        m_method_index.Append(&callback, &callback + 1U, m_rpc_callbacks.size() - 1U);
+        return true;
+    }
+
+    /// @brief Subscribes multiple deferred server-side RPC callbacks, that will be called if a request from the server for the method with the given name is received
+    /// and can be completed later on from any task, see @ref Deferred_RPC_Callback for more information.
+    /// @note Can be called even if we are currently not connected to the cloud, the same as @ref RPC_Subscribe.
+    /// Received requests are only passed to the callbacks once a response queue has been set with @ref Set_Response_Queue, otherwise they are answered with an error response immediately.
+    /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether subscribing the given callbacks was successful or not, fails without subscribing any callback if one of them has a timeout that can not be measured on the current target
+    template<typename InputIterator>
+    bool Deferred_RPC_Subscribe(InputIterator const & first, InputIterator const & last) {
+        for (auto it = first; it != last; ++it) {
+            if (!Is_Timeout_Supported(*it)) {
+                return false;
+            }
+        }
+        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
+        size_t const position = m_deferred_rpc_callbacks.size();
+        m_deferred_rpc_callbacks.insert(m_deferred_rpc_callbacks.end(), first, last);
+        m_deferred_method_index.Append(first, last, position);
+        return true;
+    }
+
+    /// @brief Subscribes one deferred server-side RPC callback, that will be called if a request from the server for the method with the given name is received
+    /// and can be completed later on from any task, see @ref Deferred_RPC_Callback for more information.
+    /// @note Can be called even if we are currently not connected to the cloud, the same as @ref RPC_Subscribe.
+    /// Received requests are only passed to the callback once a response queue has been set with @ref Set_Response_Queue, otherwise they are answered with an error response immediately.
+    /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
+    /// @param callback Callback method that will be called
+    /// @return Whether subscribing the given callback was successful or not, fails if the callback has a timeout that can not be measured on the current target
+    bool Deferred_RPC_Subscribe(Deferred_RPC_Callback const & callback) {
+        if (!Is_Timeout_Supported(callback)) {
+            return false;
+        }
+        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
+        m_deferred_rpc_callbacks.push_back(callback);
+        m_deferred_method_index.Append(&callback, &callback + 1U, m_deferred_rpc_callbacks.size() - 1U);
         return true;
     }
 
+    /// @brief Subscribes multiple raw server-side RPC callbacks, that will be called with the unserialized json payload if a request from the server for the method with the given name is received,
+    /// see @ref Raw_RPC_Callback for more information.
+    /// @note Can be called even if we are currently not connected to the cloud, the same as @ref RPC_Subscribe.
+    /// Requests for these methods are never deserialized into a JsonDocument, the response can instead be sent with @ref RPC_Send_Response.
+    /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether subscribing the given callbacks was successful or not
+    template<typename InputIterator>
+    bool Raw_RPC_Subscribe(InputIterator const & first, InputIterator const & last) {
+        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
+        size_t const position = m_raw_rpc_callbacks.size();
+        m_raw_rpc_callbacks.insert(m_raw_rpc_callbacks.end(), first, last);
+        m_raw_method_index.Append(first, last, position);
+        return true;
+    }
+
+    /// @brief Subscribes one raw server-side RPC callback, that will be called with the unserialized json payload if a request from the server for the method with the given name is received,
+    /// see @ref Raw_RPC_Callback for more information.
+    /// @note Can be called even if we are currently not connected to the cloud, the same as @ref RPC_Subscribe.
+    /// Requests for this method are never deserialized into a JsonDocument, the response can instead be sent with @ref RPC_Send_Response.
+    /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
+    /// @param callback Callback method that will be called
+    /// @return Whether subscribing the given callback was successful or not
+    bool Raw_RPC_Subscribe(Raw_RPC_Callback const & callback) {
+        (void)m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
+        m_raw_rpc_callbacks.push_back(callback);
+        m_raw_method_index.Append(&callback, &callback + 1U, m_raw_rpc_callbacks.size() - 1U);
+        return true;
+    }
+
+    /// @brief Sends the given response to the server-side RPC request with the given id, is meant for requests received by a @ref Raw_RPC_Callback
+    /// @param request_id Id the request was received with, passed to the raw callback
+    /// @param response Response that should be sent to the server.
+    /// See https://arduinojson.org/v7/api/jsondocument/ for more information on how to enter data into a JsonDocument
+    /// @return Whether sending the response was successful or not
+    bool RPC_Send_Response(size_t const & request_id, JsonDocument const & response) {
+        char response_topic[Helper::Calculate_Print_Size(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
+        (void)snprintf(response_topic, sizeof(response_topic), RPC_SEND_RESPONSE_TOPIC, request_id);
+        return m_send_json_callback.Call_Callback(response_topic, response);
+    }
+
+    /// @brief Sends the given already serialized json response to the server-side RPC request with the given id, is meant for requests received by a @ref Raw_RPC_Callback
+    /// @param request_id Id the request was received with, passed to the raw callback
+    /// @param json Non owning pointer to the serialized json response, does not need to be kept alive, because it is only used for the scope of the method itself
+    /// @return Whether sending the response was successful or not
+    bool RPC_Send_Response(size_t const & request_id, char const * json) {
+        char response_topic[Helper::Calculate_Print_Size(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
+        (void)snprintf(response_topic, sizeof(response_topic), RPC_SEND_RESPONSE_TOPIC, request_id);
+        return m_send_json_string_callback.Call_Callback(response_topic, json);
+    }
+
+    /// @brief Sets the queue the responses of deferred server-side RPC requests are written into, until they are sent in the @ref ThingsBoard::loop method.
+    /// See @ref RPC_Response_Queue for more information
+    /// @param response_queue Non owning pointer to the queue that should be used, nullptr to answer every deferred request with an error response immediately.
+    /// Has to be kept alive as long as it is used by this instance, because only the pointer is kept and the handles of pending requests point to it as well
+    void Set_Response_Queue(IRPC_Response_Queue * response_queue) {
+        m_response_queue = response_queue;
+    }
+
     /// @brief Unsubcribes all server-side RPC callbacks.
     /// See https://thingsboard.io/docs/user-guide/rpc/#server-side-rpc for more information
     /// @return Whether unsubscribing all the previously subscribed callbacks
     /// and from the RPC topic, was successful or not
     bool RPC_Unsubscribe() {
         m_rpc_callbacks.clear();
+        m_method_index.Rebuild(m_rpc_callbacks.cbegin(), m_rpc_callbacks.cend());
+        m_deferred_rpc_callbacks.clear();
+        m_deferred_method_index.Rebuild(m_deferred_rpc_callbacks.cbegin(), m_deferred_rpc_callbacks.cend());
+        m_raw_rpc_callbacks.clear();
+        m_raw_method_index.Rebuild(m_raw_rpc_callbacks.cbegin(), m_raw_rpc_callbacks.cend());
         return m_unsubscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC);
     }
 
@@ -79,11 +213,35 @@ class Server_Side_RPC : public IAPI_Implementation {
         return API_Process_Type::JSON;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+    void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
         // Nothing to do
     }
 
-    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+    bool Process_Raw_Json_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
+        if (m_raw_rpc_callbacks.empty()) {
+            return false;
+        }
+        char const * received_method_name = nullptr;
+        size_t method_length = 0U;
+        if (!Read_Method_Name(payload, length, received_method_name, method_length)) {
+            return false;
+        }
+        // Resolved directly inside of the payload, because the method name is not null terminated and its length is controlled by the sender, which would make a copy on the stack unsafe
+        size_t const position = m_raw_method_index.Find(m_raw_rpc_callbacks, received_method_name, method_length);
+        if (position == RPC_METHOD_NOT_FOUND) {
+            return false;
+        }
+
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(CALLING_RPC_CB, m_raw_rpc_callbacks[position].Get_Name());
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(RPC_REQUEST_TOPIC));
+        m_raw_rpc_callbacks[position].Call_Callback(payload, length, request_id);
+        return true;
+    }
+
+    void Process_Json_Response(char const * topic, size_t const & topic_length, JsonDocument const & data) override {
         if (!data.containsKey(RPC_METHOD_KEY)) {
 #if THINGSBOARD_ENABLE_DEBUG
             Logger::printfln(SERVER_RPC_METHOD_NULL);
@@ -92,51 +250,60 @@ class Server_Side_RPC : public IAPI_Implementation {
         }
         char const * method_name = data[RPC_METHOD_KEY];
 
-#if THINGSBOARD_ENABLE_STL
-        auto it = std::find_if(m_rpc_callbacks.begin(), m_rpc_callbacks.end(), [&method_name](RPC_Callback const & rpc) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            return (!Helper::String_IsNull_Or_Empty(subscribedMethodName) && strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) == 0);
-        });
-        if (it != m_rpc_callbacks.end()) {
-            auto & rpc = *it;
-#else
-        for (auto const & rpc : m_rpc_callbacks) {
-            char const * subscribedMethodName = rpc.Get_Name();
-            if (Helper::String_IsNull_Or_Empty(subscribedMethodName) || strncmp(subscribedMethodName, method_name, strlen(subscribedMethodName)) != 0) {
-              continue;
-            }
-#endif // THINGSBOARD_ENABLE_STL
+        size_t const position = m_method_index.Find(m_rpc_callbacks, method_name);
+        if (position == RPC_METHOD_NOT_FOUND) {
+            Process_Deferred_Request(topic, topic_length, data, method_name);
+            return;
+        }
+        auto const & rpc = m_rpc_callbacks[position];
+
 #if THINGSBOARD_ENABLE_DEBUG
-            if (!data.containsKey(RPC_PARAMS_KEY)) {
-                Logger::printfln(NO_RPC_PARAMS_PASSED);
-            }
+        if (!data.containsKey(RPC_PARAMS_KEY)) {
+            Logger::printfln(NO_RPC_PARAMS_PASSED);
+        }
 #endif // THINGSBOARD_ENABLE_DEBUG
 
 #if THINGSBOARD_ENABLE_DEBUG
-            Logger::printfln(CALLING_RPC_CB, method_name);
+        Logger::printfln(CALLING_RPC_CB, method_name);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-            JsonVariantConst const param = data[RPC_PARAMS_KEY];
-            JsonDocument json_buffer;
-            rpc.Call_Callback(param, json_buffer);
+        JsonVariantConst const param = data[RPC_PARAMS_KEY];
+        JsonDocument json_buffer(Helper::Get_Json_Allocator(m_get_json_allocator_callback.Call_Callback()));
+        rpc.Call_Callback(param, json_buffer);
 
-            if (json_buffer.isNull()) {
+        if (json_buffer.isNull()) {
 #if THINGSBOARD_ENABLE_DEBUG
-                Logger::printfln(RPC_RESPONSE_NULL);
+            Logger::printfln(RPC_RESPONSE_NULL);
 #endif // THINGSBOARD_ENABLE_DEBUG
-                return;
-            }
+            return;
+        }
+
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(RPC_REQUEST_TOPIC));
+        (void)RPC_Send_Response(request_id, json_buffer);
+    }
 
-            auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, strlen(RPC_REQUEST_TOPIC));
-            char responseTopic[Helper::Calculate_Print_Size(RPC_SEND_RESPONSE_TOPIC, request_id)] = {};
-            (void)snprintf(responseTopic, sizeof(responseTopic), RPC_SEND_RESPONSE_TOPIC, request_id);
-            (void)m_send_json_callback.Call_Callback(responseTopic, json_buffer);
+    void Process_Deferred() override {
+        if (m_response_queue == nullptr) {
             return;
         }
+        m_response_queue->Send_Completed(m_send_json_string_callback);
+    }
+
+    JsonDocument const * Get_Deserialization_Filter(char const * topic, size_t const & topic_length) override {
+        // Parameters are passed to the callback as a whole, because their content depends on the called method. The read keys never change, therefore the filter is only built once
+        if (m_deserialization_filter.isNull()) {
+            m_deserialization_filter[RPC_METHOD_KEY] = true;
+            m_deserialization_filter[RPC_PARAMS_KEY] = true;
+        }
+        return &m_deserialization_filter;
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(RPC_REQUEST_TOPIC, topic, strlen(RPC_REQUEST_TOPIC)) == 0;
+    bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+        return Helper::Topic_Starts_With(topic, topic_length, RPC_REQUEST_TOPIC, strlen(RPC_REQUEST_TOPIC));
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return RPC_REQUEST_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -144,7 +311,7 @@ class Server_Side_RPC : public IAPI_Implementation {
     }
 
     bool Resubscribe_Permanent_Subscriptions() override {
-        if (!m_rpc_callbacks.empty() && !m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC)) {
+        if ((!m_rpc_callbacks.empty() || !m_deferred_rpc_callbacks.empty() || !m_raw_rpc_callbacks.empty()) && !m_subscribe_topic_callback.Call_Callback(RPC_SUBSCRIBE_TOPIC)) {
             Logger::printfln(SUBSCRIBE_TOPIC_FAILED, RPC_SUBSCRIBE_TOPIC);
             return false;
         }
@@ -161,19 +328,131 @@ class Server_Side_RPC : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
         m_send_json_callback.Set_Callback(send_json_callback);
+        m_send_json_string_callback.Set_Callback(send_json_string_callback);
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
+        m_get_json_allocator_callback.Set_Callback(get_json_allocator_callback);
     }
 
   private:
     using Callback_Container = Container<RPC_Callback>;
+    using Deferred_Callback_Container = Container<Deferred_RPC_Callback>;
+    using Raw_Callback_Container = Container<Raw_RPC_Callback>;
+
+    /// @brief Reads the method name from the start of the given unserialized json request, without deserializing it
+    /// @note Only succeeds if the method key is the first key of the request ({"method":"$method_name",...}), which is the case for every request sent by ThingsBoard.
+    /// Method names containing escaped characters are not supported, because they would have to be unescaped first
+    /// @param payload Non owning pointer to the unserialized json request
+    /// @param length Total length of the request
+    /// @param method_name Set to the first character of the method name inside of the payload, the method name is therefore not null terminated
+    /// @param method_length Set to the amount of characters in the method name
+    /// @return Whether the request started with the method key followed by a method name
+    static bool Read_Method_Name(uint8_t const * payload, size_t const & length, char const * & method_name, size_t & method_length) {
+        size_t position = 0U;
+        size_t const key_length = strlen(RPC_METHOD_KEY);
+        if (!Consume_Character(payload, length, position, '{') || !Consume_Character(payload, length, position, '"')) {
+            return false;
+        }
+        else if (length - position <= key_length || memcmp(payload + position, RPC_METHOD_KEY, key_length) != 0 || payload[position + key_length] != '"') {
+            return false;
+        }
+        position += key_length + 1U;
+        if (!Consume_Character(payload, length, position, ':') || !Consume_Character(payload, length, position, '"')) {
+            return false;
+        }
+
+        for (size_t end = position; end < length; ++end) {
+            if (payload[end] == '\\') {
+                return false;
+            }
+            else if (payload[end] == '"') {
+                method_name = reinterpret_cast<char const *>(payload + position);
+                method_length = end - position;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Skips any whitespace at the given position of the unserialized json and then reads the given character
+    /// @param payload Non owning pointer to the unserialized json
+    /// @param length Total length of the unserialized json
+    /// @param position Position the reading starts at, is set directly after the read character if it was found
+    /// @param expected Character that is expected to follow after the whitespace
+    /// @return Whether the expected character directly followed after the whitespace
+    static bool Consume_Character(uint8_t const * payload, size_t const & length, size_t & position, char const & expected) {
+        for (; position < length; ++position) {
+            char const current = static_cast<char>(payload[position]);
+            if (current == ' ' || current == '\t' || current == '\r' || current == '\n') {
+                continue;
+            }
+            else if (current != expected) {
+                return false;
+            }
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Checks whether the timeout of the given deferred callback can be measured on the current target
+    /// @note Without an uptime clock the timeout would never expire, which would keep the entry in the response queue reserved forever if the request is never completed
+    /// @param callback Deferred callback whose timeout should be checked
+    /// @return Whether the callback has no timeout or an uptime clock is available
+    bool Is_Timeout_Supported(Deferred_RPC_Callback const & callback) const {
+        if (Helper::Has_Uptime_Clock() || callback.Get_Timeout() == 0U) {
+            return true;
+        }
+        Logger::printfln(RPC_TIMEOUT_WITHOUT_CLOCK, callback.Get_Name());
+        return false;
+    }
+
+    /// @brief Reserves an entry in the response queue for the received request and passes the handle to the deferred callback subscribed for the given method name
+    /// @note If no entry could be reserved the request is answered with an error response immediately, instead of letting the server wait for a response that is never sent
+    /// @param topic Non owning pointer to the topic the request was received over, contains the request id
+    /// @param topic_length Amount of characters in the received topic
+    /// @param data Payload sent by the server, contains the parameters of the request
+    /// @param method_name Non owning pointer to the received method name
+    void Process_Deferred_Request(char const * topic, size_t const & topic_length, JsonDocument const & data, char const * method_name) {
+        size_t const position = m_deferred_method_index.Find(m_deferred_rpc_callbacks, method_name);
+        if (position == RPC_METHOD_NOT_FOUND) {
+            return;
+        }
+        auto const & rpc = m_deferred_rpc_callbacks[position];
+        auto const request_id = Helper::Split_Topic_Into_Request_ID(topic, topic_length, strlen(RPC_REQUEST_TOPIC));
+
+        RPC_Response_Handle handle = {};
+        if (m_response_queue == nullptr || !m_response_queue->Reserve(request_id, rpc.Get_Timeout(), handle)) {
+            Logger::printfln(RPC_RESPONSE_QUEUE_FULL, request_id);
+            RPC_Response_Handle const rejected_handle(nullptr, 0U, 0U, request_id);
+            (void)m_send_json_string_callback.Call_Callback(rejected_handle.Get_Response_Topic(), RPC_RESPONSE_QUEUE_FULL_ERROR);
+            return;
+        }
+
+#if THINGSBOARD_ENABLE_DEBUG
+        Logger::printfln(CALLING_RPC_CB, method_name);
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+        // Parameters reference the response arena, which is reset once this message has been processed, therefore the callback has to copy what it still needs before returning
+        JsonVariantConst const param = data[RPC_PARAMS_KEY];
+        rpc.Call_Callback(param, handle);
+    }
 
-    Callback<bool, char const * const, JsonDocument const &> m_send_json_callback = {};         // Send json document callback
-    Callback<bool, char const * const>                       m_subscribe_topic_callback = {};   // Subscribe mqtt topic client callback
-    Callback<bool, char const * const>                       m_unsubscribe_topic_callback = {}; // Unubscribe mqtt topic client callback
-    Callback_Container                                       m_rpc_callbacks = {};              // server-side RPC callbacks array
+    Callback<bool, char const * const, JsonDocument const &> m_send_json_callback = {};          // Send json document callback
+    Callback<bool, char const * const, char const * const>   m_send_json_string_callback = {};   // Send json string callback
+    Callback<bool, char const * const>                       m_subscribe_topic_callback = {};    // Subscribe mqtt topic client callback
+    Callback<bool, char const * const>                       m_unsubscribe_topic_callback = {};  // Unubscribe mqtt topic client callback
+    Callback<ArduinoJson::Allocator *>                       m_get_json_allocator_callback = {}; // Get send json allocator callback
+    Callback_Container                                       m_rpc_callbacks = {};               // server-side RPC callbacks array
+    Method_Index                                             m_method_index = {};                // Index that resolves the received method name to the position of the subscribed callback
+    Deferred_Callback_Container                              m_deferred_rpc_callbacks = {};      // Deferred server-side RPC callbacks array
+    RPC_Method_Index                                         m_deferred_method_index = {};       // Index that resolves the received method name to the position of the subscribed deferred callback
+    Raw_Callback_Container                                   m_raw_rpc_callbacks = {};           // Raw server-side RPC callbacks array
+    RPC_Method_Index                                         m_raw_method_index = {};            // Index that resolves the received method name to the position of the subscribed raw callback
+    IRPC_Response_Queue                                      *m_response_queue = {};             // Queue the responses of deferred requests are written into, nullptr if deferred requests are rejected
+    JsonDocument                                             m_deserialization_filter = {};      // Filter containing the method name and the parameters, built once the first request is received
 };
 
 #endif // Server_Side_RPC_h
\ No newline at end of file
@@ -14,6 +14,9 @@ char constexpr SHARED_ATTRIBUTE_UPDATE_SUBSCRIPTIONS[] = "shared attribute updat
 
 /// @brief Handles the internal implementation of the ThingsBoard shared Attribute Update API.
 /// See https://thingsboard.io/docs/reference/mqtt-api/#subscribe-to-attribute-updates-from-the-server for more information
+/// @note Keeps an inverted index from every subscribed attribute key to the callbacks that subscribed it, sorted by key, where only the keys of newly subscribed callbacks are inserted.
+/// A received update is therefore handled with a single pass over its key-value pairs, where each key is searched in the index with a binary search,
+/// instead of checking every subscribed key of every callback against the received update. Each interested callback is called atmost once per update, in the order the callbacks were subscribed in
 /// @tparam Logger Implementation that should be used to print error messages generated by internal processes and additional debugging messages if THINGSBOARD_ENABLE_DEBUG is set, default = DefaultLogger
 #if THINGSBOARD_ENABLE_DYNAMIC
 template <typename Logger = DefaultLogger>
@@ -32,6 +35,20 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     using Callback_Container = Container<Callback_Value, MaxSubscriptions>;
 #endif // THINGSBOARD_ENABLE_DYNAMIC
 
+    /// @brief Entry of the inverted index, which maps a subscribed attribute key to the callback that subscribed it
+    struct Key_Entry {
+        char const *key = {};      // Non owning pointer to the subscribed attribute key, owned by the callback
+        size_t     position = {};  // Position of the subscribing callback in the subscribed callbacks
+    };
+
+#if THINGSBOARD_ENABLE_DYNAMIC
+    using Key_Container = Container<Key_Entry>;
+    using Flag_Container = Container<bool>;
+#else
+    using Key_Container = Container<Key_Entry, MaxSubscriptions * MaxAttributes>;
+    using Flag_Container = Container<bool, MaxSubscriptions>;
+#endif // THINGSBOARD_ENABLE_DYNAMIC
+
   public:
     /// @brief Constructor
     Shared_Attribute_Update() = default;
@@ -62,7 +79,9 @@ class Shared_Attribute_Update : public IAPI_Implementation {
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
         (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
         // Push back complete vector into our local m_shared_attribute_update_callbacks vector.
+        size_t const position = m_shared_attribute_update_callbacks.size();
         m_shared_attribute_update_callbacks.insert(m_shared_attribute_update_callbacks.end(), first, last);
+        Append_Key_Index(position);
         return true;
     }
 
@@ -84,6 +103,7 @@ class Shared_Attribute_Update : public IAPI_Implementation {
 #endif // !THINGSBOARD_ENABLE_DYNAMIC
         (void)m_subscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
         m_shared_attribute_update_callbacks.push_back(callback);
+        Append_Key_Index(m_shared_attribute_update_callbacks.size() - 1U);
         return true;
     }
 
@@ -93,6 +113,10 @@ class Shared_Attribute_Update : public IAPI_Implementation {
     /// and from the attribute topic, was successful or not
     bool Shared_Attributes_Unsubscribe() {
         m_shared_attribute_update_callbacks.clear();
+        m_key_index.clear();
+        m_notified_callbacks.clear();
+        m_deserialization_filter.clear();
+        m_requires_complete_payload = false;
         return m_unsubscribe_topic_callback.Call_Callback(ATTRIBUTE_TOPIC);
     }
 
@@ -100,63 +124,41 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         return API_Process_Type::JSON;
     }
 
-    void Process_Response(char const * topic, uint8_t * payload, uint32_t length) override {
+    void Process_Response(char const * topic, size_t const & topic_length, uint8_t * payload, uint32_t length) override {
         // Nothing to do
     }
 
-    void Process_Json_Response(char const * topic, JsonDocument const & data) override {
+    void Process_Json_Response(char const * topic, size_t const & topic_length, JsonDocument const & data) override {
         JsonObjectConst object = data.template as<JsonObjectConst>();
         if (object.containsKey(SHARED_RESPONSE_KEY)) {
             object = object[SHARED_RESPONSE_KEY];
         }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-        auto filtered_shared_attribute_update_callbacks = m_shared_attribute_update_callbacks | std::views::filter([&object](Callback_Value const & shared_attribute) {
-#else
-        Callback_Container filtered_shared_attribute_update_callbacks = {};
-        std::copy_if(m_shared_attribute_update_callbacks.begin(), m_shared_attribute_update_callbacks.end(), std::back_inserter(filtered_shared_attribute_update_callbacks), [&object](Callback_Value const & shared_attribute) {
-#endif // THINGSBOARD_ENABLE_CXX20
-            return (shared_attribute.Get_Attributes().empty() || std::find_if(shared_attribute.Get_Attributes().begin(), shared_attribute.Get_Attributes().end(), [&object](const char * att) {
-                return object.containsKey(att);
-            }) != shared_attribute.Get_Attributes().end());
-        });
-
-        for (auto const & shared_attribute : filtered_shared_attribute_update_callbacks) {
-#else
-        for (auto const & shared_attribute : m_shared_attribute_update_callbacks) {
-            if (shared_attribute.Get_Attributes().empty()) {
-                // No specifc keys were subscribed so we call the callback anyway, assumed to be subscribed to every shared attribute update
-                shared_attribute.Call_Callback(object);
-                continue;
-            }
-
-            char const * requested_att = nullptr;
-
-            for (auto const & att : shared_attribute.Get_Attributes()) {
-                if (Helper::String_IsNull_Or_Empty(att)) {
-                    continue;
-                }
-                // Check if the shared attribute update contains any of our subscribed keys and break early if they do,
-                // because we want to receive every update that chagned atleast one of our subscribed keys
-                if (object.containsKey(att)) {
-                    requested_att = att;
-                    break;
-                }
-            }
+        // Callbacks without any specific keys are assumed to be subscribed to every shared attribute update
+        for (size_t position = 0U; position < m_shared_attribute_update_callbacks.size(); ++position) {
+            m_notified_callbacks[position] = m_shared_attribute_update_callbacks[position].Get_Attributes().empty();
+        }
+        for (JsonPairConst const pair : object) {
+            Mark_Subscribers(pair.key().c_str());
+        }
 
-            // Check if the shared attribute update contained any of our subscribed keys.
-            // Do not inform the callback if it did not
-            if (requested_att == nullptr) {
-                continue;
+        for (size_t position = 0U; position < m_shared_attribute_update_callbacks.size(); ++position) {
+            if (m_notified_callbacks[position]) {
+                m_shared_attribute_update_callbacks[position].Call_Callback(object);
             }
-#endif // THINGSBOARD_ENABLE_STL
-            shared_attribute.Call_Callback(object);
         }
     }
 
-    bool Is_Response_Topic_Matching(char const * topic) const override {
-        return strncmp(ATTRIBUTE_TOPIC, topic, strlen(ATTRIBUTE_TOPIC) + 1) == 0;
+    JsonDocument const * Get_Deserialization_Filter(char const * topic, size_t const & topic_length) override {
+        return m_requires_complete_payload ? nullptr : &m_deserialization_filter;
+    }
+
+    bool Is_Response_Topic_Matching(char const * topic, size_t const & topic_length) const override {
+        return topic_length == strlen(ATTRIBUTE_TOPIC) && Helper::Topic_Starts_With(topic, topic_length, ATTRIBUTE_TOPIC, topic_length);
+    }
+
+    char const * Get_Response_Topic_Prefix() const override {
+        return ATTRIBUTE_TOPIC;
     }
 
     bool Unsubscribe() override {
@@ -181,15 +183,83 @@ class Shared_Attribute_Update : public IAPI_Implementation {
         // Nothing to do
     }
 
-    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback) override {
+    void Set_Client_Callbacks(Callback<void, IAPI_Implementation &>::function subscribe_api_callback, Callback<bool, char const * const, JsonDocument const &>::function send_json_callback, Callback<bool, char const * const, char const * const>::function send_json_string_callback, Callback<bool, char const * const>::function subscribe_topic_callback, Callback<bool, char const * const>::function unsubscribe_topic_callback, Callback<uint16_t>::function get_receive_size_callback, Callback<uint16_t>::function get_send_size_callback, Callback<bool, uint16_t, uint16_t>::function set_buffer_size_callback, Callback<size_t *>::function get_request_id_callback, Callback<ArduinoJson::Allocator *>::function get_json_allocator_callback) override {
         m_subscribe_topic_callback.Set_Callback(subscribe_topic_callback);
         m_unsubscribe_topic_callback.Set_Callback(unsubscribe_topic_callback);
     }
 
   private:
+    /// @brief Inserts the subscribed keys of the callbacks that have been appended to the end of the subscribed callbacks into the inverted index and the deserialization filter
+    /// @note Entries of previously subscribed callbacks are kept, because appending callbacks does not change their position.
+    /// Simple insertion sort step per new key, which only moves the entries with a bigger key and is only done when callbacks are subscribed and not when updates are received.
+    /// Keys are expected to be nested inside of the shared key, but are added to the root of the filter as well, because the nested object is only read if it exists
+    /// @param first_position Position of the first appended callback in the subscribed callbacks
+    void Append_Key_Index(size_t const & first_position) {
+        for (size_t position = first_position; position < m_shared_attribute_update_callbacks.size(); ++position) {
+            m_notified_callbacks.push_back(false);
+            auto const & attributes = m_shared_attribute_update_callbacks[position].Get_Attributes();
+            // Callbacks without any specific keys are assumed to be subscribed to every shared attribute update and therefore require the complete payload
+            m_requires_complete_payload = m_requires_complete_payload || attributes.empty();
+            for (auto const & att : attributes) {
+                if (Helper::String_IsNull_Or_Empty(att)) {
+                    continue;
+                }
+                Key_Entry entry = {};
+                entry.key = att;
+                entry.position = position;
+                Insert_Sorted(entry);
+                m_deserialization_filter[att] = true;
+                m_deserialization_filter[SHARED_RESPONSE_KEY][att] = true;
+            }
+        }
+    }
+
+    /// @brief Inserts the given entry into the inverted index, while keeping the index sorted by key
+    /// @param entry Entry that should be inserted
+    void Insert_Sorted(Key_Entry const & entry) {
+        m_key_index.push_back(entry);
+        for (size_t index = m_key_index.size() - 1U; index > 0U; --index) {
+            auto & current = m_key_index[index];
+            auto & previous = m_key_index[index - 1U];
+            if (strcmp(previous.key, current.key) <= 0) {
+                break;
+            }
+            Key_Entry const temporary = previous;
+            previous = current;
+            current = temporary;
+        }
+    }
+
+    /// @brief Marks every callback that subscribed the given key, so that it is called once all received keys have been checked
+    /// @param key Non owning pointer to the received attribute key
+    void Mark_Subscribers(char const * key) {
+        if (key == nullptr) {
+            return;
+        }
+        // Binary search for the first entry with an equal or bigger key
+        size_t low = 0U;
+        size_t high = m_key_index.size();
+        while (low < high) {
+            size_t const middle = low + ((high - low) / 2U);
+            if (strcmp(m_key_index[middle].key, key) < 0) {
+                low = middle + 1U;
+            }
+            else {
+                high = middle;
+            }
+        }
+        for (; low < m_key_index.size() && strcmp(m_key_index[low].key, key) == 0; ++low) {
+            m_notified_callbacks[m_key_index[low].position] = true;
+        }
+    }
+
     Callback<bool, char const * const>                                       m_subscribe_topic_callback = {};          // Subscribe mqtt topic client callback
     Callback<bool, char const * const>                                       m_unsubscribe_topic_callback = {};        // Unubscribe mqtt topic client callback
     Callback_Container                                                       m_shared_attribute_update_callbacks = {}; // Shared attribute update callbacks array
+    Key_Container                                                            m_key_index = {};                         // Inverted index from every subscribed key to the subscribing callback, sorted by key
+    Flag_Container                                                           m_notified_callbacks = {};                // Whether the callback at the same position is called for the currently handled update
+    JsonDocument                                                             m_deserialization_filter = {};            // Filter containing every subscribed key, extended whenever callbacks are subscribed
+    bool                                                                     m_requires_complete_payload = {};         // Whether any callback is subscribed to every shared attribute update, which disables filtering
 };
 
 #endif // Shared_Attribute_Update_h
@@ -0,0 +1,191 @@
+#ifndef Static_RPC_Method_Index_h
+#define Static_RPC_Method_Index_h
+
+// Local includes.
+#include "RPC_Method_Index.h"
+
+
+/// @brief Maximum displacement seed that is attempted for a single bucket, before the method names are considered impossible to separate, which is only the case if a method name is contained twice
+uint32_t constexpr MAX_PERFECT_HASH_SEED = 0xFFFFU;
+
+
+/// @brief Called if no perfect hash could be generated for the given method names, is intentionally not constexpr,
+/// so that calling it while the table is generated at compile time results in a compile error instead
+inline void Duplicate_RPC_Method_Name() {
+    // Nothing to do
+}
+
+
+/// @brief Perfect-hash index over a statically known set of server-side RPC method names, which can be generated completely at compile time.
+/// Alternative to the @ref RPC_Method_Index, that can be passed as the method index of the @ref Server_Side_RPC if all method names are known when the firmware is compiled.
+/// @note Uses the hash and displace scheme, every method name is first assigned to one of MethodCount buckets and then every bucket, starting with the one containing the most method names,
+/// searches for the smallest seed that moves all its method names into still unused slots of a table with twice as many slots as method names. Looking up a method name therefore always requires exactly two hashes
+/// and a single string comparison, independent of how many method names are contained and without any collision handling at runtime.
+/// The table is generated at compile time if the instance is declared constexpr, which requires the method names to be a constexpr array as well. Containing the same method name twice results in a compile error.
+/// Callbacks are assigned to the slot of their method name once they are subscribed, callbacks with a method name that is not contained in the static set can never be called
+/// @tparam MethodCount Amount of statically known method names
+template <size_t MethodCount>
+class Static_RPC_Method_Index {
+    static_assert(MethodCount > 0U, "Static method index has to contain atleast one method name");
+
+  public:
+    /// @brief Generates the perfect-hash table for the given method names, is executed at compile time if the instance is declared constexpr
+    /// @param method_names Array of non owning pointers to every method name.
+    /// Has to be kept alive as long as the instance of this class, because only the pointers are kept, which is most easily achieved by using string literals
+    explicit constexpr Static_RPC_Method_Index(char const * const (&method_names)[MethodCount])
+      : m_method_names()
+      , m_seeds()
+      , m_slots()
+      , m_positions()
+    {
+        for (size_t index = 0U; index < MethodCount; ++index) {
+            m_method_names[index] = method_names[index];
+        }
+        for (size_t slot = 0U; slot < SLOT_COUNT; ++slot) {
+            m_slots[slot] = EMPTY_SLOT;
+            m_positions[slot] = RPC_METHOD_NOT_FOUND;
+        }
+
+        // Buckets containing more method names are placed first, because they are the hardest to place once most slots are already used
+        size_t bucket_sizes[BUCKET_COUNT] = {};
+        size_t maximum_bucket_size = 0U;
+        for (size_t index = 0U; index < MethodCount; ++index) {
+            size_t & bucket_size = bucket_sizes[Get_Bucket(method_names[index])];
+            bucket_size++;
+            maximum_bucket_size = bucket_size > maximum_bucket_size ? bucket_size : maximum_bucket_size;
+        }
+
+        for (size_t size = maximum_bucket_size; size > 0U; --size) {
+            for (size_t bucket = 0U; bucket < BUCKET_COUNT; ++bucket) {
+                if (bucket_sizes[bucket] == size) {
+                    Place_Bucket(bucket);
+                }
+            }
+        }
+    }
+
+    /// @brief Assigns the given callbacks to the slot of their method name
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    template <typename InputIterator>
+    void Rebuild(InputIterator const & first, InputIterator const & last) {
+        for (size_t slot = 0U; slot < SLOT_COUNT; ++slot) {
+            m_positions[slot] = RPC_METHOD_NOT_FOUND;
+        }
+        Append(first, last, 0U);
+    }
+
+    /// @brief Assigns the given callbacks, that have been appended to the end of the subscribed callbacks, to the slot of their method name
+    /// @note Slots that already have a callback assigned are kept, so that the callback subscribed first for the same method name is the one that is found
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first appended callback
+    /// @param last Iterator pointing to the end of the appended callbacks (last element + 1)
+    /// @param position Position of the first appended callback in the subscribed callbacks
+    template <typename InputIterator>
+    void Append(InputIterator const & first, InputIterator const & last, size_t position) {
+        for (auto it = first; it != last; ++it, ++position) {
+            size_t const slot = Find_Slot(it->Get_Name());
+            if (slot != SLOT_COUNT && m_positions[slot] == RPC_METHOD_NOT_FOUND) {
+                m_positions[slot] = position;
+            }
+        }
+    }
+
+    /// @brief Searches for the callback subscribed for the given method name
+    /// @tparam Callbacks Container of the subscribed callbacks, that has been passed to @ref Rebuild and @ref Append
+    /// @param callbacks Subscribed callbacks, unused because the method name has already been compared with the statically known one
+    /// @param method_name Non owning pointer to the received method name
+    /// @return Position of the subscribed callback or RPC_METHOD_NOT_FOUND if the method name is not statically known or no callback has been subscribed for it
+    template <typename Callbacks>
+    size_t Find(Callbacks const & callbacks, char const * method_name) const {
+        (void)callbacks;
+        size_t const slot = Find_Slot(method_name);
+        return slot != SLOT_COUNT ? m_positions[slot] : RPC_METHOD_NOT_FOUND;
+    }
+
+  private:
+    /// @brief Amount of buckets the method names are first distributed into
+    static size_t constexpr BUCKET_COUNT = MethodCount;
+    /// @brief Amount of slots in the table, twice the amount of method names keeps the amount of attempted seeds per bucket low
+    static size_t constexpr SLOT_COUNT = MethodCount * 2U;
+    /// @brief Marks a slot that does not contain any method name
+    static uint16_t constexpr EMPTY_SLOT = UINT16_MAX;
+
+    static_assert(SLOT_COUNT < EMPTY_SLOT, "Static method index can contain atmost 32766 method names");
+
+    /// @brief Returns the bucket the given method name is assigned to
+    /// @param method_name Non owning pointer to the method name
+    /// @return Bucket of the method name
+    static constexpr size_t Get_Bucket(char const * method_name) {
+        return RPC_Method_Index::Hash(method_name) % BUCKET_COUNT;
+    }
+
+    /// @brief Returns the slot the given method name is moved to by the given seed
+    /// @param method_name Non owning pointer to the method name
+    /// @param seed Displacement seed of the bucket the method name is assigned to
+    /// @return Slot of the method name
+    static constexpr size_t Get_Slot(char const * method_name, uint32_t const seed) {
+        return RPC_Method_Index::Hash(method_name, FNV_OFFSET_BASIS ^ (seed * FNV_PRIME)) % SLOT_COUNT;
+    }
+
+    /// @brief Searches for the smallest seed that moves all method names of the given bucket into distinct unused slots and places them there
+    /// @param bucket Bucket whose method names should be placed
+    constexpr void Place_Bucket(size_t const bucket) {
+        size_t members[MethodCount] = {};
+        size_t member_count = 0U;
+        for (size_t index = 0U; index < MethodCount; ++index) {
+            if (Get_Bucket(m_method_names[index]) == bucket) {
+                members[member_count++] = index;
+            }
+        }
+
+        for (uint32_t seed = 0U; seed <= MAX_PERFECT_HASH_SEED; ++seed) {
+            size_t slots[MethodCount] = {};
+            bool fits = true;
+            for (size_t member = 0U; fits && member < member_count; ++member) {
+                slots[member] = Get_Slot(m_method_names[members[member]], seed);
+                fits = m_slots[slots[member]] == EMPTY_SLOT;
+                // Method names of the same bucket are not allowed to be moved into the same slot either
+                for (size_t previous = 0U; fits && previous < member; ++previous) {
+                    fits = slots[previous] != slots[member];
+                }
+            }
+            if (!fits) {
+                continue;
+            }
+            m_seeds[bucket] = static_cast<uint16_t>(seed);
+            for (size_t member = 0U; member < member_count; ++member) {
+                m_slots[slots[member]] = static_cast<uint16_t>(members[member]);
+            }
+            return;
+        }
+        Duplicate_RPC_Method_Name();
+    }
+
+    /// @brief Returns the slot of the given method name, if it is statically known
+    /// @param method_name Non owning pointer to the method name
+    /// @return Slot of the method name or SLOT_COUNT if it is not statically known
+    size_t Find_Slot(char const * method_name) const {
+        if (method_name == nullptr) {
+            return SLOT_COUNT;
+        }
+        size_t const slot = Get_Slot(method_name, m_seeds[Get_Bucket(method_name)]);
+        uint16_t const index = m_slots[slot];
+        if (index == EMPTY_SLOT || strcmp(m_method_names[index], method_name) != 0) {
+            return SLOT_COUNT;
+        }
+        return slot;
+    }
+
+    char const *m_method_names[MethodCount] = {}; // Statically known method names
+    uint16_t   m_seeds[BUCKET_COUNT] = {};        // Displacement seed of every bucket
+    uint16_t   m_slots[SLOT_COUNT] = {};          // Position of the method name in every slot or EMPTY_SLOT
+    size_t     m_positions[SLOT_COUNT] = {};      // Position of the subscribed callback for the method name in every slot or RPC_METHOD_NOT_FOUND
+};
+
+#endif // Static_RPC_Method_Index_h
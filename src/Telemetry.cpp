@@ -1,8 +1,17 @@
 // Header include.
 #include "Telemetry.h"
 
+// Powers of ten a fixed-point value is divided by to convert it into a floating point, every entry is exactly representable as a double.
+double constexpr FIXED_POINT_DIVISORS[MAX_FORMATTED_DECIMALS + 1U] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+};
+size_t constexpr FIXED_POINT_DIVISORS_COUNT = sizeof(FIXED_POINT_DIVISORS) / sizeof(FIXED_POINT_DIVISORS[0]);
+
 Telemetry::Telemetry()
   : m_type(DataType::TYPE_NONE)
+  , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+  , m_element_type()
   , m_key(nullptr)
   , m_value()
 {
@@ -11,6 +20,8 @@ Telemetry::Telemetry()
 
 Telemetry::Telemetry(char const * key, bool value)
   : m_type(DataType::TYPE_BOOL)
+  , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+  , m_element_type()
   , m_key(key)
   , m_value()
 {
@@ -19,35 +30,310 @@ Telemetry::Telemetry(char const * key, bool value)
 
 Telemetry::Telemetry(char const * key, char const * value)
   : m_type(DataType::TYPE_STR)
+  , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+  , m_element_type()
   , m_key(key)
   , m_value()
 {
     m_value.str = value;
 }
 
+Telemetry::Telemetry(char const * key, Fixed_Point const & value)
+  : m_type(DataType::TYPE_FIXED)
+  , m_decimals(value.decimals)
+  , m_element_type()
+  , m_key(key)
+  , m_value()
+{
+    m_value.integer = value.value;
+}
+
+Telemetry::Telemetry(char const * key, Telemetry const * members, size_t const & count)
+  : m_type(DataType::TYPE_OBJECT)
+  , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+  , m_element_type()
+  , m_key(key)
+  , m_value()
+{
+    m_value.array.values = members;
+    m_value.array.count = count;
+}
+
 bool Telemetry::IsEmpty() const {
     return (m_key == nullptr) && m_type == DataType::TYPE_NONE;
 }
 
+char const * Telemetry::Get_Key() const {
+    return m_key;
+}
+
 bool Telemetry::SerializeKeyValue(JsonDocument & source) const {
+    return Serialize_Into(source);
+}
+
+bool Telemetry::SerializeKeyValue(JsonObject source) const {
+    return Serialize_Into(source);
+}
+
+bool Telemetry::SerializeKeyValue(Telemetry_Encoder & encoder) const {
+    if (m_type == DataType::TYPE_NONE || !encoder.Write_Key(m_key)) {
+        return false;
+    }
+    return SerializeValue(encoder);
+}
+
+bool Telemetry::SerializeValue(Telemetry_Encoder & encoder) const {
+    switch (m_type) {
+        case DataType::TYPE_BOOL:
+            encoder.Write_Value(m_value.boolean);
+            break;
+        case DataType::TYPE_INT:
+            encoder.Write_Value(m_value.integer);
+            break;
+        case DataType::TYPE_FLOAT:
+            if (m_decimals == SHORTEST_REPRESENTATION_DECIMALS) {
+                encoder.Write_Value(static_cast<float>(m_value.real));
+            }
+            else {
+                encoder.Write_Value(m_value.real, m_decimals);
+            }
+            break;
+        case DataType::TYPE_REAL:
+            if (m_decimals == SHORTEST_REPRESENTATION_DECIMALS) {
+                encoder.Write_Value(m_value.real);
+            }
+            else {
+                encoder.Write_Value(m_value.real, m_decimals);
+            }
+            break;
+        case DataType::TYPE_FIXED:
+            encoder.Write_Fixed_Point(m_value.integer, m_decimals);
+            break;
+        case DataType::TYPE_STR:
+            encoder.Write_Value(m_value.str);
+            break;
+        case DataType::TYPE_ARRAY:
+            Serialize_Array(encoder);
+            break;
+        case DataType::TYPE_OBJECT: {
+            Telemetry const * const members = static_cast<Telemetry const *>(m_value.array.values);
+            encoder.Begin_Object();
+            for (size_t index = 0U; index < m_value.array.count; ++index) {
+                if (!members[index].SerializeKeyValue(encoder)) {
+                    return false;
+                }
+            }
+            encoder.End_Object();
+            break;
+        }
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool Telemetry::SerializeValue(Protobuf_Encoder & encoder, uint32_t const & field_number) const {
+    switch (m_type) {
+        case DataType::TYPE_BOOL:
+            encoder.Write_Bool(field_number, m_value.boolean);
+            break;
+        case DataType::TYPE_INT:
+            encoder.Write_Integer(field_number, m_value.integer);
+            break;
+        case DataType::TYPE_FLOAT:
+        case DataType::TYPE_REAL:
+            encoder.Write_Double(field_number, m_value.real);
+            break;
+        case DataType::TYPE_FIXED:
+            encoder.Write_Double(field_number, Get_Fixed_Point_As_Real());
+            break;
+        case DataType::TYPE_STR:
+            encoder.Write_String(field_number, m_value.str);
+            break;
+        case DataType::TYPE_ARRAY:
+            // Unpacked repeated field, every element is written with its own tag, which is accepted for packed repeated fields as well
+            for (size_t index = 0U; index < m_value.array.count; ++index) {
+                if (m_element_type == Element_Type::FLOAT || m_element_type == Element_Type::DOUBLE) {
+                    encoder.Write_Double(field_number, Get_Real_Element(index));
+                }
+                else if (m_element_type == Element_Type::BOOL) {
+                    encoder.Write_Bool(field_number, static_cast<bool const *>(m_value.array.values)[index]);
+                }
+                else {
+                    encoder.Write_Integer(field_number, Get_Integral_Element(index));
+                }
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+template <typename Destination>
+bool Telemetry::Serialize_Into(Destination & destination) const {
     if (m_key == nullptr) {
         return false;
     }
     switch (m_type) {
         case DataType::TYPE_BOOL:
-            source[m_key] = m_value.boolean;
+            destination[m_key] = m_value.boolean;
             break;
         case DataType::TYPE_INT:
-            source[m_key] = m_value.integer;
+            destination[m_key] = m_value.integer;
             break;
+        case DataType::TYPE_FLOAT:
         case DataType::TYPE_REAL:
-            source[m_key] = m_value.real;
+        case DataType::TYPE_FIXED:
+            Serialize_Formatted_Into(destination);
             break;
         case DataType::TYPE_STR:
-            source[m_key] = m_value.str;
+            destination[m_key] = m_value.str;
+            break;
+        case DataType::TYPE_ARRAY: {
+            JsonArray array = destination[m_key].template to<JsonArray>();
+            for (size_t index = 0U; index < m_value.array.count; ++index) {
+                bool added = false;
+                switch (m_element_type) {
+                    case Element_Type::FLOAT:
+                    case Element_Type::DOUBLE: {
+                        char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+                        size_t const length = Format_Real(Get_Real_Element(index), m_element_type == Element_Type::FLOAT, formatted);
+                        // Passed as a mutable pointer, because ArduinoJson always copies those instead of only keeping the pointer
+                        added = (length == 0U) ? array.add(nullptr) : array.add(serialized(static_cast<char *>(formatted), length));
+                        break;
+                    }
+                    case Element_Type::UINT64:
+                        added = array.add(static_cast<uint64_t const *>(m_value.array.values)[index]);
+                        break;
+                    case Element_Type::BOOL:
+                        added = array.add(static_cast<bool const *>(m_value.array.values)[index]);
+                        break;
+                    default:
+                        added = array.add(Get_Integral_Element(index));
+                        break;
+                }
+                if (!added) {
+                    return false;
+                }
+            }
             break;
+        }
+        case DataType::TYPE_OBJECT: {
+            Telemetry const * const members = static_cast<Telemetry const *>(m_value.array.values);
+            JsonObject object = destination[m_key].template to<JsonObject>();
+            for (size_t index = 0U; index < m_value.array.count; ++index) {
+                if (!members[index].SerializeKeyValue(object)) {
+                    return false;
+                }
+            }
+            break;
+        }
         default:
             return false;
     }
-    return source.containsKey(m_key);
-}
\ No newline at end of file
+    return destination.containsKey(m_key);
+}
+
+template <typename Destination>
+void Telemetry::Serialize_Formatted_Into(Destination & destination) const {
+    char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+    size_t const length = (m_type == DataType::TYPE_FIXED) ? Number_Formatter::Format_Fixed_Point(m_value.integer, m_decimals, formatted) : Format_Real(m_value.real, m_type == DataType::TYPE_FLOAT, formatted);
+    if (length == 0U) {
+        // NaN and infinity are not valid json numbers, the same as with the Telemetry_Encoder they are therefore written as null instead
+        destination[m_key] = nullptr;
+        return;
+    }
+    // Passed as a mutable pointer, because ArduinoJson always copies those instead of only keeping the pointer
+    destination[m_key] = serialized(static_cast<char *>(formatted), length);
+}
+
+size_t Telemetry::Format_Real(double const & value, bool const & single_precision, char * buffer) const {
+    if (m_decimals != SHORTEST_REPRESENTATION_DECIMALS) {
+        return Number_Formatter::Format_Decimals(value, m_decimals, buffer);
+    }
+    return single_precision ? Number_Formatter::Format_Shortest(static_cast<float>(value), buffer) : Number_Formatter::Format_Shortest(value, buffer);
+}
+
+int64_t Telemetry::Get_Integral_Element(size_t const & index) const {
+    void const * const values = m_value.array.values;
+    switch (m_element_type) {
+        case Element_Type::INT8:
+            return static_cast<int8_t const *>(values)[index];
+        case Element_Type::UINT8:
+            return static_cast<uint8_t const *>(values)[index];
+        case Element_Type::INT16:
+            return static_cast<int16_t const *>(values)[index];
+        case Element_Type::UINT16:
+            return static_cast<uint16_t const *>(values)[index];
+        case Element_Type::INT32:
+            return static_cast<int32_t const *>(values)[index];
+        case Element_Type::UINT32:
+            return static_cast<uint32_t const *>(values)[index];
+        case Element_Type::INT64:
+            return static_cast<int64_t const *>(values)[index];
+        case Element_Type::UINT64:
+            return static_cast<int64_t>(static_cast<uint64_t const *>(values)[index]);
+        case Element_Type::BOOL:
+            return static_cast<bool const *>(values)[index] ? 1 : 0;
+        case Element_Type::FLOAT:
+            return static_cast<int64_t>(static_cast<float const *>(values)[index]);
+        case Element_Type::DOUBLE:
+            return static_cast<int64_t>(static_cast<double const *>(values)[index]);
+        default:
+            return 0;
+    }
+}
+
+double Telemetry::Get_Real_Element(size_t const & index) const {
+    switch (m_element_type) {
+        case Element_Type::FLOAT:
+            return static_cast<float const *>(m_value.array.values)[index];
+        case Element_Type::DOUBLE:
+            return static_cast<double const *>(m_value.array.values)[index];
+        case Element_Type::UINT64:
+            return static_cast<double>(static_cast<uint64_t const *>(m_value.array.values)[index]);
+        default:
+            return static_cast<double>(Get_Integral_Element(index));
+    }
+}
+
+void Telemetry::Serialize_Array(Telemetry_Encoder & encoder) const {
+    encoder.Begin_Array();
+    for (size_t index = 0U; index < m_value.array.count; ++index) {
+        switch (m_element_type) {
+            case Element_Type::FLOAT:
+                if (m_decimals == SHORTEST_REPRESENTATION_DECIMALS) {
+                    encoder.Write_Value(static_cast<float const *>(m_value.array.values)[index]);
+                }
+                else {
+                    encoder.Write_Value(Get_Real_Element(index), m_decimals);
+                }
+                break;
+            case Element_Type::DOUBLE:
+                if (m_decimals == SHORTEST_REPRESENTATION_DECIMALS) {
+                    encoder.Write_Value(Get_Real_Element(index));
+                }
+                else {
+                    encoder.Write_Value(Get_Real_Element(index), m_decimals);
+                }
+                break;
+            case Element_Type::UINT64:
+                encoder.Write_Value(static_cast<uint64_t const *>(m_value.array.values)[index]);
+                break;
+            case Element_Type::BOOL:
+                encoder.Write_Value(static_cast<bool const *>(m_value.array.values)[index]);
+                break;
+            default:
+                encoder.Write_Value(Get_Integral_Element(index));
+                break;
+        }
+    }
+    encoder.End_Array();
+}
+
+double Telemetry::Get_Fixed_Point_As_Real() const {
+    // Dividing once by the exactly representable power of ten rounds only once, instead of accumulating the rounding error of every single division by 10
+    uint8_t const decimals = (m_decimals < FIXED_POINT_DIVISORS_COUNT) ? m_decimals : static_cast<uint8_t>(FIXED_POINT_DIVISORS_COUNT - 1U);
+    return static_cast<double>(m_value.integer) / FIXED_POINT_DIVISORS[decimals];
+}
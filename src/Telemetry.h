@@ -3,6 +3,9 @@
 
 // Local includes.
 #include "Configuration.h"
+#include "Telemetry_Encoder.h"
+#include "Protobuf_Encoder.h"
+#include "Fixed_Point.h"
 
 // Library includes.
 #include <ArduinoJson.h>
@@ -11,6 +14,10 @@
 #endif // THINGSBOARD_ENABLE_STL
 
 
+/// @brief Amount of decimal places that marks a floating point record to be sent with the shortest representation that still reads back as the same value, instead of a fixed amount of decimal places
+uint8_t constexpr SHORTEST_REPRESENTATION_DECIMALS = UINT8_MAX;
+
+
 /// @brief Telemetry record class, allows to store different data using a common interface
 /// @note Is used to allow to easily create a key-value pair of multiple different types that can then be deserialized into a json message
 class Telemetry {
@@ -33,6 +40,8 @@ class Telemetry {
 #endif // THINGSBOARD_ENABLE_STL
     Telemetry(char const * key, T const & value)
       : m_type(DataType::TYPE_INT)
+      , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+      , m_element_type()
       , m_key(key)
       , m_value()
     {
@@ -40,6 +49,8 @@ class Telemetry {
     }
 
     /// @brief Constructs a telemetry record from floating point value
+    /// @note The value is sent with the shortest representation that still reads back as the same value, where floats use the precision of a float instead of the precision of the double they are stored as,
+    /// so that 23.45f is sent as 23.45 instead of 23.450000762939453
     /// @tparam T Type of the passed value, is required to be a floating point,
     /// to ensure this constructor isn't used instead of the boolean one by mistake
     /// @param key Key of the key-value pair we want to create
@@ -53,13 +64,107 @@ class Telemetry {
               typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
 #endif // THINGSBOARD_ENABLE_STL
     Telemetry(char const * key, T const & value)
-      : m_type(DataType::TYPE_REAL)
+      : Telemetry(key, value, SHORTEST_REPRESENTATION_DECIMALS)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Constructs a telemetry record from floating point value, that is sent rounded to the given amount of decimal places
+    /// @note Allows to limit the precision per key to what the sensor can actually measure, trailing zeros are removed because they do not change the value
+    /// @tparam T Type of the passed value, is required to be a floating point,
+    /// to ensure this constructor isn't used instead of the fixed-point one by mistake
+    /// @param key Key of the key-value pair we want to create
+    /// @param value Value of the key-value pair we want to create
+    /// @param decimals Maximum amount of decimal places the value is sent with, SHORTEST_REPRESENTATION_DECIMALS to use the shortest representation instead
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_floating_point, includes float and double
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    Telemetry(char const * key, T const & value, uint8_t const & decimals)
+      : m_type(sizeof(T) <= sizeof(float) ? DataType::TYPE_FLOAT : DataType::TYPE_REAL)
+      , m_decimals(decimals)
+      , m_element_type()
       , m_key(key)
       , m_value()
     {
         m_value.real = value;
     }
 
+    /// @brief Constructs a telemetry record from integer-scaled fixed-point value, that is sent as a decimal number without any floating point math
+    /// @param key Key of the key-value pair we want to create
+    /// @param value Value of the key-value pair we want to create
+    Telemetry(char const * key, Fixed_Point const & value);
+
+    /// @brief Constructs a telemetry record from an array of integral values, that is sent as a json array
+    /// @note The values are not copied, instead only the non owning pointer is kept and the array is serialized element by element once the record is sent,
+    /// which allows to send big arrays like a spectrum with thousands of elements, without ever copying them into a JsonDocument
+    /// @tparam T Type of the array elements, is required to be integral,
+    /// to ensure this constructor isn't used instead of the float one by mistake
+    /// @param key Key of the key-value pair we want to create
+    /// @param values Non owning pointer to the first element of the array.
+    /// Has to be kept alive until the record has been sent, because only the pointer is kept
+    /// @param count Amount of elements in the array
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_integral, includes bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, and unsigned long long
+              typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_integral declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    Telemetry(char const * key, T const * values, size_t const & count)
+      : m_type(DataType::TYPE_ARRAY)
+      , m_decimals(SHORTEST_REPRESENTATION_DECIMALS)
+      , m_element_type(Get_Integral_Element_Type<T>())
+      , m_key(key)
+      , m_value()
+    {
+        m_value.array.values = values;
+        m_value.array.count = count;
+    }
+
+    /// @brief Constructs a telemetry record from an array of floating point values, that is sent as a json array
+    /// @note The values are not copied, instead only the non owning pointer is kept and the array is serialized element by element once the record is sent,
+    /// which allows to send big arrays like a spectrum with thousands of elements, without ever copying them into a JsonDocument
+    /// @tparam T Type of the array elements, is required to be a floating point,
+    /// to ensure this constructor isn't used instead of the integral one by mistake
+    /// @param key Key of the key-value pair we want to create
+    /// @param values Non owning pointer to the first element of the array.
+    /// Has to be kept alive until the record has been sent, because only the pointer is kept
+    /// @param count Amount of elements in the array
+    /// @param decimals Maximum amount of decimal places every element is sent with, default = SHORTEST_REPRESENTATION_DECIMALS
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_floating_point, includes float and double
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    Telemetry(char const * key, T const * values, size_t const & count, uint8_t const & decimals = SHORTEST_REPRESENTATION_DECIMALS)
+      : m_type(DataType::TYPE_ARRAY)
+      , m_decimals(decimals)
+      , m_element_type(sizeof(T) <= sizeof(float) ? Element_Type::FLOAT : Element_Type::DOUBLE)
+      , m_key(key)
+      , m_value()
+    {
+        m_value.array.values = values;
+        m_value.array.count = count;
+    }
+
+    /// @brief Constructs a telemetry record from nested key-value pairs, that are sent as a json object
+    /// @note The members are not copied, instead only the non owning pointer is kept and the members are serialized one by one once the record is sent.
+    /// Members can themselves be arrays or nested objects again
+    /// @param key Key of the key-value pair we want to create
+    /// @param members Non owning pointer to the first member of the nested object.
+    /// Has to be kept alive until the record has been sent, because only the pointer is kept
+    /// @param count Amount of members in the nested object
+    Telemetry(char const * key, Telemetry const * members, size_t const & count);
+
     /// @brief Constructs a telemetry record from boolean value	
     /// @param key Key of the key-value pair we want to create
     /// @param value Value of the key-value pair we want to create
@@ -74,18 +179,70 @@ class Telemetry {
     /// @return Whether there is any data in this record or not
     bool IsEmpty() const;
 
+    /// @brief Returns the key of the key-value pair
+    /// @return Non owning pointer to the key, nullptr if this record is empty
+    char const * Get_Key() const;
+
     /// @brief Serializes a key-value pair
+    /// @note Floating points, including the elements of floating point arrays, and fixed-point values are inserted as already formatted raw json, so they are sent with the same digits as with the Telemetry_Encoder
     /// @param source Data source that should contain the key-value pair
     /// @return Whether serializing was successful or not
     bool SerializeKeyValue(JsonDocument & source) const;
 
+    /// @brief Serializes a key-value pair into the given nested object
+    /// @param source Nested object that should contain the key-value pair
+    /// @return Whether serializing was successful or not
+    bool SerializeKeyValue(JsonObject source) const;
+
+    /// @brief Serializes a key-value pair directly as json text
+    /// @note Does not require a JsonDocument and therefore never allocates any memory on the heap
+    /// @param encoder Encoder that the key-value pair should be written into, expects @ref Telemetry_Encoder::Begin_Object to have been called already
+    /// @return Whether serializing was successful or not
+    bool SerializeKeyValue(Telemetry_Encoder & encoder) const;
+
+    /// @brief Serializes only the value of the key-value pair directly as json text
+    /// @note Allows to write the value into a pre-rendered json payload, where the key has already been written beforehand
+    /// @param encoder Encoder that the value should be written into
+    /// @return Whether serializing was successful or not, fails if this record is empty
+    bool SerializeValue(Telemetry_Encoder & encoder) const;
+
+    /// @brief Serializes the value of the key-value pair as a protobuf field with the given number, the key itself is not written because protobuf identifies fields by their number instead
+    /// @note Booleans are written as bool, integrals as int64, floating points and fixed-point values as double and strings as string fields, therefore the message schema in the device profile has to use the same types.
+    /// Arrays are written as repeated int64 or double fields, nested objects are not supported, because their members do not have a field number
+    /// @param encoder Encoder that the field should be written into
+    /// @param field_number Number of the field in the message schema
+    /// @return Whether serializing was successful or not, fails if this record is empty
+    bool SerializeValue(Protobuf_Encoder & encoder, uint32_t const & field_number) const;
+
   private:
+    /// @brief Non owning reference to an array of values or nested members
+    struct Span {
+        void const *values; // Non owning pointer to the first element
+        size_t     count;   // Amount of elements
+    };
+
     /// @brief Data container, which contains one of the possibly passed values
     union Data {
         const char  *str;
         bool        boolean;
         int64_t     integer;
         double      real;
+        Span        array;
+    };
+
+    /// @brief Type of the elements of a referenced array
+    enum class Element_Type : uint8_t {
+        INT8, ///< Array elements are signed 8 bit integrals
+        UINT8, ///< Array elements are unsigned 8 bit integrals
+        INT16, ///< Array elements are signed 16 bit integrals
+        UINT16, ///< Array elements are unsigned 16 bit integrals
+        INT32, ///< Array elements are signed 32 bit integrals
+        UINT32, ///< Array elements are unsigned 32 bit integrals
+        INT64, ///< Array elements are signed 64 bit integrals
+        UINT64, ///< Array elements are unsigned 64 bit integrals
+        BOOL, ///< Array elements are booleans, which are sent as true and false instead of 1 and 0
+        FLOAT, ///< Array elements are floats
+        DOUBLE ///< Array elements are doubles
     };
 
     /// @brief Data type that the data container currently holds
@@ -93,16 +250,78 @@ class Telemetry {
         TYPE_NONE, ///< Telemetry instance is empty and has not been assigned a value
         TYPE_BOOL, ///< Telemetry instance is a key value-pair with a boolean value
         TYPE_INT, ///< Telemetry instance is a key value-pair with an integral value
-        TYPE_REAL, ///< Telemetry instance is a key value-pair with a real (float, double) value
+        TYPE_FLOAT, ///< Telemetry instance is a key value-pair with a real value, that has the precision of a float
+        TYPE_REAL, ///< Telemetry instance is a key value-pair with a real value, that has the precision of a double
+        TYPE_FIXED, ///< Telemetry instance is a key value-pair with an integer-scaled fixed-point value
+        TYPE_ARRAY, ///< Telemetry instance is a key value-pair with a non owning reference to an array of numbers
+        TYPE_OBJECT, ///< Telemetry instance is a key value-pair with a non owning reference to nested key value-pairs
         TYPE_STR ///< Telemetry isntance is a key value-pair with a string value
     };
 
-    DataType     m_type = {};  // Data type flag, showing which value is saved in the class instance
-    const char   *m_key = {};  // Data key of the key-value pair
-    Data         m_value = {}; // Data value of the key-value pair
+    /// @brief Returns the element type of an array with the given integral type, depending on its size and whether it is signed
+    /// @note Booleans are integrals with the same size as an 8 bit integral as well and are therefore handled by a specialization instead
+    /// @tparam T Type of the array elements
+    /// @return Element type the array is read as
+    template <typename T>
+    static constexpr Element_Type Get_Integral_Element_Type() {
+        return sizeof(T) == sizeof(int8_t) ? (static_cast<T>(-1) < static_cast<T>(0) ? Element_Type::INT8 : Element_Type::UINT8)
+             : sizeof(T) == sizeof(int16_t) ? (static_cast<T>(-1) < static_cast<T>(0) ? Element_Type::INT16 : Element_Type::UINT16)
+             : sizeof(T) == sizeof(int32_t) ? (static_cast<T>(-1) < static_cast<T>(0) ? Element_Type::INT32 : Element_Type::UINT32)
+             : (static_cast<T>(-1) < static_cast<T>(0) ? Element_Type::INT64 : Element_Type::UINT64);
+    }
+
+    /// @brief Serializes a key-value pair into the given JsonDocument or nested object
+    /// @tparam Destination JsonDocument or JsonObject, both allow to insert the value with the subscript operator
+    /// @param destination JsonDocument or nested object that should contain the key-value pair
+    /// @return Whether serializing was successful or not
+    template <typename Destination>
+    bool Serialize_Into(Destination & destination) const;
+
+    /// @brief Formats the floating point or the fixed-point value with @ref Number_Formatter and inserts it as raw json,
+    /// so that the JsonDocument contains the exact same number the @ref Telemetry_Encoder would write, instead of the binary value ArduinoJson would format itself
+    /// @tparam Destination JsonDocument or JsonObject, both allow to insert the value with the subscript operator
+    /// @param destination JsonDocument or nested object that should contain the key-value pair
+    template <typename Destination>
+    void Serialize_Formatted_Into(Destination & destination) const;
+
+    /// @brief Formats the given floating point with @ref Number_Formatter, rounded to the decimal places of this record or with the shortest representation if none were given
+    /// @param value Floating point value that should be formatted
+    /// @param single_precision Whether the value was passed as a float and the shortest representation should therefore only use the precision of a float
+    /// @param buffer Buffer the formatted value is written into, has to be atleast @ref MAX_FORMATTED_NUMBER_LENGTH bytes big
+    /// @return Amount of characters written, 0 if the value is NaN or infinity
+    size_t Format_Real(double const & value, bool const & single_precision, char * buffer) const;
+
+    /// @brief Returns the array element at the given position, converted into the widest integral
+    /// @param index Position of the element, has to be smaller than the amount of elements
+    /// @return Value of the element
+    int64_t Get_Integral_Element(size_t const & index) const;
+
+    /// @brief Returns the array element at the given position, converted into double
+    /// @param index Position of the element, has to be smaller than the amount of elements
+    /// @return Value of the element
+    double Get_Real_Element(size_t const & index) const;
+
+    /// @brief Serializes the referenced array directly as json text
+    /// @param encoder Encoder that the array should be written into
+    void Serialize_Array(Telemetry_Encoder & encoder) const;
+
+    /// @brief Converts the integer-scaled fixed-point value into a floating point, for the serializations that can not represent fixed-point values directly
+    /// @return Floating point value of the fixed-point value
+    double Get_Fixed_Point_As_Real() const;
+
+    DataType     m_type = {};         // Data type flag, showing which value is saved in the class instance
+    uint8_t      m_decimals = {};     // Amount of decimal places real values are rounded to, or fixed-point values are scaled by
+    Element_Type m_element_type = {}; // Type of the elements of the referenced array
+    const char   *m_key = {};         // Data key of the key-value pair
+    Data         m_value = {};        // Data value of the key-value pair
 };
 
 /// @brief Telemetry and attributes are only different on the database side (one has a history the other one does not), but for the purpose of sending data to the cloud both are simply key-value pairs
 using Attribute = Telemetry;
 
+template <>
+constexpr Telemetry::Element_Type Telemetry::Get_Integral_Element_Type<bool>() {
+    return Element_Type::BOOL;
+}
+
 #endif // Telemetry_h
@@ -0,0 +1,237 @@
+#ifndef Telemetry_Aggregator_h
+#define Telemetry_Aggregator_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+#include <math.h>
+
+
+// Aggregations that can be sent at the end of every window, combined as a bitmask.
+uint8_t constexpr AGGREGATE_MIN = 1U << 0U;
+uint8_t constexpr AGGREGATE_MAX = 1U << 1U;
+uint8_t constexpr AGGREGATE_MEAN = 1U << 2U;
+uint8_t constexpr AGGREGATE_STDDEV = 1U << 3U;
+uint8_t constexpr AGGREGATE_COUNT = 1U << 4U;
+uint8_t constexpr AGGREGATE_LAST = 1U << 5U;
+uint8_t constexpr AGGREGATE_ALL = AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_MEAN | AGGREGATE_STDDEV | AGGREGATE_COUNT | AGGREGATE_LAST;
+// Suffixes appended to the key of a channel, to create the key of each aggregation.
+char constexpr AGGREGATE_MIN_SUFFIX[] = "_min";
+char constexpr AGGREGATE_MAX_SUFFIX[] = "_max";
+char constexpr AGGREGATE_MEAN_SUFFIX[] = "_mean";
+char constexpr AGGREGATE_STDDEV_SUFFIX[] = "_stddev";
+char constexpr AGGREGATE_COUNT_SUFFIX[] = "_count";
+char constexpr AGGREGATE_LAST_SUFFIX[] = "_last";
+
+
+/// @brief Windowed on-device aggregation of high rate samples, which sends only the statistics of every channel once per window instead of every single sample.
+/// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+/// @note The raw samples of every channel are collected in their own contiguous block of floats (structure of arrays), instead of interleaving the channels.
+/// Once the block of a channel is full, it is reduced in two sequential passes over the contiguous samples into the running minimum, maximum, count, mean and sum of squared deviations of the window,
+/// which amortizes the comparatively expensive double precision merge over the whole block instead of paying it for every single sample.
+/// The float sums are accumulated strictly in order, because the compiler is not allowed to reorder them without -ffast-math, so the loops are not expected to be vectorized. Blocks are merged with the parallel variance algorithm (Chan et al.),
+/// which stays numerically stable even for many samples with a large offset, where simply summing the squares would lose all precision.
+/// Once the window closes (checked in @ref loop) every channel that received atleast one sample is sent as the selected aggregations, with the aggregation name appended to the key of the channel ({"temp_min":20.5,"temp_max":21.2,...}).
+/// The window is restarted afterwards, even if sending failed, so that the statistics of a window never contain samples of another window.
+/// Be aware that adding samples is not thread safe, therefore ensure samples are added from the same task that calls @ref loop
+/// @tparam Channels Amount of different keys that samples are collected for
+/// @tparam BlockSize Amount of raw samples buffered per channel before they are reduced, bigger blocks merge less often but require Channels * BlockSize * 4 bytes of memory, default = 32
+template <size_t Channels, size_t BlockSize = 32U>
+class Telemetry_Aggregator {
+    static_assert(Channels > 0U, "Aggregator has to contain atleast one channel");
+    static_assert(BlockSize > 0U, "Block size has to be atleast one sample");
+
+  public:
+    /// @brief Constructs an aggregator that sends over the given ThingsBoard instance
+    /// @param thingsboard ThingsBoard instance the statistics are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param keys Array of non owning pointers to the key of every channel, the position of a key in this array is the channel index that has to be used to add samples.
+    /// Has to be kept alive as long as the instance of this class, because only the pointers are kept
+    /// @param window_milliseconds Length of a window in milliseconds, after which the statistics are sent with the next call to @ref loop, default = 10000
+    /// @param aggregations Bitmask of the aggregations that should be sent for every channel, default = AGGREGATE_ALL
+    Telemetry_Aggregator(ThingsBoard & thingsboard, char const * const (&keys)[Channels], uint64_t const & window_milliseconds = 10000U, uint8_t const & aggregations = AGGREGATE_ALL)
+      : m_thingsboard(thingsboard)
+      , m_keys()
+      , m_window(window_milliseconds)
+      , m_aggregations(aggregations)
+      , m_window_start(Helper::Get_Uptime_Milliseconds())
+      , m_samples()
+      , m_buffered()
+      , m_count()
+      , m_min()
+      , m_max()
+      , m_mean()
+      , m_squared_deviations()
+      , m_last()
+    {
+        for (size_t channel = 0U; channel < Channels; ++channel) {
+            m_keys[channel] = keys[channel];
+        }
+    }
+
+    /// @brief Adds the given raw sample to the given channel
+    /// @note Only copies the sample into the block of the channel, the statistics are only updated once the block is full or the window closes
+    /// @param channel Position of the key in the array passed to the constructor
+    /// @param value Raw sample that should be added
+    /// @return Whether adding the sample was successful or not, fails if the channel is out of range
+    bool Add_Sample(size_t const & channel, float const & value) {
+        if (channel >= Channels) {
+            return false;
+        }
+        m_samples[channel][m_buffered[channel]++] = value;
+        if (m_buffered[channel] == BlockSize) {
+            Reduce(channel);
+        }
+        return true;
+    }
+
+    /// @brief Closes the current window once the window length has passed since it was started
+    /// @note Has to be called regularly, for example in the same loop that calls @ref ThingsBoard::loop
+    /// @return Whether sending the statistics was successful or not, true if the window has not closed yet
+    bool loop() {
+        if (Helper::Get_Uptime_Milliseconds() - m_window_start < m_window) {
+            return true;
+        }
+        return Close_Window();
+    }
+
+    /// @brief Sends the statistics of every channel that received atleast one sample and starts a new window, regardless of how long the current window has been open
+    /// @return Whether sending the statistics was successful or not, true if no channel received any samples
+    bool Close_Window() {
+        bool any_samples = false;
+        for (size_t channel = 0U; channel < Channels; ++channel) {
+            Reduce(channel);
+            any_samples = any_samples || m_count[channel] > 0U;
+        }
+
+        bool result = true;
+        if (any_samples) {
+            result = m_thingsboard.Send_Encoded_Json(TELEMETRY_TOPIC, [this](Telemetry_Encoder & encoder) {
+                encoder.Begin_Object();
+                for (size_t channel = 0U; channel < Channels; ++channel) {
+                    Encode_Channel(encoder, channel);
+                }
+                encoder.End_Object();
+                return true;
+            });
+        }
+
+        for (size_t channel = 0U; channel < Channels; ++channel) {
+            m_count[channel] = 0U;
+        }
+        m_window_start = Helper::Get_Uptime_Milliseconds();
+        return result;
+    }
+
+  private:
+    /// @brief Reduces the buffered raw samples of the given channel into the running statistics of the window and empties the block
+    /// @param channel Index of the channel
+    void Reduce(size_t const & channel) {
+        size_t const buffered = m_buffered[channel];
+        if (buffered == 0U) {
+            return;
+        }
+        float const * samples = m_samples[channel];
+
+        // Single precision is enough inside a block, because the block mean is subtracted before squaring and the blocks are merged in double precision afterwards
+        float block_min = samples[0U];
+        float block_max = samples[0U];
+        float block_sum = 0.0f;
+        for (size_t index = 0U; index < buffered; ++index) {
+            float const sample = samples[index];
+            block_min = sample < block_min ? sample : block_min;
+            block_max = sample > block_max ? sample : block_max;
+            block_sum += sample;
+        }
+        float const block_mean = block_sum / static_cast<float>(buffered);
+        float block_squared_deviations = 0.0f;
+        for (size_t index = 0U; index < buffered; ++index) {
+            float const deviation = samples[index] - block_mean;
+            block_squared_deviations += deviation * deviation;
+        }
+
+        // Merge the block into the running statistics of the window with the parallel variance algorithm
+        size_t const previous_count = m_count[channel];
+        size_t const total_count = previous_count + buffered;
+        if (previous_count == 0U) {
+            m_min[channel] = block_min;
+            m_max[channel] = block_max;
+            m_mean[channel] = block_mean;
+            m_squared_deviations[channel] = block_squared_deviations;
+        }
+        else {
+            double const delta = static_cast<double>(block_mean) - m_mean[channel];
+            m_min[channel] = block_min < m_min[channel] ? block_min : m_min[channel];
+            m_max[channel] = block_max > m_max[channel] ? block_max : m_max[channel];
+            m_mean[channel] += delta * static_cast<double>(buffered) / static_cast<double>(total_count);
+            m_squared_deviations[channel] += block_squared_deviations + delta * delta * static_cast<double>(previous_count) * static_cast<double>(buffered) / static_cast<double>(total_count);
+        }
+        m_count[channel] = total_count;
+        m_last[channel] = samples[buffered - 1U];
+        m_buffered[channel] = 0U;
+    }
+
+    /// @brief Writes the selected aggregations of the given channel into the given encoder, if it received atleast one sample
+    /// @param encoder Encoder the key-value pairs should be written into
+    /// @param channel Index of the channel
+    void Encode_Channel(Telemetry_Encoder & encoder, size_t const & channel) const {
+        if (m_count[channel] == 0U) {
+            return;
+        }
+        char const * key = m_keys[channel];
+        if (m_aggregations & AGGREGATE_MIN) {
+            Encode_Aggregation(encoder, key, AGGREGATE_MIN_SUFFIX, Telemetry(key, m_min[channel]));
+        }
+        if (m_aggregations & AGGREGATE_MAX) {
+            Encode_Aggregation(encoder, key, AGGREGATE_MAX_SUFFIX, Telemetry(key, m_max[channel]));
+        }
+        // Mean and standard deviation are accumulated as double but sent with the precision of the float samples, because the additional digits would not be meaningful anyway
+        if (m_aggregations & AGGREGATE_MEAN) {
+            Encode_Aggregation(encoder, key, AGGREGATE_MEAN_SUFFIX, Telemetry(key, static_cast<float>(m_mean[channel])));
+        }
+        if (m_aggregations & AGGREGATE_STDDEV) {
+            Encode_Aggregation(encoder, key, AGGREGATE_STDDEV_SUFFIX, Telemetry(key, static_cast<float>(sqrt(m_squared_deviations[channel] / static_cast<double>(m_count[channel])))));
+        }
+        if (m_aggregations & AGGREGATE_COUNT) {
+            Encode_Aggregation(encoder, key, AGGREGATE_COUNT_SUFFIX, Telemetry(key, m_count[channel]));
+        }
+        if (m_aggregations & AGGREGATE_LAST) {
+            Encode_Aggregation(encoder, key, AGGREGATE_LAST_SUFFIX, Telemetry(key, m_last[channel]));
+        }
+    }
+
+    /// @brief Writes the given value with the key of the channel and the given suffix appended to it into the given encoder
+    /// @param encoder Encoder the key-value pair should be written into
+    /// @param key Key of the channel
+    /// @param suffix Suffix of the aggregation
+    /// @param value Value of the aggregation
+    static void Encode_Aggregation(Telemetry_Encoder & encoder, char const * key, char const * suffix, Telemetry const & value) {
+        size_t const key_length = strlen(key);
+        size_t const suffix_length = strlen(suffix);
+        char aggregation_key[key_length + suffix_length + 1U] = {};
+        memcpy(aggregation_key, key, key_length);
+        memcpy(aggregation_key + key_length, suffix, suffix_length + 1U);
+        if (encoder.Write_Key(aggregation_key)) {
+            (void)value.SerializeValue(encoder);
+        }
+    }
+
+    ThingsBoard & m_thingsboard;                       // ThingsBoard instance the statistics are sent with
+    char const    *m_keys[Channels] = {};              // Key of every channel
+    uint64_t      m_window = {};                       // Length of a window in milliseconds
+    uint8_t       m_aggregations = {};                 // Bitmask of the aggregations that are sent for every channel
+    uint64_t      m_window_start = {};                 // Uptime in milliseconds the current window was started at
+    float         m_samples[Channels][BlockSize] = {}; // Contiguous block of buffered raw samples of every channel
+    size_t        m_buffered[Channels] = {};           // Amount of buffered raw samples of every channel
+    size_t        m_count[Channels] = {};              // Amount of samples reduced into the statistics of the current window of every channel
+    float         m_min[Channels] = {};                // Minimum sample of the current window of every channel
+    float         m_max[Channels] = {};                // Maximum sample of the current window of every channel
+    double        m_mean[Channels] = {};               // Mean of the current window of every channel
+    double        m_squared_deviations[Channels] = {}; // Sum of squared deviations from the mean of the current window of every channel
+    float         m_last[Channels] = {};               // Most recent sample of every channel
+};
+
+#endif // Telemetry_Aggregator_h
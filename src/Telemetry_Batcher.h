@@ -0,0 +1,157 @@
+#ifndef Telemetry_Batcher_h
+#define Telemetry_Batcher_h
+
+// Local includes.
+#include "ThingsBoard.h"
+#include "Helper.h"
+
+// Library includes.
+#include <string.h>
+
+
+/// @brief Batching layer on top of the ThingsBoard telemetry API, which accumulates multiple key-value pairs and sends them with a single publish instead of one publish per key-value pair.
+/// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
+/// @note Because the server side rate limits are applied per received message and not per contained key-value pair, merging the key-value pairs allows to send data much more often.
+/// The key-value pairs are kept in a fixed-capacity buffer, where each key is only kept once and a later value for the same key overwrites the previous one (last-write-wins).
+/// The buffer is flushed once the given threshold of contained keys has been reached, once the given flush interval has passed since the first key-value pair was added (checked in @ref loop)
+/// or when @ref Flush is called explicitly. If sending fails the key-value pairs are kept and sending is attempted again on the next flush.
+/// Be aware that the keys and string values are not copied, but instead only the non owning pointers are kept until the key-value pairs have been sent.
+/// Therefore ensure the keys and string values are kept alive until the next flush, which is most easily achieved by using string literals
+/// @tparam Capacity Maximum amount of different keys that can be batched at once, allows to allocate the key-value pairs on the stack instead of the heap.
+/// If a new key would exceed this amount the already contained key-value pairs are flushed first, default = 16
+template <size_t Capacity = 16U>
+class Telemetry_Batcher {
+  public:
+    /// @brief Constructs a batcher that sends over the given ThingsBoard instance
+    /// @param thingsboard ThingsBoard instance the batched key-value pairs are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    /// @param flush_interval_milliseconds Maximum amount of milliseconds a key-value pair is kept in the buffer before it is sent with the next call to @ref loop, 0 means that only the threshold and explicit flushes send the data, default = 1000
+    /// @param flush_threshold Amount of contained different keys that cause the buffer to be flushed immediately, is limited to the given Capacity, default = Capacity
+    explicit Telemetry_Batcher(ThingsBoard & thingsboard, uint64_t const & flush_interval_milliseconds = 1000U, size_t const & flush_threshold = Capacity)
+      : m_thingsboard(thingsboard)
+      , m_flush_interval(flush_interval_milliseconds)
+      , m_flush_threshold((flush_threshold == 0U || flush_threshold > Capacity) ? Capacity : flush_threshold)
+      , m_key_value_pairs()
+      , m_size(0U)
+      , m_window_start(0U)
+      , m_batched_calls(0U)
+      , m_publishes(0U)
+      , m_saved_publishes(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Adds the given key-value pair to the batch, overwriting the previous value if the same key has already been added since the last flush
+    /// @tparam T Type of the passed value
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive until the key-value pair has been flushed, because only the pointer is kept
+    /// @param value Value of the key-value pair, if the value is a string it has to be kept alive until the key-value pair has been flushed as well
+    /// @return Whether adding the key-value pair and any flush that was caused by it was successful or not
+    template<typename T>
+    bool Send_Telemetry_Data(char const * key, T const & value) {
+        Telemetry const telemetry(key, value);
+        if (telemetry.IsEmpty() || key == nullptr) {
+            return false;
+        }
+
+        bool result = true;
+        size_t index = Find_Key(key);
+        if (index == m_size) {
+            // Flush the current batch first, because otherwise there would be no space left for the new key
+            if (m_size == Capacity) {
+                result = Flush();
+                if (m_size == Capacity) {
+                    return false;
+                }
+            }
+            if (m_size == 0U) {
+                m_window_start = Helper::Get_Uptime_Milliseconds();
+            }
+            index = m_size++;
+        }
+        m_key_value_pairs[index] = telemetry;
+        m_batched_calls++;
+
+        if (m_size >= m_flush_threshold) {
+            result = Flush() && result;
+        }
+        return result;
+    }
+
+    /// @brief Sends all currently batched key-value pairs with a single publish
+    /// @note If sending fails the key-value pairs are kept, so that sending can be attempted again with the next flush
+    /// @return Whether sending was successful or not, true if there was nothing to send
+    bool Flush() {
+        if (m_size == 0U) {
+            return true;
+        }
+        Telemetry const * first = m_key_value_pairs;
+        if (!m_thingsboard.Send_Telemetry(first, first + m_size)) {
+            return false;
+        }
+        m_publishes++;
+        // Every call except the one that actually caused this publish would have resulted in its own publish without batching
+        m_saved_publishes += m_batched_calls - 1U;
+        m_batched_calls = 0U;
+        m_size = 0U;
+        return true;
+    }
+
+    /// @brief Flushes the batched key-value pairs if the flush interval has passed since the first of them was added
+    /// @note Has to be called regularly, ideally with the same frequency as the @ref ThingsBoard::loop method
+    void loop() {
+        if (m_size == 0U || m_flush_interval == 0U) {
+            return;
+        }
+        if (Helper::Get_Uptime_Milliseconds() - m_window_start >= m_flush_interval) {
+            (void)Flush();
+            // Restart the window on failure as well, to not attempt to send again on every single call to loop
+            m_window_start = Helper::Get_Uptime_Milliseconds();
+        }
+    }
+
+    /// @brief Returns the amount of currently batched different keys, that will be sent with the next flush
+    /// @return Amount of currently batched different keys
+    size_t const & Get_Batched_Keys() const {
+        return m_size;
+    }
+
+    /// @brief Returns the amount of publishes that have been executed by this batcher
+    /// @return Amount of successful publishes
+    size_t const & Get_Publishes() const {
+        return m_publishes;
+    }
+
+    /// @brief Returns the amount of publishes that have been saved, compared to sending every call to @ref Send_Telemetry_Data with its own publish
+    /// @return Amount of saved publishes
+    size_t const & Get_Saved_Publishes() const {
+        return m_saved_publishes;
+    }
+
+  private:
+    /// @brief Searches for the given key in the currently batched key-value pairs
+    /// @param key Non owning pointer to the key that should be searched
+    /// @return Index of the key-value pair with the given key or the current amount of batched key-value pairs if it was not found
+    size_t Find_Key(char const * key) const {
+        for (size_t index = 0U; index < m_size; ++index) {
+            char const * batched_key = m_key_value_pairs[index].Get_Key();
+            // Most keys are string literals, comparing the pointers first allows to skip the string comparison in most cases
+            if (batched_key == key || strcmp(batched_key, key) == 0) {
+                return index;
+            }
+        }
+        return m_size;
+    }
+
+    ThingsBoard & m_thingsboard;                    // ThingsBoard instance the batched key-value pairs are sent with
+    uint64_t      m_flush_interval = {};            // Maximum amount of milliseconds a key-value pair is kept before it is sent
+    size_t        m_flush_threshold = {};           // Amount of contained different keys that cause an immediate flush
+    Telemetry     m_key_value_pairs[Capacity] = {}; // Currently batched key-value pairs, each key is only contained once
+    size_t        m_size = {};                      // Amount of currently batched key-value pairs
+    uint64_t      m_window_start = {};              // Uptime in milliseconds when the first of the currently batched key-value pairs was added
+    size_t        m_batched_calls = {};             // Amount of calls to Send_Telemetry_Data that have been batched since the last flush
+    size_t        m_publishes = {};                 // Amount of successful publishes
+    size_t        m_saved_publishes = {};           // Amount of publishes saved, compared to sending every call with its own publish
+};
+
+#endif // Telemetry_Batcher_h
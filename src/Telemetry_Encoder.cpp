@@ -0,0 +1,278 @@
+// Header include.
+#include "Telemetry_Encoder.h"
+
+// Library includes.
+#include <string.h>
+
+// Json literals.
+char constexpr JSON_TRUE[] = "true";
+char constexpr JSON_FALSE[] = "false";
+char constexpr JSON_NULL[] = "null";
+char constexpr HEXADECIMAL_DIGITS[] = "0123456789abcdef";
+// Nesting.
+uint8_t constexpr MAX_NESTING_DEPTH = 32U;
+
+Telemetry_Encoder::Telemetry_Encoder(char * buffer, size_t const & size)
+  : m_buffer(buffer)
+  , m_size(buffer != nullptr ? size : 0U)
+  , m_state()
+  , m_nesting_exceeded(false)
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+  , m_output(nullptr)
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+{
+    // Nothing to do
+}
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+Telemetry_Encoder::Telemetry_Encoder(Print & output)
+  : m_buffer(nullptr)
+  , m_size(0U)
+  , m_state()
+  , m_nesting_exceeded(false)
+  , m_output(&output)
+{
+    // Nothing to do
+}
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+void Telemetry_Encoder::Begin_Object() {
+    Begin_Nesting('{');
+}
+
+void Telemetry_Encoder::End_Object() {
+    End_Nesting('}');
+}
+
+void Telemetry_Encoder::Begin_Array() {
+    Begin_Nesting('[');
+}
+
+void Telemetry_Encoder::End_Array() {
+    End_Nesting(']');
+}
+
+bool Telemetry_Encoder::Finish() {
+    if (m_buffer != nullptr && m_size > 0U) {
+        m_buffer[m_state.length < m_size ? m_state.length : m_size - 1U] = '\0';
+    }
+    return Is_Complete();
+}
+
+bool Telemetry_Encoder::Write_Key(char const * key) {
+    if (key == nullptr) {
+        return false;
+    }
+    Write_Seperator();
+    Write_String(key);
+    Write_Character(':');
+    m_state.after_key = true;
+    return true;
+}
+
+void Telemetry_Encoder::Write_Value(bool value) {
+    Write_Seperator();
+    if (value) {
+        Write_Characters(JSON_TRUE, sizeof(JSON_TRUE) - 1U);
+    }
+    else {
+        Write_Characters(JSON_FALSE, sizeof(JSON_FALSE) - 1U);
+    }
+}
+
+void Telemetry_Encoder::Write_Value(int64_t value) {
+    Write_Seperator();
+    if (value < 0) {
+        Write_Character('-');
+        // Negate in the unsigned domain, because negating the smallest possible signed value would overflow
+        Write_Unsigned(0U - static_cast<uint64_t>(value));
+        return;
+    }
+    Write_Unsigned(static_cast<uint64_t>(value));
+}
+
+void Telemetry_Encoder::Write_Value(uint64_t value) {
+    Write_Seperator();
+    Write_Unsigned(value);
+}
+
+void Telemetry_Encoder::Write_Value(double value) {
+    char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+    Write_Number(formatted, Number_Formatter::Format_Shortest(value, formatted));
+}
+
+void Telemetry_Encoder::Write_Value(float value) {
+    char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+    Write_Number(formatted, Number_Formatter::Format_Shortest(value, formatted));
+}
+
+void Telemetry_Encoder::Write_Value(double value, uint8_t decimals) {
+    char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+    Write_Number(formatted, Number_Formatter::Format_Decimals(value, decimals, formatted));
+}
+
+void Telemetry_Encoder::Write_Fixed_Point(int64_t value, uint8_t decimals) {
+    char formatted[MAX_FORMATTED_NUMBER_LENGTH] = {};
+    Write_Number(formatted, Number_Formatter::Format_Fixed_Point(value, decimals, formatted));
+}
+
+void Telemetry_Encoder::Write_Value(char const * value) {
+    Write_Seperator();
+    if (value == nullptr) {
+        Write_Characters(JSON_NULL, sizeof(JSON_NULL) - 1U);
+        return;
+    }
+    Write_String(value);
+}
+
+size_t const & Telemetry_Encoder::Get_Length() const {
+    return m_state.length;
+}
+
+bool Telemetry_Encoder::Is_Complete() const {
+    return !m_nesting_exceeded && (m_buffer == nullptr || m_state.length < m_size);
+}
+
+Telemetry_Encoder::Checkpoint Telemetry_Encoder::Get_Checkpoint() const {
+    return m_state;
+}
+
+void Telemetry_Encoder::Restore_Checkpoint(Checkpoint const & checkpoint) {
+    m_state = checkpoint;
+}
+
+void Telemetry_Encoder::Write_Seperator() {
+    // The value directly following a key does not require a seperator, because the key already wrote the colon
+    if (m_state.after_key) {
+        m_state.after_key = false;
+        return;
+    }
+    if (m_state.depth == 0U) {
+        return;
+    }
+    uint32_t const first_member_bit = static_cast<uint32_t>(1U) << (m_state.depth - 1U);
+    if ((m_state.first_members & first_member_bit) != 0U) {
+        m_state.first_members &= ~first_member_bit;
+        return;
+    }
+    Write_Character(',');
+}
+
+void Telemetry_Encoder::Begin_Nesting(char bracket) {
+    Write_Seperator();
+    Write_Character(bracket);
+    // Levels past the maximum depth can not be tracked, the matching closing bracket would therefore leave a level that was never entered.
+    // Instead the error is latched and every following closing bracket ignored, which fails the complete json
+    if (m_nesting_exceeded || m_state.depth >= MAX_NESTING_DEPTH) {
+        m_nesting_exceeded = true;
+        return;
+    }
+    m_state.first_members |= static_cast<uint32_t>(1U) << m_state.depth;
+    m_state.depth++;
+}
+
+void Telemetry_Encoder::End_Nesting(char bracket) {
+    if (m_nesting_exceeded) {
+        return;
+    }
+    Write_Character(bracket);
+    if (m_state.depth > 0U) {
+        m_state.depth--;
+        m_state.first_members &= ~(static_cast<uint32_t>(1U) << m_state.depth);
+    }
+}
+
+void Telemetry_Encoder::Write_Character(char character) {
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    if (m_output != nullptr) {
+        m_state.length += m_output->write(static_cast<uint8_t>(character));
+        return;
+    }
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    // Always keep one byte left for the null termination, the length is increased regardless to still be able to measure the required size
+    if (m_state.length + 1U < m_size) {
+        m_buffer[m_state.length] = character;
+    }
+    m_state.length++;
+}
+
+void Telemetry_Encoder::Write_Characters(char const * characters, size_t const & length) {
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    if (m_output != nullptr) {
+        m_state.length += m_output->write(reinterpret_cast<uint8_t const *>(characters), length);
+        return;
+    }
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+    if (m_state.length + length < m_size) {
+        memcpy(m_buffer + m_state.length, characters, length);
+    }
+    else if (m_state.length + 1U < m_size) {
+        // Copy as many characters as still fit, while keeping one byte left for the null termination
+        memcpy(m_buffer + m_state.length, characters, m_size - 1U - m_state.length);
+    }
+    m_state.length += length;
+}
+
+void Telemetry_Encoder::Write_String(char const * string) {
+    Write_Character('"');
+    // Copy all characters that do not need to be escaped in one go and only handle the escaped ones individually
+    char const * start = string;
+    for (char const * current = string; *current != '\0'; ++current) {
+        uint8_t const character = static_cast<uint8_t>(*current);
+        if (character >= 0x20U && character != '"' && character != '\\') {
+            continue;
+        }
+        Write_Characters(start, current - start);
+        start = current + 1U;
+        Write_Character('\\');
+        switch (character) {
+            case '"':
+            case '\\':
+                Write_Character(static_cast<char>(character));
+                break;
+            case '\b':
+                Write_Character('b');
+                break;
+            case '\f':
+                Write_Character('f');
+                break;
+            case '\n':
+                Write_Character('n');
+                break;
+            case '\r':
+                Write_Character('r');
+                break;
+            case '\t':
+                Write_Character('t');
+                break;
+            default:
+                Write_Characters("u00", 3U);
+                Write_Character(HEXADECIMAL_DIGITS[character >> 4U]);
+                Write_Character(HEXADECIMAL_DIGITS[character & 0x0FU]);
+                break;
+        }
+    }
+    Write_Characters(start, strlen(start));
+    Write_Character('"');
+}
+
+void Telemetry_Encoder::Write_Unsigned(uint64_t value) {
+    // Biggest possible 64 bit value has 20 decimal digits, the digits are written from the back because that is the order they are calculated in
+    char digits[20U] = {};
+    size_t position = sizeof(digits);
+    do {
+        digits[--position] = static_cast<char>('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+    Write_Characters(digits + position, sizeof(digits) - position);
+}
+
+void Telemetry_Encoder::Write_Number(char const * formatted, size_t const & length) {
+    Write_Seperator();
+    // NaN and infinity are not valid json numbers and are therefore written as null instead
+    if (length == 0U) {
+        Write_Characters(JSON_NULL, sizeof(JSON_NULL) - 1U);
+        return;
+    }
+    Write_Characters(formatted, length);
+}
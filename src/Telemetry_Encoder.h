@@ -0,0 +1,176 @@
+#ifndef Telemetry_Encoder_h
+#define Telemetry_Encoder_h
+
+// Local includes.
+#include "Configuration.h"
+#include "Number_Formatter.h"
+
+// Library includes.
+#include <stdint.h>
+#include <stddef.h>
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+#include <Print.h>
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+
+/// @brief Minimal json writer, which serializes key-value pairs directly into a caller provided buffer
+/// @note Replaces the previous approach of first inserting every key-value pair into a heap allocated JsonDocument and then serializing that JsonDocument into a string.
+/// The encoder never allocates any memory itself and instead handles the escaping of strings as well as the formatting of numbers on its own.
+/// If the given buffer is too small the encoder keeps counting the amount of bytes the complete json would require, but stops writing into the buffer once it is full.
+/// This allows to use the same instance with a nullptr buffer and a size of 0 to simply measure the required size of the serialized json beforehand.
+/// Objects and arrays can be nested up to 32 levels deep, nesting any deeper fails the complete json. The seperators between members and elements are inserted automatically
+class Telemetry_Encoder {
+  public:
+    /// @brief State of the encoder at a specific point in time, allows to remove everything that has been written after that point again
+    struct Checkpoint {
+        size_t   length = {};        // Amount of bytes that had been written at the time the checkpoint was created
+        uint32_t first_members = {}; // Bitmask containing whether the next member of every nesting level is the first one
+        uint8_t  depth = {};         // Current nesting level at the time the checkpoint was created
+        bool     after_key = {};     // Whether a key without its value had been written at the time the checkpoint was created
+    };
+
+    /// @brief Constructs an encoder that writes into the given buffer
+    /// @param buffer Non owning pointer to the buffer the serialized json is written into, nullptr to only measure the required size.
+    /// Has to be kept alive for as long as the encoder is used
+    /// @param size Total size of the given buffer in bytes, including the space required for the null termination
+    Telemetry_Encoder(char * buffer, size_t const & size);
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    /// @brief Constructs an encoder that streams every written character directly into the given output instead of into a buffer
+    /// @note Allows to send payloads that are bigger than any buffer that could be allocated, for example telemetry arrays with thousands of elements, in combination with a measuring encoder to calculate the length beforehand.
+    /// Because the written characters have already left the encoder, checkpoints can not be restored anymore and the output is never null terminated
+    /// @param output Output the serialized json is streamed into, should be buffered because single characters are written one by one.
+    /// Has to be kept alive for as long as the encoder is used
+    explicit Telemetry_Encoder(Print & output);
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+
+    /// @brief Writes the opening bracket of a json object
+    void Begin_Object();
+
+    /// @brief Writes the closing bracket of the previously opened json object
+    void End_Object();
+
+    /// @brief Writes the opening bracket of a json array
+    void Begin_Array();
+
+    /// @brief Writes the closing bracket of the previously opened json array
+    void End_Array();
+
+    /// @brief Null terminates the buffer, has to be called once after the json has been written completely
+    /// @return Whether the complete json has been written into the buffer, false if the buffer was too small and the content was truncated or the maximum nesting depth was exceeded
+    bool Finish();
+
+    /// @brief Writes the escaped key of the next key-value pair and the seperator to the value, as well as the seperator to the previous key-value pair if there was any
+    /// @param key Non owning pointer to the key that should be written.
+    /// Does not need to be kept alive, because the key is copied into the buffer
+    /// @return Whether writing the key was successful or not, fails if the given key is nullptr
+    bool Write_Key(char const * key);
+
+    /// @brief Writes the given boolean as the value of the key-value pair or as the next array element
+    /// @param value Value that should be written
+    void Write_Value(bool value);
+
+    /// @brief Writes the given integral as the value of the key-value pair or as the next array element
+    /// @param value Value that should be written
+    void Write_Value(int64_t value);
+
+    /// @brief Writes the given unsigned integral as the value of the key-value pair or as the next array element
+    /// @note Allows to write unsigned 64 bit values that would not fit into a signed 64 bit integral
+    /// @param value Value that should be written
+    void Write_Value(uint64_t value);
+
+    /// @brief Writes the given double as the value of the key-value pair or as the next array element
+    /// @note Uses the shortest representation that reads back as the same double, see @ref Number_Formatter::Format_Shortest.
+    /// NaN and infinity are not valid json numbers and are therefore written as null instead
+    /// @param value Value that should be written
+    void Write_Value(double value);
+
+    /// @brief Writes the given float as the value of the key-value pair or as the next array element
+    /// @note Uses the shortest representation that reads back as the same float, which is typically a lot shorter than the representation of the same value converted to double.
+    /// NaN and infinity are not valid json numbers and are therefore written as null instead
+    /// @param value Value that should be written
+    void Write_Value(float value);
+
+    /// @brief Writes the given floating point rounded to the given amount of decimal places as the value of the key-value pair or as the next array element
+    /// @note Trailing zeros are removed, NaN and infinity are written as null
+    /// @param value Value that should be written
+    /// @param decimals Maximum amount of decimal places
+    void Write_Value(double value, uint8_t decimals);
+
+    /// @brief Writes the given integer-scaled fixed-point value as the value of the key-value pair or as the next array element, without any floating point math
+    /// @note Allows to send values that are already measured as scaled integers, for example centi-degrees 2345 with 2 decimals are written as 23.45
+    /// @param value Integer-scaled value
+    /// @param decimals Amount of decimal places the value is scaled by
+    void Write_Fixed_Point(int64_t value, uint8_t decimals);
+
+    /// @brief Writes the given string as the value of the key-value pair or as the next array element
+    /// @note Quotes, backslashes and control characters are escaped, a nullptr is written as null
+    /// @param value Non owning pointer to the string that should be written.
+    /// Does not need to be kept alive, because the value is copied into the buffer
+    void Write_Value(char const * value);
+
+    /// @brief Returns the length of the complete json without null termination
+    /// @note Is also returned if the buffer was too small, which allows to use the value to allocate a big enough buffer
+    /// @return Amount of bytes the complete json requires without the null termination
+    size_t const & Get_Length() const;
+
+    /// @brief Whether the complete json fits into the given buffer and did not exceed the maximum nesting depth
+    /// @note Always true if the encoder is only used to measure the required size and the maximum nesting depth was not exceeded, because no buffer has been given
+    /// @return Whether all written bytes and the null termination fit into the buffer and the json is valid
+    bool Is_Complete() const;
+
+    /// @brief Returns the current state of the encoder, which can be restored with @ref Restore_Checkpoint
+    /// @return Current state of the encoder
+    Checkpoint Get_Checkpoint() const;
+
+    /// @brief Removes everything that has been written since the given checkpoint was created
+    /// @note Allows to write an element and then remove it again if it would not fit into a maximum size anymore. Not supported when streaming into an output, because the written characters can not be taken back
+    /// @param checkpoint Previously created checkpoint the encoder should be reset to
+    void Restore_Checkpoint(Checkpoint const & checkpoint);
+
+  private:
+    /// @brief Writes the seperator to the previous member or element if there was any and marks the current nesting level as not empty anymore
+    void Write_Seperator();
+
+    /// @brief Writes the given opening bracket and enters a new nesting level
+    /// @note Latches the nesting error instead if the maximum nesting depth has already been reached, see @ref Is_Complete
+    /// @param bracket Opening bracket that should be written
+    void Begin_Nesting(char bracket);
+
+    /// @brief Writes the given closing bracket and leaves the current nesting level
+    /// @note Does nothing once the maximum nesting depth has been exceeded, because the nesting levels are not tracked anymore
+    /// @param bracket Closing bracket that should be written
+    void End_Nesting(char bracket);
+
+    /// @brief Writes a single character into the buffer, if there is still space left for it and its null termination
+    /// @param character Character that should be written
+    void Write_Character(char character);
+
+    /// @brief Writes the given amount of characters into the buffer
+    /// @param characters Non owning pointer to the characters that should be written
+    /// @param length Amount of characters that should be written
+    void Write_Characters(char const * characters, size_t const & length);
+
+    /// @brief Writes the given string enclosed in quotes and escapes all characters that are not allowed in a json string
+    /// @param string Non owning pointer to the null terminated string that should be written
+    void Write_String(char const * string);
+
+    /// @brief Writes the given unsigned integral as decimal digits
+    /// @param value Value that should be written
+    void Write_Unsigned(uint64_t value);
+
+    /// @brief Writes the given formatted number, or null if the number could not be formatted
+    /// @param formatted Non owning pointer to the formatted number
+    /// @param length Amount of formatted characters, 0 if the number is NaN or infinity
+    void Write_Number(char const * formatted, size_t const & length);
+
+    char       *m_buffer = {};          // Non owning pointer to the buffer the json is written into, nullptr if we only measure the required size
+    size_t     m_size = {};             // Total size of the buffer including the space required for the null termination
+    Checkpoint m_state = {};            // Current amount of written bytes and nesting state, the amount of bytes is increased even if the byte did not fit into the buffer anymore
+    bool       m_nesting_exceeded = {}; // Whether the maximum nesting depth has been exceeded, is not reset by restoring a checkpoint and fails the complete json
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+    Print      *m_output = {};          // Non owning pointer to the output the json is streamed into, nullptr if we write into the buffer instead
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+};
+
+#endif // Telemetry_Encoder_h
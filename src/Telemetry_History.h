@@ -0,0 +1,198 @@
+#ifndef Telemetry_History_h
+#define Telemetry_History_h
+
+// Local includes.
+#include "ThingsBoard.h"
+
+
+// Log messages.
+char constexpr HISTORY_SAMPLE_TOO_BIG[] = "Discarding timestamped sample, because it is bigger than the send buffer size (%u)";
+
+
+/// @brief Telemetry record with the time it was sampled at, allows to send data later without losing the time it was actually sampled
+struct Timestamped_Telemetry {
+    uint64_t  timestamp = {}; // Time the telemetry record was sampled at as a UNIX timestamp in milliseconds
+    Telemetry telemetry = {}; // Sampled key-value pair
+};
+
+
+/// @brief Ring buffer of timestamped telemetry records, which are sent as historical telemetry data with their original timestamp instead of the time they arrive on the server.
+/// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+/// @note Allows to sample data at a high rate, but only transmit every once in a while, without losing any time resolution.
+/// The records are serialized as one json array of ({"ts":1451649600512,"values":{"key1":"value1"}}) entries, where all consecutive records with the same timestamp are merged into the same entry.
+/// If the array would be bigger than the current send buffer size, it is automatically split into multiple publishes instead.
+/// If the ring buffer is full, the oldest record is overwritten by the newest one.
+/// Be aware that the keys and string values are not copied, but instead only the non owning pointers are kept until the records have been sent.
+/// Therefore ensure the keys and string values are kept alive until the next upload, which is most easily achieved by using string literals
+/// @tparam Capacity Maximum amount of timestamped key-value pairs that can be kept at once, allows to allocate the records on the stack instead of the heap, default = 64
+template <size_t Capacity = 64U>
+class Telemetry_History {
+  public:
+    /// @brief Constructs a ring buffer that sends over the given ThingsBoard instance
+    /// @param thingsboard ThingsBoard instance the timestamped records are sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    explicit Telemetry_History(ThingsBoard & thingsboard)
+      : m_thingsboard(thingsboard)
+      , m_samples()
+      , m_tail(0U)
+      , m_size(0U)
+      , m_overwritten(0U)
+    {
+        // Nothing to do
+    }
+
+    /// @brief Appends the given key-value pair with the given timestamp
+    /// @tparam T Type of the passed value
+    /// @param timestamp Time the key-value pair was sampled at as a UNIX timestamp in milliseconds
+    /// @param key Non owning pointer to the key of the key-value pair.
+    /// Has to be kept alive until the key-value pair has been uploaded, because only the pointer is kept
+    /// @param value Value of the key-value pair, if the value is a string it has to be kept alive until the key-value pair has been uploaded as well
+    /// @return Whether appending the key-value pair was successful or not
+    template<typename T>
+    bool Push(uint64_t const & timestamp, char const * key, T const & value) {
+        return Push(timestamp, Telemetry(key, value));
+    }
+
+    /// @brief Appends the given telemetry record with the given timestamp
+    /// @param timestamp Time the telemetry record was sampled at as a UNIX timestamp in milliseconds
+    /// @param telemetry Telemetry record that should be appended
+    /// @return Whether appending the telemetry record was successful or not
+    bool Push(uint64_t const & timestamp, Telemetry const & telemetry) {
+        if (telemetry.IsEmpty()) {
+            return false;
+        }
+        if (m_size == Capacity) {
+            m_tail = (m_tail + 1U) % Capacity;
+            m_size--;
+            m_overwritten++;
+        }
+        Timestamped_Telemetry & sample = m_samples[(m_tail + m_size) % Capacity];
+        sample.timestamp = timestamp;
+        sample.telemetry = telemetry;
+        m_size++;
+        return true;
+    }
+
+    /// @brief Appends all given telemetry records with the same given timestamp
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param timestamp Time the telemetry records were sampled at as a UNIX timestamp in milliseconds
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether appending all telemetry records was successful or not
+    template<typename InputIterator>
+    bool Push(uint64_t const & timestamp, InputIterator const & first, InputIterator const & last) {
+        bool result = true;
+        for (auto it = first; it != last; ++it) {
+            result = Push(timestamp, *it) && result;
+        }
+        return result;
+    }
+
+    /// @brief Sends all contained records as historical telemetry data, split into as many publishes as are required to stay below the current send buffer size
+    /// @note Records are only removed once they have been sent successfully, if sending fails the remaining records are kept and can be sent with the next call.
+    /// Records with a timestamp that contains more key-value pairs than fit into the send buffer at once are discarded, because they could otherwise never be sent
+    /// @return Whether sending all contained records was successful or not, true if there was nothing to send
+    bool Upload() {
+        while (m_size > 0U) {
+            size_t const maximum_size = m_thingsboard.Get_Send_Buffer_Size();
+            size_t consumed = 0U;
+            bool const result = m_thingsboard.Send_Encoded_Json(TELEMETRY_TOPIC, [this, &consumed, &maximum_size](Telemetry_Encoder & encoder) {
+                consumed = Encode_Samples(encoder, maximum_size);
+                return consumed != 0U;
+            });
+
+            if (consumed == 0U) {
+                DefaultLogger::printfln(HISTORY_SAMPLE_TOO_BIG, maximum_size);
+                Pop(Get_Group_Size(0U));
+                continue;
+            }
+            if (!result) {
+                return false;
+            }
+            Pop(consumed);
+        }
+        return true;
+    }
+
+    /// @brief Returns the amount of currently contained timestamped key-value pairs
+    /// @return Amount of currently contained timestamped key-value pairs
+    size_t const & Size() const {
+        return m_size;
+    }
+
+    /// @brief Returns the amount of timestamped key-value pairs that have been overwritten, because the ring buffer was full
+    /// @return Amount of lost timestamped key-value pairs
+    size_t const & Get_Overwritten() const {
+        return m_overwritten;
+    }
+
+  private:
+    /// @brief Returns the record at the given position, counted from the oldest contained record
+    /// @param index Position of the record, has to be smaller than the amount of contained records
+    /// @return Record at the given position
+    Timestamped_Telemetry const & At(size_t const & index) const {
+        return m_samples[(m_tail + index) % Capacity];
+    }
+
+    /// @brief Returns the amount of consecutive records that have the same timestamp as the record at the given position
+    /// @param index Position of the first record of the group
+    /// @return Amount of records that are merged into the same array entry
+    size_t Get_Group_Size(size_t const & index) const {
+        size_t end = index + 1U;
+        while (end < m_size && At(end).timestamp == At(index).timestamp) {
+            end++;
+        }
+        return end - index;
+    }
+
+    /// @brief Removes the given amount of records, starting with the oldest contained record
+    /// @param count Amount of records that should be removed
+    void Pop(size_t const & count) {
+        size_t const removed = count < m_size ? count : m_size;
+        m_tail = (m_tail + removed) % Capacity;
+        m_size -= removed;
+    }
+
+    /// @brief Writes as many records, starting with the oldest one, as a json array into the given encoder, as fit into the given maximum size
+    /// @param encoder Encoder the json array should be written into
+    /// @param maximum_size Maximum size the written json array is allowed to have, including the null termination
+    /// @return Amount of records that have been written into the json array
+    size_t Encode_Samples(Telemetry_Encoder & encoder, size_t const & maximum_size) const {
+        encoder.Begin_Array();
+        size_t consumed = 0U;
+        while (consumed < m_size) {
+            Telemetry_Encoder::Checkpoint const checkpoint = encoder.Get_Checkpoint();
+            size_t const group_size = Get_Group_Size(consumed);
+
+            encoder.Begin_Object();
+            (void)encoder.Write_Key(TS_KEY);
+            encoder.Write_Value(static_cast<int64_t>(At(consumed).timestamp));
+            (void)encoder.Write_Key(VALUES_KEY);
+            encoder.Begin_Object();
+            for (size_t index = consumed; index < consumed + group_size; ++index) {
+                (void)At(index).telemetry.SerializeKeyValue(encoder);
+            }
+            encoder.End_Object();
+            encoder.End_Object();
+
+            // The closing bracket of the array and the null termination have to fit as well, if they would not remove the entry again and send it with the next publish instead
+            if (encoder.Get_Length() + 1U >= maximum_size) {
+                encoder.Restore_Checkpoint(checkpoint);
+                break;
+            }
+            consumed += group_size;
+        }
+        encoder.End_Array();
+        return consumed;
+    }
+
+    ThingsBoard &         m_thingsboard;            // ThingsBoard instance the timestamped records are sent with
+    Timestamped_Telemetry m_samples[Capacity] = {}; // Ring buffer of the contained timestamped records
+    size_t                m_tail = {};              // Index of the oldest contained record in the ring buffer
+    size_t                m_size = {};              // Amount of contained records
+    size_t                m_overwritten = {};       // Amount of records that have been overwritten, because the ring buffer was full
+};
+
+#endif // Telemetry_History_h
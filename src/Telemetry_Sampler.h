@@ -0,0 +1,304 @@
+#ifndef Telemetry_Sampler_h
+#define Telemetry_Sampler_h
+
+// Local includes.
+#include "Constants.h"
+#include "ITelemetry_Sampler.h"
+
+// Library includes.
+#include <ArduinoJson.h>
+#if THINGSBOARD_ENABLE_STL
+#include <atomic>
+#include <type_traits>
+#endif // THINGSBOARD_ENABLE_STL
+
+
+/// @brief Lock-free single-producer single-consumer ring buffer of fixed-size samples, which can be written from an interrupt service routine or a high priority sensor task
+/// and are drained and sent in the @ref ThingsBoard::loop method, once the sampler has been set with @ref ThingsBoard::Set_Telemetry_Sampler.
+/// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+/// @note Decouples the timing of the sensor from the latency of the serialization and the network, because appending a sample only copies the key index, value and timestamp into the next free slot and publishes it with a single atomic store.
+/// Appending never blocks, allocates or logs, if the ring buffer is full the new sample is dropped instead and counted, see @ref Get_Dropped.
+/// Samples are sent as one json array, where consecutive samples with the same timestamp are merged into the same ({"ts":1451649600512,"values":{"key1":1}}) entry,
+/// samples without a timestamp are sent as ({"key1":1}) entries instead and receive the time they arrive on the server.
+/// Exactly one task or interrupt service routine is allowed to append samples and only the task calling @ref ThingsBoard::loop is allowed to consume them.
+/// On targets without STL support the ring buffer indices are single bytes, because those are the only values that are read and written atomically on 8-bit microcontrollers.
+/// Be aware that the methods are not placed into IRAM, therefore they can not be called from ESP32 interrupt service routines that have to run while the flash cache is disabled (ESP_INTR_FLAG_IRAM)
+/// @tparam KeyCount Amount of different keys that samples are appended for
+/// @tparam Capacity Maximum amount of samples that can be buffered at once, every sample requires 16 bytes of memory, default = 64
+template <size_t KeyCount, size_t Capacity = 64U>
+class Telemetry_Sampler : public ITelemetry_Sampler {
+    static_assert(KeyCount > 0U, "Sampler has to contain atleast one key");
+    static_assert(Capacity > 0U, "Sampler has to be able to buffer atleast one sample");
+#if !THINGSBOARD_ENABLE_STL
+    static_assert(Capacity < UINT8_MAX, "Sampler capacity has to fit into a single byte index, because larger values can not be accessed atomically without STL support");
+#endif // !THINGSBOARD_ENABLE_STL
+
+  public:
+    /// @brief Constructs an empty sampler
+    /// @param keys Array of non owning pointers to every key, the position of a key in this array is the key index that has to be used to append samples.
+    /// Has to be kept alive as long as the instance of this class, because only the pointers are kept
+    explicit Telemetry_Sampler(char const * const (&keys)[KeyCount])
+      : m_keys()
+      , m_records()
+      , m_head(0U)
+      , m_tail(0U)
+      , m_dropped(0U)
+    {
+        for (size_t index = 0U; index < KeyCount; ++index) {
+            m_keys[index] = keys[index];
+        }
+    }
+
+    /// @brief Appends the given integral sample, is safe to call from an interrupt service routine
+    /// @tparam T Type of the passed value, is required to be integral and is stored as a 32 bit integer,
+    /// to ensure this method isn't used instead of the float one by mistake
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range or the ring buffer is full
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_integral, includes bool, char, signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, and unsigned long long
+              typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_integral declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_integral<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Push(size_t const & key_index, T const & value, uint64_t const & timestamp = 0U) {
+        Sample_Value sample_value = {};
+        sample_value.integer = static_cast<int32_t>(value);
+        return Push(key_index, Sample_Type::TYPE_INT, sample_value, timestamp);
+    }
+
+    /// @brief Appends the given floating point sample, is safe to call from an interrupt service routine
+    /// @tparam T Type of the passed value, is required to be a floating point and is stored as a float,
+    /// to ensure this method isn't used instead of the boolean one by mistake
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range or the ring buffer is full
+    template <typename T,
+#if THINGSBOARD_ENABLE_STL
+              // Standard library is_floating_point, includes float and double
+              typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+#else
+              // Workaround for ArduinoJson version after 6.21.0, to still be able to access internal enable_if and is_floating_point declarations, previously accessible with ARDUINOJSON_NAMESPACE
+              typename ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::enable_if<ArduinoJson::ARDUINOJSON_VERSION_NAMESPACE::detail::is_floating_point<T>::value>::type* = nullptr>
+#endif // THINGSBOARD_ENABLE_STL
+    bool Push(size_t const & key_index, T const & value, uint64_t const & timestamp = 0U) {
+        Sample_Value sample_value = {};
+        sample_value.real = static_cast<float>(value);
+        return Push(key_index, Sample_Type::TYPE_REAL, sample_value, timestamp);
+    }
+
+    /// @brief Appends the given boolean sample, is safe to call from an interrupt service routine
+    /// @param key_index Position of the key in the array passed to the constructor
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds, 0 to use the time the sample arrives on the server instead, default = 0
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range or the ring buffer is full
+    bool Push(size_t const & key_index, bool value, uint64_t const & timestamp = 0U) {
+        Sample_Value sample_value = {};
+        sample_value.boolean = value;
+        return Push(key_index, Sample_Type::TYPE_BOOL, sample_value, timestamp);
+    }
+
+    /// @brief Returns the amount of samples that have been dropped, because the ring buffer was full
+    /// @return Amount of lost samples
+    size_t Get_Dropped() const {
+        return m_dropped;
+    }
+
+    size_t Available() const override {
+        size_t const head = Load(m_head);
+        size_t const tail = Load(m_tail);
+        return (head + SLOT_COUNT - tail) % SLOT_COUNT;
+    }
+
+    size_t Encode_Samples(Telemetry_Encoder & encoder, size_t const & count, size_t const & maximum_size) const override {
+        encoder.Begin_Array();
+        size_t consumed = 0U;
+        while (consumed < count) {
+            Telemetry_Encoder::Checkpoint const checkpoint = encoder.Get_Checkpoint();
+            size_t const group_size = Get_Group_Size(consumed, count);
+            uint64_t const timestamp = At(consumed).timestamp;
+
+            encoder.Begin_Object();
+            if (timestamp != 0U) {
+                (void)encoder.Write_Key(TS_KEY);
+                encoder.Write_Value(static_cast<int64_t>(timestamp));
+                (void)encoder.Write_Key(VALUES_KEY);
+                encoder.Begin_Object();
+            }
+            for (size_t index = consumed; index < consumed + group_size; ++index) {
+                Encode_Sample(encoder, At(index));
+            }
+            if (timestamp != 0U) {
+                encoder.End_Object();
+            }
+            encoder.End_Object();
+
+            // The closing bracket of the array and the null termination have to fit as well, if they would not remove the entry again and send it with the next publish instead
+            if (encoder.Get_Length() + 1U >= maximum_size) {
+                encoder.Restore_Checkpoint(checkpoint);
+                break;
+            }
+            consumed += group_size;
+        }
+        encoder.End_Array();
+        return consumed;
+    }
+
+    void Pop(size_t const & count) override {
+        size_t const available = Available();
+        size_t const removed = count < available ? count : available;
+        Store(m_tail, (Load(m_tail) + removed) % SLOT_COUNT);
+    }
+
+  private:
+    /// @brief One additional slot is always kept empty, so that a full ring buffer can be distinguished from an empty one without a shared size counter
+    static size_t constexpr SLOT_COUNT = Capacity + 1U;
+
+#if THINGSBOARD_ENABLE_STL
+    using Index = std::atomic<size_t>;
+#else
+    using Index = uint8_t volatile;
+#endif // THINGSBOARD_ENABLE_STL
+
+    /// @brief Data type that the value of a sample currently holds
+    enum class Sample_Type : uint8_t {
+        TYPE_BOOL, ///< Sample contains a boolean value
+        TYPE_INT, ///< Sample contains an integral value
+        TYPE_REAL ///< Sample contains a real value
+    };
+
+    /// @brief Value container, which contains one of the possibly passed values
+    union Sample_Value {
+        int32_t integer;
+        float   real;
+        bool    boolean;
+    };
+
+    /// @brief Fixed-size sample, which is copied into the ring buffer by the producer
+    struct Sample_Record {
+        uint64_t     timestamp = {}; // Time the sample was taken at as a UNIX timestamp in milliseconds, 0 if it should receive the time it arrives on the server
+        Sample_Value value = {};     // Value of the sample
+        uint16_t     key_index = {}; // Position of the key of the sample
+        Sample_Type  type = {};      // Data type of the value
+    };
+
+    /// @brief Copies the given sample into the next free slot and publishes it to the consumer
+    /// @param key_index Position of the key of the sample
+    /// @param type Data type of the value
+    /// @param value Value of the sample
+    /// @param timestamp Time the sample was taken at as a UNIX timestamp in milliseconds
+    /// @return Whether appending the sample was successful or not, fails if the key index is out of range or the ring buffer is full
+    bool Push(size_t const & key_index, Sample_Type const & type, Sample_Value const & value, uint64_t const & timestamp) {
+        if (key_index >= KeyCount) {
+            return false;
+        }
+        size_t const head = Load(m_head);
+        size_t const next = (head + 1U) % SLOT_COUNT;
+        if (next == Load(m_tail)) {
+            m_dropped = m_dropped + 1U;
+            return false;
+        }
+        Sample_Record & record = m_records[head];
+        record.timestamp = timestamp;
+        record.value = value;
+        record.key_index = static_cast<uint16_t>(key_index);
+        record.type = type;
+        // Only publish the slot once the sample has been written completely, the consumer never reads slots past the published head
+        Store(m_head, next);
+        return true;
+    }
+
+    /// @brief Reads the given ring buffer index, all writes of the other side that happened before it stored the index are visible afterwards
+    /// @param index Index that should be read
+    /// @return Value of the index
+    static size_t Load(Index const & index) {
+#if THINGSBOARD_ENABLE_STL
+        return index.load(std::memory_order_acquire);
+#else
+        return index;
+#endif // THINGSBOARD_ENABLE_STL
+    }
+
+    /// @brief Writes the given ring buffer index, all previous writes are visible to the other side once it reads the index
+    /// @param index Index that should be written
+    /// @param value Value the index should be set to
+    static void Store(Index & index, size_t const & value) {
+#if THINGSBOARD_ENABLE_STL
+        index.store(value, std::memory_order_release);
+#else
+        // Prevents the compiler from moving the writes of the sample after the write of the index
+        __sync_synchronize();
+        index = static_cast<uint8_t>(value);
+#endif // THINGSBOARD_ENABLE_STL
+    }
+
+    /// @brief Returns the sample at the given position, counted from the oldest contained sample
+    /// @param index Position of the sample, has to be smaller than the amount of available samples
+    /// @return Sample at the given position
+    Sample_Record const & At(size_t const & index) const {
+        return m_records[(Load(m_tail) + index) % SLOT_COUNT];
+    }
+
+    /// @brief Returns the amount of consecutive samples that have the same timestamp as the sample at the given position and can therefore be merged into the same array entry
+    /// @note A group ends as well once a key would be contained twice, because only the last value of a duplicated json key would be kept by the server
+    /// @param index Position of the first sample of the group
+    /// @param count Amount of samples that are allowed to be consumed
+    /// @return Amount of samples that are merged into the same array entry
+    size_t Get_Group_Size(size_t const & index, size_t const & count) const {
+        size_t end = index + 1U;
+        while (end < count && At(end).timestamp == At(index).timestamp && !Contains_Key(index, end, At(end).key_index)) {
+            end++;
+        }
+        return end - index;
+    }
+
+    /// @brief Whether any sample in the given range has the given key
+    /// @param first Position of the first sample of the range
+    /// @param last Position after the last sample of the range
+    /// @param key_index Position of the key that should be searched
+    /// @return Whether the key is contained in the given range
+    bool Contains_Key(size_t const & first, size_t const & last, uint16_t const & key_index) const {
+        for (size_t index = first; index < last; ++index) {
+            if (At(index).key_index == key_index) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Writes the given sample as key-value pair into the given encoder
+    /// @param encoder Encoder the key-value pair should be written into
+    /// @param record Sample that should be written
+    void Encode_Sample(Telemetry_Encoder & encoder, Sample_Record const & record) const {
+        if (!encoder.Write_Key(m_keys[record.key_index])) {
+            return;
+        }
+        switch (record.type) {
+            case Sample_Type::TYPE_BOOL:
+                encoder.Write_Value(record.value.boolean);
+                break;
+            case Sample_Type::TYPE_INT:
+                encoder.Write_Value(static_cast<int64_t>(record.value.integer));
+                break;
+            case Sample_Type::TYPE_REAL:
+                encoder.Write_Value(record.value.real);
+                break;
+        }
+    }
+
+    char const          *m_keys[KeyCount] = {};     // Key of every key index
+    Sample_Record       m_records[SLOT_COUNT] = {}; // Ring buffer of the appended samples
+    Index               m_head = {};                // Index of the next slot the producer writes into, is only written by the producer
+    Index               m_tail = {};                // Index of the oldest sample that has not been consumed yet, is only written by the consumer
+#if THINGSBOARD_ENABLE_STL
+    std::atomic<size_t> m_dropped = {};             // Amount of samples that have been dropped, because the ring buffer was full
+#else
+    size_t volatile     m_dropped = {};             // Amount of samples that have been dropped, because the ring buffer was full
+#endif // THINGSBOARD_ENABLE_STL
+};
+
+#endif // Telemetry_Sampler_h
@@ -0,0 +1,210 @@
+#ifndef Telemetry_Schema_h
+#define Telemetry_Schema_h
+
+// Local includes.
+#include "ThingsBoard.h"
+
+// Library includes.
+#include <string.h>
+
+
+// Log messages.
+char constexpr SCHEMA_VALUE_TOO_BIG[] = "Value starting with (%s) does not fit into the schema slot size (%u), keeping previous value";
+// Json value every slot contains until it is set for the first time.
+char constexpr SCHEMA_EMPTY_SLOT[] = "null";
+
+
+/// @brief Fixed set of telemetry keys, that are sent together every cycle, with a json skeleton rendered at compile time where only the values are formatted into place before sending.
+/// See https://thingsboard.io/docs/reference/mqtt-api/#telemetry-upload-api for more information
+/// @note The json skeleton ({"key1":null  ,"key2":null  }) containing every escaped key, the seperators and a fixed size slot per value is rendered by the compiler into a static constexpr array,
+/// which is placed into flash together with the key strings themselves. Only the value slots are kept in RAM. Setting a value formats that single value into its slot and pads the remaining characters of the slot with whitespace, which is valid json.
+/// Sending the payload therefore skips building the structure and escaping the keys and simply copies the skeleton and the slots into one string, which is then published with @ref ThingsBoard::Send_Json_String.
+/// Because the keys are template arguments, they have to be declared as constexpr character arrays with static storage duration, for example constexpr char TEMPERATURE_KEY[] = "temperature";
+/// Slots that have never been set are sent as null. Be aware that the payload is always as big as if every slot was completely filled, so the slot size should be chosen as small as the expected values allow
+/// @tparam SlotSize Amount of characters reserved for every value, values whose json representation would be longer are rejected
+/// @tparam Keys Non owning pointers to the keys of the schema, the position of a key in this list is the index that has to be used to set its value
+template <size_t SlotSize, char const * ... Keys>
+class Telemetry_Schema {
+    static constexpr size_t KEY_COUNT = sizeof...(Keys);
+    static_assert(KEY_COUNT > 0U, "Schema has to contain atleast one key");
+    static_assert(SlotSize >= sizeof(SCHEMA_EMPTY_SLOT) - 1U, "Slot size has to be big enough to contain an unset value");
+
+    static constexpr char const * KEYS[KEY_COUNT] = { Keys... };
+
+    /// @brief Calculates the amount of characters the given key requires once it has been escaped, with the same rules as @ref Telemetry_Encoder::Write_Key
+    /// @param key Key that should be measured
+    /// @return Amount of characters the escaped key requires without the enclosing quotes
+    static constexpr size_t Escaped_Length(char const * key) {
+        size_t length = 0U;
+        for (size_t index = 0U; key[index] != '\0'; ++index) {
+            uint8_t const character = static_cast<uint8_t>(key[index]);
+            if (character >= 0x20U && character != '"' && character != '\\') {
+                length += 1U;
+            }
+            else if (character == '"' || character == '\\' || character == '\b' || character == '\f' || character == '\n' || character == '\r' || character == '\t') {
+                length += 2U;
+            }
+            else {
+                length += 6U;
+            }
+        }
+        return length;
+    }
+
+    /// @brief Calculates the size of the complete skeleton including the null termination
+    /// @return Size of the complete skeleton
+    static constexpr size_t Calculate_Json_Size() {
+        // Opening bracket and null termination, as well as the quotes, colon, slot and following seperator or closing bracket of every key
+        size_t size = 2U;
+        for (size_t index = 0U; index < KEY_COUNT; ++index) {
+            size += Escaped_Length(KEYS[index]) + 3U + SlotSize + 1U;
+        }
+        return size;
+    }
+
+  public:
+    /// @brief Size of the complete payload including the null termination, can be used to allocate a buffer for @ref Write_Json
+    static constexpr size_t JSON_SIZE = Calculate_Json_Size();
+
+  private:
+    /// @brief Json skeleton and the position of every value slot inside of it
+    struct Skeleton {
+        char   json[JSON_SIZE] = {};       // Complete json payload with every slot set to null
+        size_t slots[KEY_COUNT] = {};      // Amount of characters from the start of the json to the start of the slot of every key
+    };
+
+    /// @brief Renders the json skeleton containing all keys, is only ever evaluated by the compiler
+    /// @return Rendered skeleton
+    static constexpr Skeleton Render() {
+        Skeleton skeleton = {};
+        size_t length = 0U;
+        skeleton.json[length++] = '{';
+        for (size_t index = 0U; index < KEY_COUNT; ++index) {
+            skeleton.json[length++] = '"';
+            for (char const * current = KEYS[index]; *current != '\0'; ++current) {
+                uint8_t const character = static_cast<uint8_t>(*current);
+                if (character >= 0x20U && character != '"' && character != '\\') {
+                    skeleton.json[length++] = *current;
+                    continue;
+                }
+                skeleton.json[length++] = '\\';
+                switch (character) {
+                    case '"':
+                    case '\\':
+                        skeleton.json[length++] = *current;
+                        break;
+                    case '\b':
+                        skeleton.json[length++] = 'b';
+                        break;
+                    case '\f':
+                        skeleton.json[length++] = 'f';
+                        break;
+                    case '\n':
+                        skeleton.json[length++] = 'n';
+                        break;
+                    case '\r':
+                        skeleton.json[length++] = 'r';
+                        break;
+                    case '\t':
+                        skeleton.json[length++] = 't';
+                        break;
+                    default:
+                        skeleton.json[length++] = 'u';
+                        skeleton.json[length++] = '0';
+                        skeleton.json[length++] = '0';
+                        skeleton.json[length++] = "0123456789abcdef"[character >> 4U];
+                        skeleton.json[length++] = "0123456789abcdef"[character & 0x0FU];
+                        break;
+                }
+            }
+            skeleton.json[length++] = '"';
+            skeleton.json[length++] = ':';
+            skeleton.slots[index] = length;
+            for (size_t slot_index = 0U; slot_index < SlotSize; ++slot_index) {
+                skeleton.json[length++] = (slot_index < sizeof(SCHEMA_EMPTY_SLOT) - 1U) ? SCHEMA_EMPTY_SLOT[slot_index] : ' ';
+            }
+            skeleton.json[length++] = (index + 1U < KEY_COUNT) ? ',' : '}';
+        }
+        skeleton.json[length] = '\0';
+        return skeleton;
+    }
+
+    static constexpr Skeleton SKELETON = Render();
+
+  public:
+    /// @brief Constructs the schema with every slot set to null
+    /// @param thingsboard ThingsBoard instance the payload is sent with.
+    /// Has to be kept alive as long as the instance of this class, because only a non owning reference is kept
+    Telemetry_Schema(ThingsBoard & thingsboard)
+      : m_thingsboard(thingsboard)
+      , m_slots()
+    {
+        for (size_t index = 0U; index < KEY_COUNT; ++index) {
+            Clear(index);
+        }
+    }
+
+    /// @brief Formats the given value into the slot of the key at the given index
+    /// @tparam T Type of the passed value, string values are supported as well as long as they fit into the slot including their quotes
+    /// @param index Position of the key in the template argument list
+    /// @param value Value that should be sent for the key
+    /// @return Whether setting the value was successful or not, fails if the index is out of range or the formatted value does not fit into the slot
+    template<typename T>
+    bool Set(size_t const & index, T const & value) {
+        if (index >= KEY_COUNT) {
+            return false;
+        }
+        char formatted[SlotSize + 1U] = {};
+        Telemetry_Encoder encoder(formatted, sizeof(formatted));
+        if (!Telemetry(nullptr, value).SerializeValue(encoder) || !encoder.Finish()) {
+            DefaultLogger::printfln(SCHEMA_VALUE_TOO_BIG, formatted, SlotSize);
+            return false;
+        }
+        Write_Slot(index, formatted, encoder.Get_Length());
+        return true;
+    }
+
+    /// @brief Resets the slot of the key at the given index back to null
+    /// @param index Position of the key in the template argument list
+    void Clear(size_t const & index) {
+        if (index >= KEY_COUNT) {
+            return;
+        }
+        Write_Slot(index, SCHEMA_EMPTY_SLOT, sizeof(SCHEMA_EMPTY_SLOT) - 1U);
+    }
+
+    /// @brief Sends the current payload containing the latest value of every key as telemetry data
+    /// @note The payload is assembled on the stack, because the skeleton in flash is never modified
+    /// @return Whether sending the payload was successful or not
+    bool Send() const {
+        char json[JSON_SIZE] = {};
+        Write_Json(json);
+        return m_thingsboard.Send_Json_String(TELEMETRY_TOPIC, json);
+    }
+
+    /// @brief Copies the current payload containing the latest value of every key into the given buffer
+    /// @note Allows to send the payload over a different topic, for example as client-side attributes
+    /// @param json Buffer the null terminated payload is copied into, has to be atleast JSON_SIZE bytes big
+    void Write_Json(char (&json)[JSON_SIZE]) const {
+        memcpy(json, SKELETON.json, JSON_SIZE);
+        for (size_t index = 0U; index < KEY_COUNT; ++index) {
+            memcpy(json + SKELETON.slots[index], m_slots[index], SlotSize);
+        }
+    }
+
+  private:
+    /// @brief Copies the given formatted value into the slot of the key at the given index and pads the remaining characters with whitespace
+    /// @param index Position of the key in the template argument list
+    /// @param formatted Formatted json value
+    /// @param length Length of the formatted value, has to be smaller or equal to the slot size
+    void Write_Slot(size_t const & index, char const * formatted, size_t const & length) {
+        char * slot = m_slots[index];
+        memcpy(slot, formatted, length);
+        memset(slot + length, ' ', SlotSize - length);
+    }
+
+    ThingsBoard & m_thingsboard;                   // ThingsBoard instance the payload is sent with
+    char          m_slots[KEY_COUNT][SlotSize] = {}; // Current formatted value of every key, padded with whitespace
+};
+
+#endif // Telemetry_Schema_h
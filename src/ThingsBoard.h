@@ -4,9 +4,16 @@
 // Local includes.
 #include "Constants.h"
 #include "IAPI_Implementation.h"
+#include "API_Topic_Router.h"
 #include "IMQTT_Client.h"
 #include "DefaultLogger.h"
 #include "Telemetry.h"
+#include "Outbound_Queue.h"
+#include "ITelemetry_Sampler.h"
+#include "Protobuf_Field.h"
+#include "Protobuf_Decoder.h"
+#include "Payload_Codec.h"
+#include "Json_Arena_Allocator.h"
 
 // Library includes.
 #if THINGSBOARD_ENABLE_STREAM_UTILS
@@ -38,11 +45,11 @@ class ThingsBoard {
     /// This is created to ensure no StackOverflow occurs because most supported boards run the actual sending code in a seperate FreeRTOS Task with limited stack space where even a stack allocation of 4 KiB might already cause a crash
     /// To circumvent this copy the alternative mentioned in the send_buffer_size argument can also be used because it skips the internal copy alltogether, because the JsonDocument is instead directly copied into the outgoing MQTT buffer, default = 1024
     /// @param max_response_size Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload.
-    /// Size is calculated automatically from certain characters in the received payload (',', '{', '[') but if we receive a malicious payload that contains these symbols in a string {"example":",,,,,,..."}.
-    /// It is possible to cause huge allocations, but because the memory only lives for as long as the subscribed callback methods it should not be a problem,
-    /// especially because attempting to allocate too much memory, will cause the allocation to fail, which is checked. But if the failure of that heap allocation is subscribed for example with the heap_caps_register_failed_alloc_callback method on the ESP32,
-    /// then that subscribed callback will be called and could theoretically restart the device. To circumvent that we can simply set the size of this variable to a value that should never be exceeded by a non malicious json payload.
-    /// If this safety feature is not required, because the heap allocation failure callback is not subscribed, then the value of the variable can simply be kept as 0, which means we will not check the received payload for its size before the allocation happens, default = 0
+    /// If the value is not 0, a buffer of exactly this size is allocated once and the memory of every received payload is handed out from that buffer instead of the heap, see @ref Json_Arena_Allocator.
+    /// This results in a deterministic upper bound for the memory used per received message and removes every heap allocation from the deserialization of received messages.
+    /// Only the deserialized payload counts against this size, the deserialization filters are owned by the API implementations and never allocated from this buffer, see @ref IAPI_Implementation::Get_Deserialization_Filter.
+    /// Received payloads that would require more memory, for example malicious payloads that contain a lot of small elements, are discarded before they could cause any heap allocation instead.
+    /// If the value is 0 the memory is allocated on the heap for every received message without any limit, default = 0
     /// @param buffering_size Amount of bytes allocated to speed up serialization.
     /// Used when THINGSBOARD_ENABLE_STREAM_UTILS is enabled by importing the ArduinoStreamUtils (https://github.com/bblanchon/ArduinoStreamUtils) in the project.
     /// This feature allows to improve the underlying data streams by directly writing the data into the MQTT Client instead of into an output buffer,
@@ -62,28 +69,34 @@ class ThingsBoard {
         , m_buffering_size(buffering_size)
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
         , m_max_response_size(max_response_size)
+        , m_response_arena(max_response_size)
+        , m_send_arena()
         , m_api_implementations(args...)
     {
+            // Initialize callback, before the api implementations are subscribed, because they are informed whether the client delivers big responses in fragments.
+#if THINGSBOARD_ENABLE_STL
+            m_client.set_data_callback(std::bind(&ThingsBoard::On_MQTT_Message, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+            m_fragmented_delivery = m_client.set_data_fragment_callback(std::bind(&ThingsBoard::On_MQTT_Fragment, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6));
+            m_client.set_connect_callback(std::bind(&ThingsBoard::Resubscribe_Permanent_Subscriptions, this));
+#else
+            m_client.set_data_callback(ThingsBoard::On_Static_MQTT_Message);
+            m_fragmented_delivery = m_client.set_data_fragment_callback(ThingsBoard::On_Static_MQTT_Fragment);
+            m_client.set_connect_callback(ThingsBoard::Static_MQTT_Connect);
+            m_subscribedInstance = this;
+#endif // THINGSBOARD_ENABLE_STL
             for (auto & api : m_api_implementations) {
                     if (api == nullptr) {
                             continue;
                     }
 #if THINGSBOARD_ENABLE_STL
-                    api->Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this));
+                    api->Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this), std::bind(&ThingsBoard::Get_Json_Allocator, this));
 #else
-                    api->Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID);
+                    api->Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID, ThingsBoard::Static_Get_Json_Allocator);
 #endif // THINGSBOARD_ENABLE_STL
+                    api->Set_Fragmented_Delivery(m_fragmented_delivery);
                     api->Initialize();
             }
-            // Initialize callback.
-#if THINGSBOARD_ENABLE_STL
-            m_client.set_data_callback(std::bind(&ThingsBoard::On_MQTT_Message, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-            m_client.set_connect_callback(std::bind(&ThingsBoard::Resubscribe_Permanent_Subscriptions, this));
-#else
-            m_client.set_data_callback(ThingsBoard::On_Static_MQTT_Message);
-            m_client.set_connect_callback(ThingsBoard::Static_MQTT_Connect);
-            m_subscribedInstance = this;
-#endif // THINGSBOARD_ENABLE_STL
+            m_topic_router.Rebuild(m_api_implementations.begin(), m_api_implementations.end());
     }
 
     /// @brief Gets the registered underlying MQTT Client implementation
@@ -132,27 +145,116 @@ class ThingsBoard {
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
     /// @brief Sets the Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
-    /// @note Size is calculated automatically from certain characters in the received payload (',', '{', '[') but if we receive a malicious payload that contains these symbols in a string {"example":",,,,,,..."}.
-    /// It is possible to cause huge allocations, but because the memory only lives for as long as the subscribed callback methods it should not be a problem,
-    /// especially because attempting to allocate too much memory, will cause the allocation to fail, which is checked. But if the failure of that heap allocation is subscribed for example with the heap_caps_register_failed_alloc_callback method on the ESP32,
-    /// then that subscribed callback will be called and could theoretically restart the device. To circumvent that we can simply set the size of this variable to a value that should never be exceeded by a non malicious json payload.
-    /// If this safety feature is not required, because the heap allocation failure callback is not subscribed, then the value of the variable can simply be kept as 0, which means we will not check the received payload for its size before the allocation happens
+    /// @note If the value is not 0, a buffer of exactly this size is allocated once and the memory of every received payload is handed out from that buffer instead of the heap, see @ref Json_Arena_Allocator.
+    /// This results in a deterministic upper bound for the memory used per received message and removes every heap allocation from the deserialization of received messages.
+    /// Only the deserialized payload counts against this size, the deserialization filters are owned by the API implementations and never allocated from this buffer, see @ref IAPI_Implementation::Get_Deserialization_Filter.
+    /// Received payloads that would require more memory, for example malicious payloads that contain a lot of small elements, are discarded before they could cause any heap allocation instead.
+    /// If the value is 0 the memory is allocated on the heap for every received message without any limit. If called while a received message is processed, the buffer is only reallocated once the next message is received
     /// @param max_response_size Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
     void Set_Max_Response_Size(size_t const & max_response_size) {
             m_max_response_size = max_response_size;
+            m_response_arena.Set_Capacity(max_response_size);
     }
 
     /// @brief Gets the Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
-    /// @note Size is calculated automatically from certain characters in the received payload (',', '{', '[') but if we receive a malicious payload that contains these symbols in a string {"example":",,,,,,..."}.
-    /// It is possible to cause huge allocations, but because the memory only lives for as long as a subscribed callback methods it should not be a problem,
-    /// especially because attempting to allocate too much memory, will cause the allocation to fail, which is checked. But if the failure of that heap allocation is subscribed for example with the heap_caps_register_failed_alloc_callback method on the ESP32,
-    /// then that subscribed callback will be called and could theoretically restart the device. To circumvent that we can simply set the size of this variable to a value that should never be exceeded by a non malicious json payload.
-    /// If this safety feature is not required, because the heap allocation failure callback is not subscribed, then the value of the variable can simply be kept as 0, which means we will not check the received payload for its size before the allocation happens
+    /// @note If the value is not 0, the memory of every received payload is handed out from a buffer of exactly this size instead of the heap and bigger payloads are discarded.
+    /// If the value is 0 the memory is allocated on the heap for every received message without any limit
     /// @return Maximum amount of bytes allocated for the interal JsonDocument structure that holds the received payload
     size_t const & Get_Max_Response_Size() {
             return m_max_response_size;
     }
 
+    /// @brief Returns the highest amount of bytes that has ever been used at once by the interal JsonDocument structure that holds the received payload
+    /// @note Allows to find the smallest maximum response size that is still big enough for every received payload, is only tracked if the maximum response size is not 0
+    /// @return Highest amount of bytes used at once to hold the received payload
+    size_t const & Get_Response_Peak_Size() const {
+            return m_response_arena.Get_Peak_Size();
+    }
+
+    /// @brief Sets the maximum amount of bytes allocated for the JsonDocument structures that are created to send messages,
+    /// for example the claiming request, the attribute or client-side RPC request, the server-side RPC response or the firmware state
+    /// @note If the value is not 0, a buffer of exactly this size is allocated once and shared by every API implementation, instead of each of them allocating the memory for the sent JsonDocument on the heap, see @ref Json_Arena_Allocator.
+    /// This results in constant memory usage, that does not fragment the heap. JsonDocument that would require more memory overflow instead, which causes sending them to fail.
+    /// If the value is 0 the memory is allocated on the heap for every sent message without any limit, which is the default. If called while a JsonDocument is still being built, the buffer is only reallocated once it has been sent
+    /// @param max_send_json_size Maximum amount of bytes allocated for the JsonDocument structures that are created to send messages
+    void Set_Max_Send_Json_Size(size_t const & max_send_json_size) {
+            m_send_arena.Set_Capacity(max_send_json_size);
+    }
+
+    /// @brief Gets the maximum amount of bytes allocated for the JsonDocument structures that are created to send messages
+    /// @return Maximum amount of bytes allocated for the JsonDocument structures that are created to send messages, 0 if they are allocated on the heap instead
+    size_t const & Get_Max_Send_Json_Size() const {
+            return m_send_arena.Get_Capacity();
+    }
+
+    /// @brief Returns the highest amount of bytes that has ever been used at once by the JsonDocument structures that are created to send messages
+    /// @note Allows to find the smallest maximum send json size that is still big enough for every sent message, is only tracked if the maximum send json size is not 0
+    /// @return Highest amount of bytes used at once to build sent messages
+    size_t const & Get_Send_Json_Peak_Size() const {
+            return m_send_arena.Get_Peak_Size();
+    }
+
+    /// @brief Sets the queue telemetry and attribute messages are persisted in while there is no connection to the MQTT broker, instead of failing to send them.
+    /// Requests and responses are never queued, because the server does not know their request id anymore once the connection has been established again.
+    /// Once the connection has been established again, the queued messages are sent in the @ref loop method, with atmost the given amount of messages every given interval.
+    /// Limiting the drain rate ensures the reconnected device does not flood the broker and still has time to send the current data in between.
+    /// Consecutive queued timestamped telemetry messages are merged into one json array, as long as they fit into the current send buffer size.
+    /// While the queue still contains messages, new telemetry and attribute messages are appended to it as well, so that they are sent in the order they were created
+    /// @param outbound_queue Non owning pointer to the queue that should be used, nullptr to disable queueing.
+    /// Has to be kept alive as long as it is used by this instance, because only the pointer is kept
+    /// @param messages_per_drain Maximum amount of queued messages that are sent in one call to the @ref loop method, default = 8
+    /// @param drain_interval_milliseconds Minimum amount of milliseconds between two calls to the @ref loop method that send queued messages, default = 100
+    void Set_Outbound_Queue(Outbound_Queue * outbound_queue, size_t const & messages_per_drain = 8U, uint64_t const & drain_interval_milliseconds = 100U) {
+            m_outbound_queue = outbound_queue;
+            m_drain_messages = messages_per_drain;
+            m_drain_interval = drain_interval_milliseconds;
+    }
+
+    /// @brief Sets the sampler whose buffered samples are drained and sent as telemetry data in the @ref loop method.
+    /// Allows to take samples from an interrupt service routine or a high priority sensor task, which only append the sample to the sampler, see @ref Telemetry_Sampler for more information.
+    /// Every call to the @ref loop method sends atmost the samples that were available when it was called, split into as many publishes as are required to stay below the current send buffer size.
+    /// If sending fails, the remaining samples are kept and sent with the next call instead, or are appended to the outbound queue if one has been set and there is no connection
+    /// @param sampler Non owning pointer to the sampler that should be drained, nullptr to disable draining.
+    /// Has to be kept alive as long as it is used by this instance, because only the pointer is kept
+    void Set_Telemetry_Sampler(ITelemetry_Sampler * sampler) {
+            m_telemetry_sampler = sampler;
+    }
+
+    /// @brief Returns the sampler whose buffered samples are drained and sent as telemetry data in the @ref loop method
+    /// @return Non owning pointer to the currently set sampler, nullptr if draining is disabled
+    ITelemetry_Sampler * Get_Telemetry_Sampler() const {
+            return m_telemetry_sampler;
+    }
+
+    /// @brief Sets whether the permanent subscriptions (RPC, Shared Attribute Update) of all API implementations are subscribed again, once the connection to the MQTT broker has been established.
+    /// Disabling it allows devices that only connect to publish and then disconnect again, like battery devices that wake up from deep sleep, to skip the subscribe handshake completely.
+    /// Be aware that while disabled, no RPC requests or shared attribute updates are received, because the connection is established with the MQTT cleanSession attribute set to true
+    /// @param resubscribe Whether the permanent subscriptions should be subscribed again on connect, default is enabled
+    void Set_Resubscribe_On_Connect(bool const & resubscribe) {
+            m_skip_resubscribe = !resubscribe;
+    }
+
+    /// @brief Returns whether the permanent subscriptions of all API implementations are subscribed again, once the connection to the MQTT broker has been established
+    /// @return Whether the permanent subscriptions are subscribed again on connect
+    bool Get_Resubscribe_On_Connect() const {
+            return !m_skip_resubscribe;
+    }
+
+    /// @brief Sets the payload format the device profile of the device on the server has been configured to use
+    /// @note If set to protobuf, received server-side RPC requests are decoded and passed to the subscribed RPC callbacks as json and their responses are encoded again before they are sent.
+    /// Client-side RPC and attribute requests are encoded and their responses, as well as shared attribute updates, are decoded into the same json the API implementations receive with a json device profile.
+    /// Telemetry and attribute data has to be sent with the protobuf specific send methods instead, because its schema is defined freely in the device profile. See @ref Payload_Codec for more information
+    /// @param payload_codec Payload format used by the device profile
+    void Set_Payload_Codec(Payload_Codec const & payload_codec) {
+            m_payload_codec = payload_codec;
+    }
+
+    /// @brief Returns the payload format the device profile of the device on the server has been configured to use
+    /// @return Payload format used by the device profile
+    Payload_Codec const & Get_Payload_Codec() const {
+            return m_payload_codec;
+    }
+
     /// @copydoc IMQTT_Client::set_buffer_size
     bool Set_Buffer_Size(uint16_t receive_buffer_size, uint16_t send_buffer_size) {
             bool const result = m_client.set_buffer_size(receive_buffer_size, send_buffer_size);
@@ -246,21 +348,26 @@ class ThingsBoard {
 
     /// @copydoc IMQTT_Client::loop
     bool loop() {
-#if !THINGSBOARD_USE_ESP_TIMER
             for (auto & api : m_api_implementations) {
                     if (api == nullptr) {
                             continue;
                     }
+#if !THINGSBOARD_USE_ESP_TIMER
                     api->loop();
-            }
 #endif // !THINGSBOARD_USE_ESP_TIMER
+                    api->Process_Deferred();
+            }
+            Drain_Outbound_Queue();
+            Drain_Telemetry_Sampler();
             return m_client.loop();
     }
 
     /// @brief Sends key-value pairs from the given JsonDocument over the given topic
     /// @note The passed JsonDocument data first has to be serialized into a json string payload to be then copied into the outgoing MQTT buffer.
     /// To circumvent this copy the alternative mentioned in the send_buffer_size argument of the constructor can also be used because it skips the internal copy alltogether,
-    /// because the JsonDocument is instead directly copied into the outgoing MQTT buffer
+    /// because the JsonDocument is instead directly copied into the outgoing MQTT buffer.
+    /// If the used client supports it (see @ref IMQTT_Client::acquire_publish_buffer), the JsonDocument is first serialized exactly once directly into the publish buffer owned by the client instead,
+    /// which removes the measure pass, the temporary stack or heap copy and the additional length calculation. Only if that buffer is too small, is the previous implementation used as a fallback
     /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
     /// @param source JsonDocument containing our json key-value pairs,
@@ -275,13 +382,38 @@ class ThingsBoard {
                     DefaultLogger::printfln(UNABLE_TO_ALLOCATE_JSON);
                     return false;
             }
+            else if (Is_Transcoded_Topic(topic, TRANSCODED_RPC_REQUEST_TOPIC)) {
+                    return Send_Protobuf_RPC_Request(topic, source);
+            }
+            else if (Is_Transcoded_Topic(topic, TRANSCODED_ATTRIBUTE_REQUEST_TOPIC)) {
+                    return Send_Protobuf_Attribute_Request(topic, source);
+            }
             bool result = false;
 
+            // Attempt to serialize directly into the buffer owned by the client first, which removes the need to measure the json beforehand,
+            // to copy it into a temporary buffer and to calculate the length of that temporary copy again before publishing.
+            // If the client does not support it or the payload does not fit, we fall back to the previous implementation instead
+            size_t available = 0U;
+            uint8_t * publish_buffer = (Is_Queueing(topic) || Is_Transcoded_Topic(topic, TRANSCODED_RPC_RESPONSE_TOPIC)) ? nullptr : m_client.acquire_publish_buffer(available);
+            if (publish_buffer != nullptr) {
+                    // The serialization writes atmost the available amount of bytes and adds the null termination if there is still space left,
+                    // therefore if every byte has been written the payload might have been truncated and has to be sent with the fallback instead
+                    size_t const bytes_serialized = serializeJson(source, reinterpret_cast<char *>(publish_buffer), available);
+                    if (bytes_serialized != 0U && bytes_serialized < available) {
+#if THINGSBOARD_ENABLE_DEBUG
+                            DefaultLogger::printfln(SEND_MESSAGE, topic, reinterpret_cast<char const *>(publish_buffer));
+#endif // THINGSBOARD_ENABLE_DEBUG
+                            return m_client.commit_publish_buffer(topic, bytes_serialized);
+                    }
+                    m_client.release_publish_buffer();
+            }
+
             size_t const json_size = Helper::Measure_Json(source);
 #if THINGSBOARD_ENABLE_STREAM_UTILS
             // Check if the size of the given message would be too big for the actual client,
-            // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
-            if (json_size > m_client.get_send_buffer_size())  {
+            // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented.
+            // Queued and transcoded messages have to be serialized completely instead, because they are persisted or wrapped into a protobuf message before being sent
+            if (json_size > m_client.get_send_buffer_size() && !Is_Queueing(topic) && !Is_Transcoded_Topic(topic, TRANSCODED_RPC_RESPONSE_TOPIC))  {
 #if THINGSBOARD_ENABLE_DEBUG
                     DefaultLogger::printfln(SEND_MESSAGE, topic, SEND_SERIALIZED);
 #endif // THINGSBOARD_ENABLE_DEBUG
@@ -326,29 +458,164 @@ class ThingsBoard {
             uint16_t current_send_buffer_size = m_client.get_send_buffer_size();
             auto const json_size = strlen(json);
 
+            // Queued before checking the send buffer size, because the queue is only limited by its segment size and the buffer might have been increased once the message is sent
+            if (Is_Queueing(topic)) {
+                    return m_outbound_queue->Enqueue(topic, reinterpret_cast<uint8_t const *>(json), json_size);
+            }
             if (current_send_buffer_size < json_size) {
                     DefaultLogger::printfln(INVALID_BUFFER_SIZE, current_send_buffer_size, json_size);
                     return false;
             }
 
+            if (Is_Transcoded_Topic(topic, TRANSCODED_RPC_RESPONSE_TOPIC)) {
+                    // Server-side RPC responses are expected to contain the json response as the payload string field of the response message
+                    return Send_Encoded_Protobuf(topic, [json, json_size](Protobuf_Encoder & encoder) {
+                            encoder.Write_Bytes(RPC_RESPONSE_PAYLOAD_FIELD, reinterpret_cast<uint8_t const *>(json), json_size);
+                            return true;
+                    });
+            }
+
 #if THINGSBOARD_ENABLE_DEBUG
             DefaultLogger::printfln(SEND_MESSAGE, topic, json);
 #endif // THINGSBOARD_ENABLE_DEBUG
             return m_client.publish(topic, reinterpret_cast<uint8_t const *>(json), json_size);
     }
 
+    /// @brief Sends the json written by the given function over the given topic
+    /// @note Allows to write json directly as text with the @ref Telemetry_Encoder, instead of first inserting all key-value pairs into a heap allocated JsonDocument.
+    /// If the used client supports it, the json is written directly into the publish buffer owned by the client, see @ref IMQTT_Client::acquire_publish_buffer.
+    /// Otherwise the required size is measured first and the json is written into a buffer on the stack, or the heap if the payload is bigger than the maximum stack size.
+    /// If the StreamUtils library is installed and the payload is bigger than the send buffer size, the json is instead streamed directly into the client, without ever being held in memory completely.
+    /// Because of that the given function may be called multiple times and is therefore expected to write the exact same json on every call
+    /// @tparam EncodeFunction Callable that receives a mutable reference to the @ref Telemetry_Encoder and returns whether writing the json was successful
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param encode Function that writes the json that should be sent
+    /// @return Whether copying the written json into the outgoing MQTT buffer, was successful or not
+    template<typename EncodeFunction>
+    bool Send_Encoded_Json(char const * topic, EncodeFunction encode) {
+            size_t available = 0U;
+            uint8_t * publish_buffer = (Is_Queueing(topic) || Is_Transcoded_Topic(topic, TRANSCODED_RPC_RESPONSE_TOPIC)) ? nullptr : m_client.acquire_publish_buffer(available);
+            if (publish_buffer != nullptr) {
+                    Telemetry_Encoder encoder(reinterpret_cast<char *>(publish_buffer), available);
+                    if (encode(encoder) && encoder.Finish()) {
+#if THINGSBOARD_ENABLE_DEBUG
+                            DefaultLogger::printfln(SEND_MESSAGE, topic, reinterpret_cast<char const *>(publish_buffer));
+#endif // THINGSBOARD_ENABLE_DEBUG
+                            return m_client.commit_publish_buffer(topic, encoder.Get_Length());
+                    }
+                    m_client.release_publish_buffer();
+            }
+
+            // Measure the required size without any buffer first, to decide wheter the payload can be written onto the stack or has to be written onto the heap instead
+            Telemetry_Encoder measure_encoder(nullptr, 0U);
+            if (!encode(measure_encoder) || !measure_encoder.Is_Complete()) {
+                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                    return false;
+            }
+            size_t const json_size = measure_encoder.Get_Length() + 1U;
+            bool result = false;
+
+#if THINGSBOARD_ENABLE_STREAM_UTILS
+            // Check if the size of the given message would be too big for the actual client,
+            // if it is stream the json directly into the client instead, so that even payloads bigger than any buffer we could allocate can be sent.
+            // Queued and transcoded messages have to be written completely instead, because they are persisted or wrapped into a protobuf message before being sent
+            if (json_size > m_client.get_send_buffer_size() && !Is_Queueing(topic) && !Is_Transcoded_Topic(topic, TRANSCODED_RPC_RESPONSE_TOPIC)) {
+#if THINGSBOARD_ENABLE_DEBUG
+                    DefaultLogger::printfln(SEND_MESSAGE, topic, SEND_SERIALIZED);
+#endif // THINGSBOARD_ENABLE_DEBUG
+                    return Stream_Encoded_Json(topic, encode, json_size - 1U);
+            }
+#endif // THINGSBOARD_ENABLE_STREAM_UTILS
+            if (json_size > Get_Maximum_Stack_Size()) {
+                    char* json = new char[json_size]();
+                    Telemetry_Encoder encoder(json, json_size);
+                    if (!encode(encoder) || !encoder.Finish()) {
+                            DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                    }
+                    else {
+                            result = Send_Json_String(topic, json);
+                    }
+                    delete[] json;
+                    json = nullptr;
+            }
+            else {
+                    char json[json_size] = {};
+                    Telemetry_Encoder encoder(json, json_size);
+                    if (!encode(encoder) || !encoder.Finish()) {
+                            DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                            return result;
+                    }
+                    result = Send_Json_String(topic, json);
+            }
+
+            return result;
+    }
+
+    /// @brief Sends the protobuf message written by the given function over the given topic
+    /// @note Allows to send telemetry and attribute data to devices whose device profile has been configured to use protobuf, with the message schema configured in that device profile.
+    /// If the used client supports it, the message is written directly into the publish buffer owned by the client, see @ref IMQTT_Client::acquire_publish_buffer.
+    /// Otherwise the required size is measured first and the message is written into a buffer on the stack, or the heap if the payload is bigger than the maximum stack size.
+    /// Because of that the given function may be called multiple times and is therefore expected to write the exact same fields on every call
+    /// @tparam EncodeFunction Callable that receives a mutable reference to the @ref Protobuf_Encoder and returns whether writing the message was successful
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param encode Function that writes the fields of the message that should be sent
+    /// @return Whether copying the written message into the outgoing MQTT buffer, was successful or not
+    template<typename EncodeFunction>
+    bool Send_Encoded_Protobuf(char const * topic, EncodeFunction encode) {
+            size_t available = 0U;
+            uint8_t * publish_buffer = Is_Queueing(topic) ? nullptr : m_client.acquire_publish_buffer(available);
+            if (publish_buffer != nullptr) {
+                    Protobuf_Encoder encoder(publish_buffer, available);
+                    if (encode(encoder) && encoder.Is_Complete()) {
+                            return m_client.commit_publish_buffer(topic, encoder.Get_Length());
+                    }
+                    m_client.release_publish_buffer();
+            }
+
+            Protobuf_Encoder measure_encoder(nullptr, 0U);
+            if (!encode(measure_encoder)) {
+                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                    return false;
+            }
+            size_t const message_size = measure_encoder.Get_Length();
+            uint16_t const current_send_buffer_size = m_client.get_send_buffer_size();
+            if (current_send_buffer_size < message_size && !Is_Queueing(topic)) {
+                    DefaultLogger::printfln(INVALID_BUFFER_SIZE, current_send_buffer_size, message_size);
+                    return false;
+            }
+            bool result = false;
+
+            if (message_size > Get_Maximum_Stack_Size()) {
+                    uint8_t* message = new uint8_t[message_size]();
+                    result = Publish_Encoded_Protobuf(topic, encode, message, message_size);
+                    delete[] message;
+                    message = nullptr;
+            }
+            else {
+                    // Ensure the stack buffer has atleast a size of 1, because an empty message is still valid protobuf
+                    uint8_t message[message_size + 1U] = {};
+                    result = Publish_Encoded_Protobuf(topic, encode, message, message_size);
+            }
+
+            return result;
+    }
+
     /// @brief Subscribes the given API implementation
     /// @note Ensure the actual API implementation is kept alive as long as the instance of this class. Because the value is not copied,
     /// but a non owning pointer to the value is inserted into the local container member variable instead
     /// @param api Additional API that should be connected to ThingsBoard and therefore be able to send and receive data over MQTT
     void Subscribe_API_Implementation(IAPI_Implementation & api) {
 #if THINGSBOARD_ENABLE_STL
-            api.Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this));
+            api.Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this), std::bind(&ThingsBoard::Get_Json_Allocator, this));
 #else
-            api.Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID);
+            api.Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID, ThingsBoard::Static_Get_Json_Allocator);
 #endif // THINGSBOARD_ENABLE_STL
+            api.Set_Fragmented_Delivery(m_fragmented_delivery);
             api.Initialize();
             m_api_implementations.push_back(&api);
+            m_topic_router.Rebuild(m_api_implementations.begin(), m_api_implementations.end());
     }
 
     /// @brief Subscribes the given API implementation
@@ -368,13 +635,15 @@ class ThingsBoard {
                             continue;
                     }
 #if THINGSBOARD_ENABLE_STL
-                    api->Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this));
+                    api->Set_Client_Callbacks(std::bind(&ThingsBoard::Subscribe_API_Implementation, this, std::placeholders::_1), std::bind(&ThingsBoard::Send_Json, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), std::bind(&ThingsBoard::Send_Json_String, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Subscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Unsubscribe_Topic, this, std::placeholders::_1), std::bind(&ThingsBoard::Get_Receive_Buffer_Size, this), std::bind(&ThingsBoard::Get_Send_Buffer_Size, this), std::bind(&ThingsBoard::Set_Buffer_Size, this, std::placeholders::_1, std::placeholders::_2), std::bind(&ThingsBoard::Get_Last_Request_ID, this), std::bind(&ThingsBoard::Get_Json_Allocator, this));
 #else
-                    api->Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID);
+                    api->Set_Client_Callbacks(ThingsBoard::Static_Subscribe_Implementation, ThingsBoard::Static_Send_Json, ThingsBoard::Static_Send_Json_String, ThingsBoard::Static_Subscribe_Topic, ThingsBoard::Static_Unsubscribe_Topic, ThingsBoard::Static_Get_Receive_Buffer_Size, ThingsBoard::Static_Get_Send_Buffer_Size, ThingsBoard::Static_Set_Buffer_Size, ThingsBoard::Static_Get_Last_Request_ID, ThingsBoard::Static_Get_Json_Allocator);
 #endif // THINGSBOARD_ENABLE_STL
+                    api->Set_Fragmented_Delivery(m_fragmented_delivery);
                     api->Initialize();
             }
             m_api_implementations.insert(m_api_implementations.end(), first, last);
+            m_topic_router.Rebuild(m_api_implementations.begin(), m_api_implementations.end());
     }
 
     //----------------------------------------------------------------------------
@@ -393,7 +662,7 @@ class ThingsBoard {
     /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the claiming request, default = nullptr
     /// @return Whether copying the created claiming request into the outgoing MQTT buffer, was successful or not
     bool Claim_Request(size_t const & duration_ms, char const * secret_key = nullptr) {
-            JsonDocument request_buffer;
+            JsonDocument request_buffer(&m_send_arena);
 
             if (!Helper::String_IsNull_Or_Empty(secret_key)) {
                     request_buffer[SECRET_KEY] = secret_key;
@@ -478,6 +747,34 @@ class ThingsBoard {
             return Send_Data_Array(first, last, false);
     }
 
+    /// @brief Send aggregated values as protobuf telemetry data, for devices whose device profile has been configured to use protobuf
+    /// @note Expects iterators to a container containing Protobuf_Field instances, where each value is written as the field with the given number of the telemetry message schema configured in the device profile.
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    template<typename InputIterator>
+    bool Send_Protobuf_Telemetry(InputIterator const & first, InputIterator const & last) {
+            return Send_Protobuf_Fields(first, last, true);
+    }
+
+    /// @brief Send aggregated values as protobuf attribute data, for devices whose device profile has been configured to use protobuf
+    /// @note Expects iterators to a container containing Protobuf_Field instances, where each value is written as the field with the given number of the attributes message schema configured in the device profile.
+    /// See https://thingsboard.io/docs/user-guide/device-profiles/#mqtt-device-payload for more information
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    template<typename InputIterator>
+    bool Send_Protobuf_Attributes(InputIterator const & first, InputIterator const & last) {
+            return Send_Protobuf_Fields(first, last, false);
+    }
+
     /// @brief Send string containing json as attribute data.
     /// See https://thingsboard.io/docs/user-guide/attribute/ for more information
     /// @param json Non owning pointer to the string containing our json key-value pairs
@@ -497,6 +794,481 @@ class ThingsBoard {
     }
 
   private:
+    /// @brief Whether the payload sent over or received from the given topic has to be transcoded between json and protobuf
+    /// @param topic Topic the payload is sent over or received from
+    /// @param prefix Prefix of the topics whose payload is transcoded, server-side RPC responses when sending and server-side RPC requests when receiving
+    /// @return Whether the payload has to be transcoded
+    bool Is_Transcoded_Topic(char const * topic, char const * prefix) const {
+            if (m_payload_codec != Payload_Codec::PROTOBUF || topic == nullptr) {
+                    return false;
+            }
+            return strncmp(topic, prefix, strlen(prefix)) == 0;
+    }
+
+    /// @brief Whether the payload received over the given topic has to be transcoded from protobuf into json
+    /// @param topic Received topic, is not guaranteed to be null terminated
+    /// @param topic_length Amount of characters in the received topic
+    /// @param prefix Prefix of the topics whose payload is transcoded, server-side RPC requests when receiving
+    /// @return Whether the payload has to be transcoded
+    bool Is_Transcoded_Topic(char const * topic, size_t const & topic_length, char const * prefix) const {
+            if (m_payload_codec != Payload_Codec::PROTOBUF || topic == nullptr) {
+                    return false;
+            }
+            return Helper::Topic_Starts_With(topic, topic_length, prefix, strlen(prefix));
+    }
+
+    /// @brief Writes the message with the given function into the given buffer and publishes it
+    /// @tparam EncodeFunction Callable that receives a mutable reference to the @ref Protobuf_Encoder and returns whether writing the message was successful
+    /// @param topic Topic that the message is sent over
+    /// @param encode Function that writes the fields of the message that should be sent
+    /// @param message Buffer the message is written into
+    /// @param message_size Size of the message and the given buffer
+    /// @return Whether publishing the message was successful or not
+    template<typename EncodeFunction>
+    bool Publish_Encoded_Protobuf(char const * topic, EncodeFunction & encode, uint8_t * message, size_t const & message_size) {
+            Protobuf_Encoder encoder(message, message_size);
+            if (!encode(encoder) || !encoder.Is_Complete()) {
+                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                    return false;
+            }
+            if (Is_Queueing(topic)) {
+                    return m_outbound_queue->Enqueue(topic, message, message_size);
+            }
+            return m_client.publish(topic, message, message_size);
+    }
+
+    /// @brief Send aggregated values as protobuf telemetry or attribute data
+    /// @tparam InputIterator Class that allows for forward incrementable access to data
+    /// of the given data container, allows for using / passing either std::vector or std::array.
+    /// See https://en.cppreference.com/w/cpp/iterator/input_iterator for more information on the requirements of the iterator
+    /// @param first Iterator pointing to the first element in the data container
+    /// @param last Iterator pointing to the end of the data container (last element + 1)
+    /// @param telemetry Whether the aggregated values should be sent as telemetry or attribute data
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    template<typename InputIterator>
+    bool Send_Protobuf_Fields(InputIterator const & first, InputIterator const & last, bool const & telemetry) {
+            return Send_Encoded_Protobuf(telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC, [&first, &last](Protobuf_Encoder & encoder) {
+                    for (auto it = first; it != last; ++it) {
+                            Protobuf_Field const & field = *it;
+                            if (!field.telemetry.SerializeValue(encoder, field.field_number)) {
+                                    return false;
+                            }
+                    }
+                    return true;
+            });
+    }
+
+    /// @brief Sends the given client-side RPC request as protobuf message, which contains the method name and the params serialized as a json string
+    /// @param topic Topic that the message is sent over
+    /// @param source JsonDocument containing the method name and the params of the request
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    bool Send_Protobuf_RPC_Request(char const * topic, JsonDocument const & source) {
+            char const * method = source[RPC_METHOD_KEY];
+            JsonVariantConst const params = source[RPC_PARAMS_KEY];
+            // Params that are already a string, like the default empty params, are sent as is instead of being serialized as a quoted json string
+            if (params.template is<char const *>()) {
+                    char const * json = params.template as<char const *>();
+                    return Send_Protobuf_RPC_Request(topic, method, json, strlen(json));
+            }
+
+            size_t const json_size = Helper::Measure_Json(params);
+            bool result = false;
+            if (json_size > Get_Maximum_Stack_Size()) {
+                    char* json = new char[json_size]();
+                    result = Send_Protobuf_RPC_Request(topic, method, json, serializeJson(params, json, json_size));
+                    delete[] json;
+                    json = nullptr;
+            }
+            else {
+                    char json[json_size] = {};
+                    result = Send_Protobuf_RPC_Request(topic, method, json, serializeJson(params, json, json_size));
+            }
+            return result;
+    }
+
+    /// @brief Sends the client-side RPC request with the given method name and the given params as protobuf message
+    /// @param topic Topic that the message is sent over
+    /// @param method Non owning pointer to the method name of the request
+    /// @param json Non owning pointer to the params of the request serialized as a json string
+    /// @param json_length Amount of characters in the serialized params
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    bool Send_Protobuf_RPC_Request(char const * topic, char const * method, char const * json, size_t const & json_length) {
+            return Send_Encoded_Protobuf(topic, [method, json, json_length](Protobuf_Encoder & encoder) {
+                    encoder.Write_String(CLIENT_RPC_REQUEST_METHOD_FIELD, method);
+                    encoder.Write_Bytes(CLIENT_RPC_REQUEST_PARAMS_FIELD, reinterpret_cast<uint8_t const *>(json), json_length);
+                    return true;
+            });
+    }
+
+    /// @brief Sends the given attribute request as protobuf message, which contains the comma seperated client and shared attribute keys
+    /// @param topic Topic that the message is sent over
+    /// @param source JsonDocument containing the requested client or shared attribute keys
+    /// @return Whether copying the message into the outgoing MQTT buffer, was successful or not
+    bool Send_Protobuf_Attribute_Request(char const * topic, JsonDocument const & source) {
+            char const * client_keys = source[TRANSCODED_CLIENT_KEYS_KEY];
+            char const * shared_keys = source[TRANSCODED_SHARED_KEYS_KEY];
+            return Send_Encoded_Protobuf(topic, [client_keys, shared_keys](Protobuf_Encoder & encoder) {
+                    if (client_keys != nullptr) {
+                            encoder.Write_String(ATTRIBUTE_REQUEST_CLIENT_KEYS_FIELD, client_keys);
+                    }
+                    if (shared_keys != nullptr) {
+                            encoder.Write_String(ATTRIBUTE_REQUEST_SHARED_KEYS_FIELD, shared_keys);
+                    }
+                    return true;
+            });
+    }
+
+    /// @brief Logs the given deserialization error, if the received payload required more memory than the maximum response size allows the required size is logged instead
+    /// @param error Result of the deserialization
+    /// @return Whether the deserialization failed or not
+    bool Log_Deserialization_Error(DeserializationError const & error) const {
+            if (!error) {
+                    return false;
+            }
+            else if (error == DeserializationError::NoMemory && m_response_arena.Get_Capacity() != 0U) {
+                    DefaultLogger::printfln(MAXIMUM_RESPONSE_EXCEEDED, m_response_arena.Get_Required_Size(), m_max_response_size);
+                    return true;
+            }
+            DefaultLogger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
+            return true;
+    }
+
+    /// @brief Deserializes the given received payload into the given JsonDocument, received protobuf messages are decoded and converted into the equivalent json first.
+    /// Server-side RPC requests, client-side RPC responses, attribute responses and shared attribute updates are transcoded, any other payload is still expected to be json
+    /// @param topic Topic the payload was received over, is not guaranteed to be null terminated
+    /// @param topic_length Amount of characters in the received topic
+    /// @param payload Received payload, is modified by the zero copy mode of the deserialization
+    /// @param length Length of the received payload
+    /// @param json_buffer JsonDocument the payload is deserialized into
+    /// @param filter Non owning pointer to the filter document containing every key that is read by the API implementations handling the payload,
+    /// only those keys are kept while deserializing. A nullptr means the complete payload is deserialized. Is not applied to received protobuf messages
+    /// @return Whether deserializing the payload was successful or not
+    bool Deserialize_Payload(char const * topic, size_t const & topic_length, uint8_t * payload, unsigned int length, JsonDocument & json_buffer, JsonDocument const * filter) {
+            bool result = true;
+            if (Is_Transcoded_Topic(topic, topic_length, TRANSCODED_RPC_REQUEST_TOPIC)) {
+                    result = Decode_RPC_Request(payload, length, json_buffer);
+            }
+            else if (Is_Transcoded_Topic(topic, topic_length, TRANSCODED_RPC_RESPONSE_TOPIC)) {
+                    result = Decode_RPC_Response(payload, length, json_buffer);
+            }
+            else if (Is_Transcoded_Topic(topic, topic_length, TRANSCODED_ATTRIBUTE_RESPONSE_TOPIC)) {
+                    result = Decode_Attribute_Response(payload, length, json_buffer);
+            }
+            else if (topic_length == strlen(ATTRIBUTE_TOPIC) && Is_Transcoded_Topic(topic, topic_length, ATTRIBUTE_TOPIC)) {
+                    result = Decode_Attribute_Update(payload, length, json_buffer);
+            }
+            else {
+                    // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
+                    // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
+                    // See https://arduinojson.org/v7/doc/deserialization/ for more info on ArduinoJson deserialization
+                    DeserializationError const error = (filter != nullptr) ? deserializeJson(json_buffer, payload, length, DeserializationOption::Filter(*filter)) : deserializeJson(json_buffer, payload, length);
+                    return !Log_Deserialization_Error(error);
+            }
+            if (!result) {
+                    DefaultLogger::printfln(UNABLE_TO_DECODE_PROTOBUF, static_cast<int>(topic_length), topic);
+            }
+            return result;
+    }
+
+    /// @brief Decodes the given received server-side RPC request message, into the equivalent json containing the method name and the params
+    /// @param payload Received message
+    /// @param length Length of the received message
+    /// @param json_buffer JsonDocument the method name and the params are written into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_RPC_Request(uint8_t const * payload, size_t const & length, JsonDocument & json_buffer) {
+            Protobuf_Decoder decoder(payload, length);
+            uint8_t const * method = nullptr;
+            size_t method_length = 0U;
+            uint8_t const * params = nullptr;
+            size_t params_length = 0U;
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    // The request id is ignored, because it is contained in the topic as well
+                    if (field_number == RPC_REQUEST_METHOD_FIELD && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(method, method_length);
+                    }
+                    else if (field_number == RPC_REQUEST_PARAMS_FIELD && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(params, params_length);
+                    }
+                    else {
+                            (void)decoder.Skip_Field(wire_type);
+                    }
+            }
+            if (decoder.Has_Error() || method == nullptr) {
+                    return false;
+            }
+
+            // The params are a json string contained in the message, they are deserialized directly into the received document, so that no second copy exists in the response arena
+            if (params_length != 0U) {
+                    DeserializationError const error = deserializeJson(json_buffer[RPC_PARAMS_KEY], params, params_length);
+                    if (Log_Deserialization_Error(error)) {
+                            return false;
+                    }
+            }
+            // The method name is not null terminated and its length is controlled by the sender, therefore it is copied into the document with its length instead of onto the stack
+            json_buffer[RPC_METHOD_KEY] = JsonString(reinterpret_cast<char const *>(method), method_length, JsonString::Copied);
+            return true;
+    }
+
+    /// @brief Decodes the given received client-side RPC response message, into the equivalent json response
+    /// @param payload Received message
+    /// @param length Length of the received message
+    /// @param json_buffer JsonDocument the json response or the error is written into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_RPC_Response(uint8_t const * payload, size_t const & length, JsonDocument & json_buffer) {
+            Protobuf_Decoder decoder(payload, length);
+            uint8_t const * response = nullptr;
+            size_t response_length = 0U;
+            uint8_t const * error = nullptr;
+            size_t error_length = 0U;
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    // The request id is ignored, because it is contained in the topic as well
+                    if (field_number == CLIENT_RPC_RESPONSE_PAYLOAD_FIELD && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(response, response_length);
+                    }
+                    else if (field_number == CLIENT_RPC_RESPONSE_ERROR_FIELD && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(error, error_length);
+                    }
+                    else {
+                            (void)decoder.Skip_Field(wire_type);
+                    }
+            }
+            if (decoder.Has_Error()) {
+                    return false;
+            }
+            if (error_length != 0U) {
+                    json_buffer[TRANSCODED_ERROR_KEY] = JsonString(reinterpret_cast<char const *>(error), error_length, JsonString::Copied);
+                    return true;
+            }
+            // The response is the json string the server-side rule chain replied with, the same as the complete payload with a json device profile
+            return response_length == 0U || !Log_Deserialization_Error(deserializeJson(json_buffer, response, response_length));
+    }
+
+    /// @brief Decodes the given received attribute response message, into the equivalent json containing the client and the shared attributes as seperate objects
+    /// @param payload Received message
+    /// @param length Length of the received message
+    /// @param json_buffer JsonDocument the attributes are written into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_Attribute_Response(uint8_t const * payload, size_t const & length, JsonDocument & json_buffer) {
+            Protobuf_Decoder decoder(payload, length);
+            uint8_t const * value = nullptr;
+            size_t value_length = 0U;
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    if (wire_type != Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Skip_Field(wire_type);
+                            continue;
+                    }
+                    else if (!decoder.Read_Length_Delimited(value, value_length)) {
+                            return false;
+                    }
+                    // The request id is ignored, because it is contained in the topic as well
+                    if (field_number == ATTRIBUTE_RESPONSE_CLIENT_FIELD || field_number == ATTRIBUTE_RESPONSE_SHARED_FIELD) {
+                            char const * scope = (field_number == ATTRIBUTE_RESPONSE_CLIENT_FIELD) ? CLIENT_SCOPE : SHARED_KEY;
+                            // Every attribute is a seperate occurence of the repeated field, therefore the object is only created for the first one
+                            JsonObject attributes = json_buffer[scope];
+                            if (attributes.isNull()) {
+                                    attributes = json_buffer[scope].template to<JsonObject>();
+                            }
+                            if (!Decode_Timestamped_Key_Value(value, value_length, attributes)) {
+                                    return false;
+                            }
+                    }
+                    else if (field_number == ATTRIBUTE_RESPONSE_ERROR_FIELD) {
+                            json_buffer[TRANSCODED_ERROR_KEY] = JsonString(reinterpret_cast<char const *>(value), value_length, JsonString::Copied);
+                    }
+            }
+            return !decoder.Has_Error();
+    }
+
+    /// @brief Decodes the given received shared attribute update message, into the equivalent json containing every updated attribute and the keys of the deleted ones
+    /// @param payload Received message
+    /// @param length Length of the received message
+    /// @param json_buffer JsonDocument the attributes are written into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_Attribute_Update(uint8_t const * payload, size_t const & length, JsonDocument & json_buffer) {
+            Protobuf_Decoder decoder(payload, length);
+            uint8_t const * value = nullptr;
+            size_t value_length = 0U;
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    if (wire_type != Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Skip_Field(wire_type);
+                            continue;
+                    }
+                    else if (!decoder.Read_Length_Delimited(value, value_length)) {
+                            return false;
+                    }
+                    if (field_number == ATTRIBUTE_UPDATE_SHARED_FIELD) {
+                            // Every attribute is a seperate occurence of the repeated field, therefore the object is only created for the first one
+                            JsonObject attributes = json_buffer.template as<JsonObject>();
+                            if (attributes.isNull()) {
+                                    attributes = json_buffer.template to<JsonObject>();
+                            }
+                            if (!Decode_Timestamped_Key_Value(value, value_length, attributes)) {
+                                    return false;
+                            }
+                    }
+                    else if (field_number == ATTRIBUTE_UPDATE_DELETED_FIELD) {
+                            json_buffer[TRANSCODED_DELETED_KEY].add(JsonString(reinterpret_cast<char const *>(value), value_length, JsonString::Copied));
+                    }
+            }
+            return !decoder.Has_Error();
+    }
+
+    /// @brief Decodes the given timestamped key-value message and inserts the contained value with its key into the given object, the timestamp is ignored
+    /// @param payload Encoded timestamped key-value message
+    /// @param length Length of the encoded message
+    /// @param destination Object the value is inserted into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_Timestamped_Key_Value(uint8_t const * payload, size_t const & length, JsonObject destination) {
+            Protobuf_Decoder decoder(payload, length);
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    if (field_number != TS_KV_VALUE_FIELD || wire_type != Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Skip_Field(wire_type);
+                            continue;
+                    }
+                    uint8_t const * key_value = nullptr;
+                    size_t key_value_length = 0U;
+                    if (!decoder.Read_Length_Delimited(key_value, key_value_length) || !Decode_Key_Value(key_value, key_value_length, destination)) {
+                            return false;
+                    }
+            }
+            return !decoder.Has_Error();
+    }
+
+    /// @brief Decodes the given key-value message and inserts the contained value with its key into the given object
+    /// @note Fields that contain the default value are not sent in protobuf, therefore every value starts as the default of its type (false, 0, 0.0 or an empty string)
+    /// @param payload Encoded key-value message
+    /// @param length Length of the encoded message
+    /// @param destination Object the value is inserted into
+    /// @return Whether decoding the message was successful or not
+    bool Decode_Key_Value(uint8_t const * payload, size_t const & length, JsonObject destination) {
+            Protobuf_Decoder decoder(payload, length);
+            uint8_t const * key = nullptr;
+            size_t key_length = 0U;
+            uint64_t type = KEY_VALUE_TYPE_BOOLEAN;
+            uint64_t integer = 0U;
+            double real = 0.0;
+            uint8_t const * text = nullptr;
+            size_t text_length = 0U;
+            uint32_t field_number = 0U;
+            Protobuf_Wire_Type wire_type = Protobuf_Wire_Type::VARINT;
+            while (decoder.Next_Field(field_number, wire_type)) {
+                    if (field_number == KEY_VALUE_KEY_FIELD && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(key, key_length);
+                    }
+                    else if (field_number == KEY_VALUE_TYPE_FIELD && wire_type == Protobuf_Wire_Type::VARINT) {
+                            (void)decoder.Read_Varint(type);
+                    }
+                    // Only the field matching the type is ever set, therefore the boolean and the integer can share the same variable
+                    else if ((field_number == KEY_VALUE_BOOL_FIELD || field_number == KEY_VALUE_LONG_FIELD) && wire_type == Protobuf_Wire_Type::VARINT) {
+                            (void)decoder.Read_Varint(integer);
+                    }
+                    else if (field_number == KEY_VALUE_DOUBLE_FIELD && wire_type == Protobuf_Wire_Type::FIXED64) {
+                            (void)decoder.Read_Double(real);
+                    }
+                    else if ((field_number == KEY_VALUE_STRING_FIELD || field_number == KEY_VALUE_JSON_FIELD) && wire_type == Protobuf_Wire_Type::LENGTH_DELIMITED) {
+                            (void)decoder.Read_Length_Delimited(text, text_length);
+                    }
+                    else {
+                            (void)decoder.Skip_Field(wire_type);
+                    }
+            }
+            if (decoder.Has_Error() || key == nullptr) {
+                    return false;
+            }
+
+            JsonVariant value = destination[JsonString(reinterpret_cast<char const *>(key), key_length, JsonString::Copied)].template to<JsonVariant>();
+            switch (type) {
+                    case KEY_VALUE_TYPE_BOOLEAN:
+                            value.set(integer != 0U);
+                            break;
+                    case KEY_VALUE_TYPE_LONG:
+                            value.set(static_cast<int64_t>(integer));
+                            break;
+                    case KEY_VALUE_TYPE_DOUBLE:
+                            value.set(real);
+                            break;
+                    case KEY_VALUE_TYPE_STRING:
+                            // An empty string is not sent at all, but a null pointer would result in a null value instead of an empty string
+                            value.set(JsonString((text != nullptr) ? reinterpret_cast<char const *>(text) : "", text_length, JsonString::Copied));
+                            break;
+                    case KEY_VALUE_TYPE_JSON:
+                            return text_length == 0U || !Log_Deserialization_Error(deserializeJson(value, text, text_length));
+                    default:
+                            return false;
+            }
+            return true;
+    }
+
+    /// @brief Whether messages over the given topic are currently persisted in the outbound queue instead of being sent, because there is no connection to the MQTT broker.
+    /// Telemetry and attribute messages are additionally appended as long as the queue still contains messages that have not been sent yet,
+    /// so that they are sent after the older queued data instead of overtaking it
+    /// @note Only telemetry and attribute messages are ever queued. Requests and responses contain a request id, that the server has already forgotten once the connection has been established again,
+    /// therefore they still fail to send while there is no connection, the same as without an outbound queue
+    /// @param topic Topic the message should be sent over
+    /// @return Whether messages should be appended to the outbound queue
+    bool Is_Queueing(char const * topic) {
+            if (m_outbound_queue == nullptr || topic == nullptr) {
+                    return false;
+            }
+            if (strcmp(topic, TELEMETRY_TOPIC) != 0 && strcmp(topic, ATTRIBUTE_TOPIC) != 0) {
+                    return false;
+            }
+            return !m_client.connected() || !m_outbound_queue->Empty();
+    }
+
+    /// @brief Sends the oldest queued messages if the connection has been established again and the drain interval has passed since the last time messages were sent
+    void Drain_Outbound_Queue() {
+            if (m_outbound_queue == nullptr || !m_client.connected()) {
+                    return;
+            }
+            uint64_t const current_time = Helper::Get_Uptime_Milliseconds();
+            if (current_time - m_last_drain < m_drain_interval || m_outbound_queue->Empty()) {
+                    return;
+            }
+            m_last_drain = current_time;
+
+            (void)m_outbound_queue->Drain(m_drain_messages, m_client.get_send_buffer_size(), TELEMETRY_TOPIC, [this](char const * topic, uint8_t const * payload, size_t const & length) {
+                    return m_client.publish(topic, payload, length);
+            });
+    }
+
+    /// @brief Sends the samples that are currently available in the telemetry sampler
+    void Drain_Telemetry_Sampler() {
+            if (m_telemetry_sampler == nullptr) {
+                    return;
+            }
+            // Only the samples available at the start are sent, so that a producer that samples faster than we can send does not keep the loop busy forever
+            size_t remaining = m_telemetry_sampler->Available();
+            while (remaining > 0U) {
+                    size_t const maximum_size = m_client.get_send_buffer_size();
+                    size_t consumed = 0U;
+                    bool const result = Send_Encoded_Json(TELEMETRY_TOPIC, [this, &consumed, &remaining, &maximum_size](Telemetry_Encoder & encoder) {
+                            consumed = m_telemetry_sampler->Encode_Samples(encoder, remaining, maximum_size);
+                            return consumed != 0U;
+                    });
+
+                    if (consumed == 0U) {
+                            DefaultLogger::printfln(SAMPLE_TOO_BIG, maximum_size);
+                            consumed = 1U;
+                    }
+                    else if (!result) {
+                            return;
+                    }
+                    m_telemetry_sampler->Pop(consumed);
+                    remaining -= consumed;
+            }
+    }
+
     using IAPI_Container = Container<IAPI_Implementation *>;
 
 #if THINGSBOARD_ENABLE_STREAM_UTILS
@@ -523,6 +1295,31 @@ class ThingsBoard {
             buffered_print.flush();
             return m_client.end_publish();
     }
+
+    /// @brief Streams the json written by the given function over the given topic directly into the underlying client
+    /// @note Never holds the complete json in memory, which allows to send payloads like telemetry arrays with thousands of elements that are bigger than the send buffer size.
+    /// Because the length of the message has to be sent before its content, the given function has to write exactly the previously measured json again
+    /// @tparam EncodeFunction Callable that receives a mutable reference to the @ref Telemetry_Encoder and returns whether writing the json was successful
+    /// @param topic Non owning pointer to topic that the message is sent over, where different MQTT topics expect a different kind of payload.
+    /// Does not need to kept alive as the function copies the data into the outgoing MQTT buffer to publish the given payload
+    /// @param encode Function that writes the json that should be sent
+    /// @param json_length Previously measured length of the json without null termination
+    /// @return Whether streaming the written json directly into the client, was successful or not
+    template<typename EncodeFunction>
+    bool Stream_Encoded_Json(char const * topic, EncodeFunction encode, size_t const & json_length) {
+            if (!m_client.begin_publish(topic, json_length)) {
+                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE_JSON);
+                    return false;
+            }
+            BufferingPrint buffered_print(m_client, Get_Buffering_Size());
+            Telemetry_Encoder encoder(buffered_print);
+            if (!encode(encoder) || encoder.Get_Length() != json_length) {
+                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE_JSON);
+                    return false;
+            }
+            buffered_print.flush();
+            return m_client.end_publish();
+    }
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
 
     /// @copydoc IMQTT_Client::subscribe
@@ -543,6 +1340,13 @@ class ThingsBoard {
             return &m_request_id;
     }
 
+    /// @brief Gets the allocator every JsonDocument that is sent should be created with
+    /// @note Is used so that all API implementations share the same preallocated send arena, instead of each of them allocating the memory for the sent JsonDocument on the heap
+    /// @return Non owning pointer to the send arena
+    ArduinoJson::Allocator * Get_Json_Allocator() {
+            return &m_send_arena;
+    }
+
     /// @brief Connects to the previously set server, with the given credentials
     /// @param access_token Non owning pointer to access token, that allows to differentiate which MQTT device is sending the traffic to the MQTT broker.
     /// Can be "provision", if the device creates itself instead. See https://thingsboard.io/docs/user-guide/device-provisioning/?mqttprovisioning=without#provision-device-apis for more information.
@@ -565,12 +1369,17 @@ class ThingsBoard {
     /// whereas other events that are only ever called once (single-event subscriptions) and then deleted after they have been handled are not resubscribed.
     /// Only the topics that establish a permanent connection are resubscribed, because all not yet received data is discarded on the MQTT broker,
     /// once a connection has been established again. This is the case because internally the device connects with the MQTT cleanSession attribute set to true.
-    /// Therefore we can also clear the buffer of all single-event subscriptions, because they would never receive an answer anyway
+    /// Therefore we can also clear the buffer of all single-event subscriptions, because they would never receive an answer anyway.
+    /// If resubscribing has been disabled with @ref Set_Resubscribe_On_Connect, the single-event subscriptions are still cleared, only the topics are not subscribed again
     void Resubscribe_Permanent_Subscriptions() {
             for (auto & api : m_api_implementations) {
                     if (api == nullptr) {
                             continue;
                     }
+                    if (m_skip_resubscribe) {
+                            api->Clear_Single_Event_Subscriptions();
+                            continue;
+                    }
                     // Results are ignored, because the important part of clearing internal data structures always succeeds
                     (void)api->Resubscribe_Permanent_Subscriptions();
             }
@@ -584,21 +1393,17 @@ class ThingsBoard {
     /// @return Whether copying the key-value pair into the outgoing MQTT buffer, was successful or not
     template<typename T>
     bool Send_Key_Value_Pair(char const * key, T const & value, bool telemetry = true) {
-            const Telemetry t(key, value);
+            Telemetry const t(key, value);
             if (t.IsEmpty()) {
                     return false;
             }
-
-            JsonDocument json_buffer;
-            if (!t.SerializeKeyValue(json_buffer)) {
-                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
-                    return false;
-            }
-            return telemetry ? Send_Telemetry_Json(json_buffer) : Send_Attribute_Json(json_buffer);
+            return Send_Data_Array(&t, &t + 1U, telemetry);
     }
 
     /// @brief Send aggregated key-value pair as telemetry or attribute data
     /// @note Expects iterators to a container containing Telemetry class instances.
+    /// The key-value pairs are written directly as json text with @ref Send_Encoded_Json, instead of first being inserted into a heap allocated JsonDocument.
+    /// Be aware that in contrast to a JsonDocument, the same key passed multiple times is also written multiple times.
     /// See https://thingsboard.io/docs/user-guide/telemetry/ for more information
     /// @tparam InputIterator Class that allows for forward incrementable access to data
     /// of the given data container, allows for using / passing either std::vector or std::array.
@@ -608,23 +1413,23 @@ class ThingsBoard {
     /// @return Whether copying the key-value pairs into the outgoing MQTT buffer, was successful or not
     template<typename InputIterator>
     bool Send_Data_Array(InputIterator const & first, InputIterator const & last, bool telemetry) {
-            JsonDocument json_buffer;
-
+            return Send_Encoded_Json(telemetry ? TELEMETRY_TOPIC : ATTRIBUTE_TOPIC, [&first, &last](Telemetry_Encoder & encoder) {
+                    encoder.Begin_Object();
 #if THINGSBOARD_ENABLE_STL
-            if (std::any_of(first, last, [&json_buffer](Telemetry const & data) { return !data.SerializeKeyValue(json_buffer); })) {
-                    DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
-                    return false;
-            }
-#else
-            for (auto it = first; it != last; ++it) {
-                    auto const & data = *it;
-                    if (!data.SerializeKeyValue(json_buffer)) {
-                            DefaultLogger::printfln(UNABLE_TO_SERIALIZE);
+                    if (std::any_of(first, last, [&encoder](Telemetry const & data) { return !data.SerializeKeyValue(encoder); })) {
                             return false;
                     }
-            }
+#else
+                    for (auto it = first; it != last; ++it) {
+                            auto const & data = *it;
+                            if (!data.SerializeKeyValue(encoder)) {
+                                    return false;
+                            }
+                    }
 #endif // THINGSBOARD_ENABLE_STL
-            return telemetry ? Send_Telemetry_Json(json_buffer) : Send_Attribute_Json(json_buffer);
+                    encoder.End_Object();
+                    return true;
+            });
     }
 
     /// @brief Internal callback for received MQTT responses
@@ -635,90 +1440,95 @@ class ThingsBoard {
     /// Therefore we simply assume that either the used MQTT client, has seperate input and output buffers or that the receiving of data is not executed on a seperate FreeRTOS tasks to other sends.
     /// The first option of seperate input and ouput buffers is the case for all directly in the library implemented MQTT client implementations being @ref Espressif_MQTT_Client and @ref Arduino_MQTT_Client
     /// @param topic Non owning pointer to topic that the message was received over, where different MQTT topics expect a different kind of payload.
-    /// Needs to be kept alive for the runtime of the method. Owned by the MQTT client implementation that called this callback method
+    /// Needs to be kept alive for the runtime of the method. Owned by the MQTT client implementation that called this callback method and not guaranteed to be null terminated
+    /// @param topic_length Amount of characters in the received topic, passed by the MQTT client implementation so that the topic never has to be copied or measured
     /// @param json Non owning pointer to the received payload.
     /// Needs to be kept alive for the runtime of the method. Owned by the MQTT client implementation that called this callback method
     /// @param length Total length of the received payload
-    void On_MQTT_Message(char * topic, uint8_t * payload, unsigned int length) {
+    void On_MQTT_Message(char const * topic, size_t topic_length, uint8_t * payload, unsigned int length) {
 #if THINGSBOARD_ENABLE_DEBUG
-            DefaultLogger::printfln(RECEIVE_MESSAGE, length, topic);
+            DefaultLogger::printfln(RECEIVE_MESSAGE, length, static_cast<int>(topic_length), topic);
 #endif // THINGSBOARD_ENABLE_DEBUG
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-            auto filtered_raw_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
-            IAPI_Container filtered_raw_api_implementations = {};
-            std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_raw_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-                    return (api != nullptr && api->Get_Process_Type() == API_Process_Type::RAW && api->Is_Response_Topic_Matching(topic));
-            });
-
-            for (auto & api : filtered_raw_api_implementations) {
-                    api->Process_Response(topic, payload, length);
-            }
-
-            // If the filtered api implementations was not emtpy it means the response was processed as its raw bytes representation atleast once,
-            // and because we interpreted it as raw bytes instead of json, we skip the further processing of those raw bytes as json.
+            // If the response is processed as its raw bytes representation atleast once, we skip the further processing of those raw bytes as json.
             // We do that because the received response is in that case not even valid json in the first place and would therefore simply fail deserialization
-            if (!filtered_raw_api_implementations.empty()) {
+            size_t const raw_matches = m_topic_router.For_Each_Match(API_Process_Type::RAW, topic, topic_length, [&](IAPI_Implementation & api) {
+                    api.Process_Response(topic, topic_length, payload, length);
+                    return true;
+            });
+            if (raw_matches != 0U) {
                     return;
             }
-#else
-            bool processed_response_as_raw = false;
-            for (auto & api : m_api_implementations) {
-                    if (api == nullptr || api->Get_Process_Type() != API_Process_Type::RAW || !api->Is_Response_Topic_Matching(topic)) {
-                            continue;
+
+            // Uses the filter of the keys the api implementation handling the response as json actually reads, so that all other keys are skipped while deserializing.
+            // Every api implementation keeps its own filter, which is only built again once the read keys change, instead of for every received message.
+            // Filtering is therefore only possible if a single api implementation handles the response, because merging multiple filters would require building a new one for every received message.
+            // The walk continues anyway, because any api implementation might still handle the unserialized payload itself
+            JsonDocument const * filter = nullptr;
+            bool handled = false;
+            size_t const json_matches = m_topic_router.For_Each_Match(API_Process_Type::JSON, topic, topic_length, [&](IAPI_Implementation & api) {
+                    handled = api.Process_Raw_Json_Response(topic, topic_length, payload, length);
+                    if (handled) {
+                            return false;
                     }
-                    api->Process_Response(topic, payload, length);
-                    processed_response_as_raw = true;
-            }
+                    filter = api.Get_Deserialization_Filter(topic, topic_length);
+                    return true;
+            });
 
-            if (processed_response_as_raw) {
+            // Deserialization is only done if atleast one api implementation actually handles the response as json and none of them has already handled the unserialized payload,
+            // this ensures that we never parse a payload nobody would ever consume
+            if (handled || json_matches == 0U) {
                     return;
             }
-#endif // THINGSBOARD_ENABLE_STL
-
-            JsonDocument json_buffer;
-
-            // The deserializeJson method we use, can use the zero copy mode because a writeable input was passed,
-            // if that were not the case the needed allocated memory would drastically increase, because the keys would need to be copied as well.
-            // See https://arduinojson.org/v7/doc/deserialization/ for more info on ArduinoJson deserialization
-            DeserializationError const error = deserializeJson(json_buffer, payload, length);
-            if (error) {
-                    DefaultLogger::printfln(UNABLE_TO_DE_SERIALIZE_JSON, error.c_str());
+            // The JsonDocument created for the received message uses the memory of the response arena, which is reset once it has been destroyed
+            JsonDocument json_buffer(&m_response_arena);
+            if (!Deserialize_Payload(topic, topic_length, payload, length, json_buffer, json_matches == 1U ? filter : nullptr)) {
                     return;
             }
 
-#if THINGSBOARD_ENABLE_STL
-#if THINGSBOARD_ENABLE_CXX20
-            auto filtered_json_api_implementations = m_api_implementations | std::views::filter([&topic](IAPI_Implementation const * api) {
-#else
-            IAPI_Container filtered_json_api_implementations = {};
-            std::copy_if(m_api_implementations.begin(), m_api_implementations.end(), std::back_inserter(filtered_json_api_implementations), [&topic](IAPI_Implementation const * api) {
-#endif // THINGSBOARD_ENABLE_CXX20
-                    return (api != nullptr && api->Get_Process_Type() == API_Process_Type::JSON && api->Is_Response_Topic_Matching(topic));
+            (void)m_topic_router.For_Each_Match(API_Process_Type::JSON, topic, topic_length, [&](IAPI_Implementation & api) {
+                    api.Process_Json_Response(topic, topic_length, json_buffer);
+                    return true;
             });
+    }
 
-            for (auto & api : filtered_json_api_implementations) {
-                    api->Process_Json_Response(topic, json_buffer);
-            }
-#else
-            for (auto & api : m_api_implementations) {
-                    if (api == nullptr || api->Get_Process_Type() != API_Process_Type::JSON || !api->Is_Response_Topic_Matching(topic)) {
-                            continue;
-                    }
-                    api->Process_Json_Response(topic, json_buffer);
+    /// @brief MQTT callback that will be called for every fragment of a received message, that is bigger than the receive buffer of the client and is therefore delivered in multiple fragments
+    /// @note Fragments are only passed to the api implementations that process the response as raw bytes, because json can not be deserialized from a partial payload.
+    /// Messages that are not handled by any api implementation are discarded, the same as if the client would not deliver messages in fragments at all
+    /// @param topic Previously subscribed topic, we got the response over, is not guaranteed to be null terminated
+    /// @param topic_length Amount of characters in the received topic
+    /// @param payload Fragment of the payload that was sent over the cloud and received over the given topic
+    /// @param length Length of the received fragment
+    /// @param offset Position of the first byte of the fragment in the complete payload
+    /// @param total_length Total length of the complete payload
+    void On_MQTT_Fragment(char const * topic, size_t topic_length, uint8_t * payload, unsigned int length, unsigned int offset, unsigned int total_length) {
+#if THINGSBOARD_ENABLE_DEBUG
+            DefaultLogger::printfln(RECEIVE_FRAGMENT, length, offset, total_length, static_cast<int>(topic_length), topic);
+#endif // THINGSBOARD_ENABLE_DEBUG
+
+            bool handled = false;
+            (void)m_topic_router.For_Each_Match(API_Process_Type::RAW, topic, topic_length, [&](IAPI_Implementation & api) {
+                    handled = api.Process_Response_Fragment(topic, topic_length, payload, length, offset, total_length) || handled;
+                    return true;
+            });
+            if (!handled && offset == 0U) {
+                    DefaultLogger::printfln(FRAGMENTED_MESSAGE_DISCARDED, total_length, static_cast<int>(topic_length), topic);
             }
-#endif // THINGSBOARD_ENABLE_STL
     }
 
 #if !THINGSBOARD_ENABLE_STL
-    static void On_Static_MQTT_Message(char * topic, uint8_t * payload, unsigned int length) {
+    static void On_Static_MQTT_Message(char const * topic, size_t topic_length, uint8_t * payload, unsigned int length) {
             if (m_subscribedInstance == nullptr) {
                     return;
             }
-            m_subscribedInstance->On_MQTT_Message(topic, payload, length);
+            m_subscribedInstance->On_MQTT_Message(topic, topic_length, payload, length);
+    }
+
+    static void On_Static_MQTT_Fragment(char const * topic, size_t topic_length, uint8_t * payload, unsigned int length, unsigned int offset, unsigned int total_length) {
+            if (m_subscribedInstance == nullptr) {
+                    return;
+            }
+            m_subscribedInstance->On_MQTT_Fragment(topic, topic_length, payload, length, offset, total_length);
     }
 
     static void Static_MQTT_Connect() {
@@ -770,6 +1580,13 @@ class ThingsBoard {
             return m_subscribedInstance->Get_Last_Request_ID();
     }
 
+    static ArduinoJson::Allocator * Static_Get_Json_Allocator() {
+            if (m_subscribedInstance == nullptr) {
+                    return nullptr;
+            }
+            return m_subscribedInstance->Get_Json_Allocator();
+    }
+
     static uint16_t Static_Get_Receive_Buffer_Size() {
             if (m_subscribedInstance == nullptr) {
                     return 0U;
@@ -794,14 +1611,25 @@ class ThingsBoard {
     static ThingsBoard *m_subscribedInstance;
 #endif // !THINGSBOARD_ENABLE_STL
 
-    IMQTT_Client&  m_client;              // MQTT client instance.
-    size_t         m_max_stack;           // Maximum stack size we allocate at once.
-    size_t         m_request_id = {};          // Internal id used to differentiate which request should receive which response for certain API calls. Can send 4'294'967'296 requests before wrapping back to 0
+    IMQTT_Client&    m_client;              // MQTT client instance.
+    size_t           m_max_stack;           // Maximum stack size we allocate at once.
+    size_t           m_request_id = {};          // Internal id used to differentiate which request should receive which response for certain API calls. Can send 4'294'967'296 requests before wrapping back to 0
 #if THINGSBOARD_ENABLE_STREAM_UTILS
-    size_t         m_buffering_size;      // Buffering size used to serialize directly into client.
+    size_t           m_buffering_size;      // Buffering size used to serialize directly into client.
 #endif // THINGSBOARD_ENABLE_STREAM_UTILS
-    size_t         m_max_response_size;   // Maximum size allocated on the heap to hold the Json data structure for received cloud response payload, prevents possible malicious payload allocaitng a lot of memory
-    IAPI_Container m_api_implementations; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)
+    size_t           m_max_response_size;   // Maximum size allocated on the heap to hold the Json data structure for received cloud response payload, prevents possible malicious payload allocaitng a lot of memory
+    Json_Arena_Allocator m_response_arena;  // Preallocated buffer of the maximum response size, the Json data structure for received cloud response payloads is allocated from
+    Json_Arena_Allocator m_send_arena;      // Preallocated buffer of the maximum send json size, the Json data structure for sent messages of all API implementations is allocated from
+    IAPI_Container   m_api_implementations; // Can hold a pointer to all  possible API implementations (Server side RPC, Client side RPC, Shared attribute update, Client-side or shared attribute request, Provision)
+    API_Topic_Router m_topic_router;        // Sorted response topic prefix table of all API implementations, rebuilt whenever an API implementation is subscribed
+    Outbound_Queue   *m_outbound_queue = {}; // Queue messages are persisted in while there is no connection to the MQTT broker, nullptr if queueing is disabled
+    size_t           m_drain_messages = {}; // Maximum amount of queued messages sent in one call to loop
+    uint64_t         m_drain_interval = {}; // Minimum amount of milliseconds between two calls to loop that send queued messages
+    uint64_t         m_last_drain = {};     // Uptime in milliseconds the queued messages were last sent at
+    ITelemetry_Sampler *m_telemetry_sampler = {}; // Sampler whose samples are drained and sent in the loop method, nullptr if draining is disabled
+    Payload_Codec    m_payload_codec = {};  // Payload format used by the device profile of the device on the server
+    bool             m_skip_resubscribe = {}; // Whether the permanent subscriptions are not subscribed again once the connection has been established
+    bool             m_fragmented_delivery = {}; // Whether the client delivers messages bigger than the receive buffer in multiple fragments
 };
 
 #if !THINGSBOARD_ENABLE_STL